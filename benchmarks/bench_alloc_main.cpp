@@ -0,0 +1,11 @@
+#include "bench_runner.hpp"
+#include "core/AllocationCounter.hpp"
+
+// lsaa-bench-alloc : garde-fou des allocations par tick (bench_tick_allocations.cpp). Exécutable
+// séparé : le remplacement global de operator new compte toutes les allocations du programme,
+// il fausserait les temps de lsaa-bench. Code de retour non nul si un tick alloue.
+LSAA_COUNT_ALLOCATIONS();
+
+int main(int argc, char** argv) {
+    return lsaa::bench::runBenchmarks(argc, argv, "lsaa-bench-alloc.json");
+}
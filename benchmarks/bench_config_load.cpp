@@ -0,0 +1,75 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include "core/ConfigManager.hpp"
+
+// Temps de démarrage côté configuration (budget SPEC_MVP : < 2s au démarrage)
+namespace {
+
+    namespace fs = std::filesystem;
+
+    std::string rulesFile(int count) {
+        fs::path path = fs::temp_directory_path() / ("lsaa_bench_rules_" + std::to_string(count) + ".json");
+        if (!fs::exists(path)) {
+            std::vector<lsaa::RuleConfig> rules;
+            rules.reserve((size_t)count);
+            for (int i = 0; i < count; ++i) {
+                rules.push_back({"Rule_" + std::to_string(i), "metric_" + std::to_string(i % 64), ">",
+                                 (double)(i % 100), i % 7 != 0, i % 2 ? "LOG" : "NOTIFY",
+                                 "Generated rule number " + std::to_string(i)});
+            }
+            std::ofstream(path) << json(rules).dump(4);
+        }
+        return path.string();
+    }
+
+    size_t consumeRules() {
+        size_t enabled = 0;
+        lsaa::ConfigManager::instance().forEachRule([&](const lsaa::RuleView& r) { enabled += r.enabled; });
+        return enabled;
+    }
+
+    // Référence : l'ancien chargement DOM (json >> get<vector<RuleConfig>>)
+    void BM_ConfigLoad_Dom(benchmark::State& state) {
+        std::string path = rulesFile((int)state.range(0));
+        for (auto _ : state) {
+            std::ifstream file(path);
+            json j;
+            file >> j;
+            auto rules = j.get<std::vector<lsaa::RuleConfig>>();
+            benchmark::DoNotOptimize(rules.data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Démarrage à froid : pas de cache, analyse SAX + écriture du cache
+    void BM_ConfigLoad_ColdSax(benchmark::State& state) {
+        std::string path = rulesFile((int)state.range(0));
+        auto& config = lsaa::ConfigManager::instance();
+        for (auto _ : state) {
+            state.PauseTiming();
+            fs::remove(path + ".cache");
+            state.ResumeTiming();
+            config.load(path);
+            benchmark::DoNotOptimize(consumeRules());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Démarrage à chaud : cache binaire à jour, projeté en mémoire
+    void BM_ConfigLoad_WarmCache(benchmark::State& state) {
+        std::string path = rulesFile((int)state.range(0));
+        auto& config = lsaa::ConfigManager::instance();
+        config.load(path); // Génère le cache
+        for (auto _ : state) {
+            config.load(path);
+            benchmark::DoNotOptimize(consumeRules());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+}
+
+BENCHMARK(BM_ConfigLoad_Dom)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ConfigLoad_ColdSax)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ConfigLoad_WarmCache)->Arg(1000)->Arg(50000)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+#include "bench_support.hpp"
+#include "core/Engine.hpp"
+#include "engine/AnomalyCondition.hpp"
+
+// Chemin chaud du moteur (budget EXECUTION_PLAN : < 5 ms pour 100 règles)
+namespace {
+
+    using lsaa::bench::SyntheticMonitor;
+    using lsaa::bench::makeRuleSet;
+
+    // Tick complet : collect + publication dans le registre + évaluation.
+    // range(0) = nombre de règles, 4 moniteurs de 16 métriques.
+    void BM_Engine_Step(benchmark::State& state) {
+        lsaa::Engine engine;
+        std::vector<std::string> metrics;
+        for (int m = 0; m < 4; ++m) {
+            auto mon = std::make_unique<SyntheticMonitor>("mon" + std::to_string(m) + "_metric_", 16);
+            metrics.insert(metrics.end(), mon->names().begin(), mon->names().end());
+            engine.addMonitor(std::move(mon));
+        }
+        engine.publishRules(makeRuleSet(metrics, (int)state.range(0), &engine.getMetricRegistry()));
+        engine.step(); // Adopte le jeu de règles
+
+        for (auto _ : state) engine.step();
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Evaluation seule, métriques fixes. range(0) = nombre de règles.
+    void BM_RuleEngine_Evaluate(benchmark::State& state) {
+        lsaa::MetricRegistry registry;
+        SyntheticMonitor mon("metric_", 64);
+        registry.advertise(mon);
+        mon.collect();
+        registry.publish([&](lsaa::MetricsMap& store) { mon.publishMetrics(store); });
+
+        lsaa::RuleEngine engine;
+        engine.publish(makeRuleSet(mon.names(), (int)state.range(0), &registry));
+        engine.evaluate(registry.values());
+
+        for (auto _ : state) engine.evaluate(registry.values());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    // Même chose avec des conditions résolues par nom à chaque évaluation (ancien chemin)
+    void BM_RuleEngine_Evaluate_ByName(benchmark::State& state) {
+        SyntheticMonitor mon("metric_", 64);
+        mon.collect();
+        lsaa::MetricsMap metrics = mon.getMetrics();
+
+        lsaa::RuleEngine engine;
+        engine.publish(makeRuleSet(mon.names(), (int)state.range(0)));
+        engine.evaluate(metrics);
+
+        for (auto _ : state) engine.evaluate(metrics);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void BM_ConditionGeneric_Evaluate_Handle(benchmark::State& state) {
+        lsaa::MetricRegistry registry;
+        SyntheticMonitor mon("metric_", 64);
+        registry.advertise(mon);
+        mon.collect();
+        registry.publish([&](lsaa::MetricsMap& store) { mon.publishMetrics(store); });
+
+        lsaa::MetricHandle handle;
+        registry.resolve("metric_42", handle);
+        lsaa::ConditionGeneric cond(handle, lsaa::ConditionGeneric::Operator::GREATER, 50.0);
+        for (auto _ : state) benchmark::DoNotOptimize(cond.evaluate(registry.values()));
+    }
+
+    void BM_ConditionGeneric_Evaluate_ByName(benchmark::State& state) {
+        SyntheticMonitor mon("metric_", 64);
+        mon.collect();
+        lsaa::MetricsMap metrics = mon.getMetrics();
+        lsaa::ConditionGeneric cond("metric_42", lsaa::ConditionGeneric::Operator::GREATER, 50.0);
+        for (auto _ : state) benchmark::DoNotOptimize(cond.evaluate(metrics));
+    }
+
+    // Mise à jour des statistiques + score, par échantillon. range(0) = ZSCORE, MAD, SEASONAL.
+    void BM_ConditionAnomaly_Evaluate(benchmark::State& state) {
+        lsaa::MetricsMap metrics = {{"metric_42", 0.0}};
+        lsaa::MetricValue& slot = metrics["metric_42"];
+        lsaa::ConditionAnomaly cond("metric_42", (lsaa::ConditionAnomaly::Kind)state.range(0),
+                                    lsaa::ConditionGeneric::Operator::GREATER, 3.0);
+        uint32_t seed = 12345;
+        for (auto _ : state) {
+            seed = seed * 1664525u + 1013904223u;
+            slot = 50.0 + (double)(seed >> 24) / 16.0;
+            benchmark::DoNotOptimize(cond.evaluate(metrics));
+        }
+    }
+
+}
+
+BENCHMARK(BM_Engine_Step)->Arg(10)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RuleEngine_Evaluate)->Arg(10)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_RuleEngine_Evaluate_ByName)->Arg(10)->Arg(100)->Arg(10000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ConditionGeneric_Evaluate_Handle);
+BENCHMARK(BM_ConditionGeneric_Evaluate_ByName);
+BENCHMARK(BM_ConditionAnomaly_Evaluate)->DenseRange(0, 2);
@@ -0,0 +1,62 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include "core/LogIndex.hpp"
+
+// Explorateur de journal : débit de recherche et de découpage en lignes (objectif : 1 Go < 1 s)
+namespace {
+
+    // 64 Mo de lignes au format de lsaa.log, aiguille placée à la fin
+    const std::string& logText() {
+        static const std::string text = []() {
+            std::string out;
+            out.reserve(64u << 20);
+            char line[160];
+            for (size_t i = 0; out.size() < (64u << 20); ++i) {
+                int n = snprintf(line, sizeof(line), "[2026-02-03 18:%02zu:%02zu] [INFO]  Rule Triggered: HighCPU on process %zu\n",
+                                 (i / 3000) % 60, (i / 50) % 60, i % 1000);
+                out.append(line, (size_t)n);
+            }
+            out += "[2026-02-03 19:00:00] [ERROR] needle-XYZZY\n";
+            return out;
+        }();
+        return text;
+    }
+
+    // Aiguille 0 : premier caractère rare ; 1 : premier caractère fréquent (cas défavorable à memchr)
+    constexpr std::string_view kNeedles[] = {"XYZZY", "process 1000"};
+
+    void BM_LogSearch_Simd(benchmark::State& state) {
+        const std::string& text = logText();
+        std::string_view needle = kNeedles[state.range(0)];
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(lsaa::findSubstring(text.data(), text.data() + text.size(), needle));
+        }
+        state.SetBytesProcessed(state.iterations() * (int64_t)text.size());
+    }
+
+    // Référence : std::string_view::find
+    void BM_LogSearch_StringFind(benchmark::State& state) {
+        std::string_view text = logText();
+        std::string_view needle = kNeedles[state.range(0)];
+        for (auto _ : state) benchmark::DoNotOptimize(text.find(needle));
+        state.SetBytesProcessed(state.iterations() * (int64_t)text.size());
+    }
+
+    // Coût de l'indexation : repérage des fins de ligne
+    void BM_LogIndex_Newlines(benchmark::State& state) {
+        const std::string& text = logText();
+        for (auto _ : state) {
+            size_t lines = 0;
+            lsaa::forEachNewline(text.data(), text.data() + text.size(), [&](const char*) { lines++; });
+            benchmark::DoNotOptimize(lines);
+        }
+        state.SetBytesProcessed(state.iterations() * (int64_t)text.size());
+    }
+
+}
+
+BENCHMARK(BM_LogSearch_Simd)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LogSearch_StringFind)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LogIndex_Newlines)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,15 @@
+#include <benchmark/benchmark.h>
+#include "core/Logger.hpp"
+
+namespace {
+
+    // Un seul mutex protège console, fichier et historique : coût sous contention
+    void BM_Logger_Log(benchmark::State& state) {
+        const std::string message = "Rule Triggered: HighCPU on thread " + std::to_string(state.thread_index());
+        for (auto _ : state) LSAA_LOG_INFO(message);
+        state.SetItemsProcessed(state.iterations());
+    }
+
+}
+
+BENCHMARK(BM_Logger_Log)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
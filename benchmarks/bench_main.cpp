@@ -0,0 +1,6 @@
+#include "bench_runner.hpp"
+
+// lsaa-bench : benchmarks de performance, sans compteur d'allocations (voir bench_alloc_main.cpp)
+int main(int argc, char** argv) {
+    return lsaa::bench::runBenchmarks(argc, argv, "lsaa-bench.json");
+}
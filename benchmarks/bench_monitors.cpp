@@ -0,0 +1,115 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include "monitors/ProcessMonitor.hpp"
+#include "gui/ProcessTable.hpp"
+#ifdef _WIN32
+#include "modules/Cleaner.hpp"
+#endif
+
+namespace {
+
+    // Construction de la table des processus par snapshot complet (mode polling)
+    void BM_ProcessMonitor_Collect(benchmark::State& state) {
+        lsaa::ProcessMonitor monitor(false);
+        // Taille de la table complète : getTopProcesses() s'arrête à 5 et getProcessTable()
+        // n'est remplie qu'en mode détaillé
+        size_t processes = 0;
+        monitor.setTableObserver([&processes](const lsaa::ProcessMonitor::Table& table, lsaa::ProcessMonitor::Clock::time_point) {
+            processes = table.size();
+        });
+        monitor.initialize();
+        for (auto _ : state) benchmark::DoNotOptimize(monitor.collect());
+        state.counters["processes"] = (double)processes;
+    }
+
+    // Mode détaillé (explorateur) : CPU, E/S et threads de chaque processus
+    void BM_ProcessMonitor_CollectDetailed(benchmark::State& state) {
+        lsaa::ProcessMonitor monitor(false);
+        monitor.initialize();
+        monitor.setDetailed(true);
+        for (auto _ : state) benchmark::DoNotOptimize(monitor.collect());
+        state.counters["processes"] = (double)monitor.getProcessTable()->size();
+    }
+
+    // Table synthétique de range(0) processus ; chaque tick, 2 % des lignes changent de CPU
+    std::shared_ptr<std::vector<lsaa::ProcessInfo>> syntheticProcesses(size_t count, uint32_t& seed) {
+        auto rows = std::make_shared<std::vector<lsaa::ProcessInfo>>();
+        for (size_t i = 0; i < count; ++i) {
+            seed = seed * 1664525u + 1013904223u;
+            lsaa::ProcessInfo p{(DWORD)(4 * i + 8), "Process" + std::to_string(i % 900) + ".exe", (SIZE_T)(seed >> 8)};
+            p.cpuPercent = (double)(seed >> 24) / 2.56;
+            rows->push_back(std::move(p));
+        }
+        return rows;
+    }
+
+    // Nouveau tick : reprise de l'ordre précédent et tri incrémental (colonne CPU)
+    void BM_ProcessTable_Update(benchmark::State& state) {
+        uint32_t seed = 12345;
+        auto rows = syntheticProcesses((size_t)state.range(0), seed);
+        lsaa::ProcessTable table;
+        table.update(rows);
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto next = std::make_shared<std::vector<lsaa::ProcessInfo>>(*rows);
+            for (size_t i = 0; i < next->size() / 50; ++i) {
+                seed = seed * 1664525u + 1013904223u;
+                (*next)[seed % next->size()].cpuPercent = (double)(seed >> 24) / 2.56;
+            }
+            rows = next;
+            state.ResumeTiming();
+            table.update(rows);
+        }
+    }
+
+    // Frappe dans le champ de recherche : filtre qui s'allonge d'un caractère à chaque fois
+    void BM_ProcessTable_Filter(benchmark::State& state) {
+        uint32_t seed = 12345;
+        lsaa::ProcessTable table;
+        table.update(syntheticProcesses((size_t)state.range(0), seed));
+        const std::string typed = "process12";
+        size_t k = 0;
+        for (auto _ : state) {
+            k = k % typed.size() + 1;
+            table.setFilter(std::string_view(typed).substr(0, k));
+            benchmark::DoNotOptimize(table.size());
+        }
+    }
+
+#ifdef _WIN32
+    namespace fs = std::filesystem;
+
+    // Arborescence synthétique de range(0) fichiers (100 par dossier), créée une seule fois
+    std::string cleanerTree(int files) {
+        fs::path root = fs::temp_directory_path() / ("lsaa_bench_clean_" + std::to_string(files));
+        if (!fs::exists(root)) {
+            for (int i = 0; i < files; ++i) {
+                fs::path dir = root / ("d" + std::to_string(i / 100));
+                fs::create_directories(dir);
+                std::ofstream(dir / ("f" + std::to_string(i) + ".tmp")) << std::string((size_t)(i % 4096), 'x');
+            }
+        }
+        return root.string();
+    }
+
+    void BM_Cleaner_Scan(benchmark::State& state) {
+        std::string root = cleanerTree((int)state.range(0));
+        for (auto _ : state) {
+            lsaa::Cleaner::ScanResult result = {0, 0};
+            lsaa::Cleaner::scanDir(root, result);
+            benchmark::DoNotOptimize(result.totalSize);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+#endif
+
+}
+
+BENCHMARK(BM_ProcessMonitor_Collect)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ProcessMonitor_CollectDetailed)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ProcessTable_Update)->Arg(500)->Arg(5000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ProcessTable_Filter)->Arg(500)->Arg(5000)->Unit(benchmark::kMicrosecond);
+#ifdef _WIN32
+BENCHMARK(BM_Cleaner_Scan)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+#endif
@@ -0,0 +1,72 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core/Logger.hpp"
+
+namespace lsaa::bench {
+
+    // Rapport console habituel (--benchmark_format respecté) qui retient si un benchmark a
+    // échoué (SkipWithError) : le programme renvoie alors un code non nul.
+    class FailureTrackingReporter : public benchmark::BenchmarkReporter {
+    public:
+        FailureTrackingReporter() : display_(benchmark::CreateDefaultDisplayReporter()) {}
+
+        bool ReportContext(const Context& context) override { return display_->ReportContext(context); }
+
+        void ReportRuns(const std::vector<Run>& runs) override {
+            for (const auto& run : runs) failed_ = failed_ || failedRun(run);
+            display_->ReportRuns(runs);
+        }
+
+        void Finalize() override { display_->Finalize(); }
+
+        bool failed() const { return failed_; }
+
+    private:
+        std::unique_ptr<benchmark::BenchmarkReporter> display_;
+        bool failed_ = false;
+
+        // Google Benchmark >= 1.8 : Run::skipped ; avant : Run::error_occurred
+        template<class R>
+        static bool failedRun(const R& run) {
+            if constexpr (requires { run.skipped; }) {
+                using Skipped = decltype(run.skipped);
+                return run.skipped == Skipped::SkippedWithError;
+            } else {
+                return run.error_occurred;
+            }
+        }
+    };
+
+    // main() commun aux exécutables de benchmarks. Résultats toujours écrits en JSON dans
+    // `defaultOut` (comparables entre commits avec tools/compare.py de Google Benchmark) ;
+    // --benchmark_out=... sur la ligne de commande reste prioritaire. Renvoie 1 si un benchmark a échoué.
+    inline int runBenchmarks(int argc, char** argv, const char* defaultOut) {
+        // Les logs iraient polluer la sortie JSON des résultats
+        lsaa::Logger::instance().setConsoleOutput(false);
+
+        std::vector<char*> args(argv, argv + argc);
+        bool hasOut = false;
+        for (int i = 1; i < argc; ++i) hasOut |= std::string_view(argv[i]).rfind("--benchmark_out=", 0) == 0;
+        std::string out = std::string("--benchmark_out=") + defaultOut;
+        std::string format = "--benchmark_out_format=json";
+        if (!hasOut) {
+            args.push_back(out.data());
+            args.push_back(format.data());
+        }
+        argc = (int)args.size();
+        args.push_back(nullptr);
+        argv = args.data();
+
+        benchmark::Initialize(&argc, argv);
+        if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+        FailureTrackingReporter reporter; // Après Initialize : format et couleurs de la ligne de commande
+        benchmark::RunSpecifiedBenchmarks(&reporter);
+        benchmark::Shutdown();
+        return reporter.failed() ? 1 : 0;
+    }
+
+}
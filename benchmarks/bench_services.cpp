@@ -0,0 +1,178 @@
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "modules/ServiceBatch.hpp"
+
+// Commandes de services en lot contre FakeServiceBackend (hôte de services en mémoire) :
+// parallélisme, ordre des lots et résultat de chaque service. Un résultat faux fait échouer
+// le benchmark (SkipWithError) ; les temps mesurent l'ordonnanceur, pas un vrai SCM.
+namespace {
+
+    using lsaa::FakeServiceBackend;
+    using lsaa::ServiceBatch;
+    using lsaa::ServiceCommand;
+    using lsaa::ServiceRequest;
+    using lsaa::ServiceResult;
+
+    constexpr std::chrono::milliseconds kTransition{10};
+
+    ServiceBatch::Options fastOptions() {
+        ServiceBatch::Options o;
+        o.parallelism = 8;
+        o.timeout = std::chrono::milliseconds(200);
+        o.pollMin = std::chrono::milliseconds(1);
+        o.pollMax = std::chrono::milliseconds(4);
+        return o;
+    }
+
+    std::string serviceName(int i) { return "svc" + std::to_string(i); }
+
+    // range(0) services arrêtés, démarrés en un lot : chacun atteint RUNNING, résultats dans
+    // l'ordre des requêtes, et le lot dure bien moins que la somme des transitions
+    void BM_ServiceBatch_Parallel(benchmark::State& state) {
+        const int count = (int)state.range(0);
+        double parallelism = 0.0;
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto backend = std::make_shared<FakeServiceBackend>();
+            FakeServiceBackend::Behaviour slow;
+            slow.transition = kTransition;
+            std::vector<ServiceRequest> requests;
+            for (int i = 0; i < count; ++i) {
+                backend->addService(serviceName(i), SERVICE_STOPPED, slow);
+                requests.push_back({serviceName(i), ServiceCommand::START});
+            }
+            ServiceBatch batch(backend, fastOptions());
+            state.ResumeTiming();
+
+            auto start = std::chrono::steady_clock::now();
+            auto results = batch.run(requests);
+            auto wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+            double sum = 0.0;
+            for (int i = 0; i < count; ++i) {
+                const ServiceResult& r = results[(size_t)i];
+                if (r.name != serviceName(i) || !r.success || r.finalState != SERVICE_RUNNING) {
+                    state.SkipWithError(("unexpected result for " + serviceName(i) + ": " + r.error).c_str());
+                    return;
+                }
+                sum += (double)r.latency.count();
+            }
+            parallelism += wall > 0.0 ? sum / wall : 0.0;
+        }
+        // Services suivis en même temps, en moyenne (borné par Options::parallelism)
+        state.counters["parallelism"] = parallelism / (double)state.iterations();
+        if (count >= 16 && state.counters["parallelism"] < 2.0) state.SkipWithError("services were not controlled in parallel");
+    }
+
+    // Un service par cas : chaque résultat porte son propre succès, état final et erreur
+    void BM_ServiceBatch_Outcomes(benchmark::State& state) {
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto backend = std::make_shared<FakeServiceBackend>();
+            FakeServiceBackend::Behaviour slow, failing, refused, hung;
+            slow.transition = kTransition;
+            failing.transition = kTransition;
+            failing.failStart = true;
+            refused.refuse = true;
+            hung.hang = true;
+            backend->addService("ok", SERVICE_STOPPED, slow);
+            backend->addService("already", SERVICE_RUNNING);
+            backend->addService("crashes", SERVICE_STOPPED, failing);
+            backend->addService("denied", SERVICE_STOPPED, refused);
+            backend->addService("stuck", SERVICE_STOPPED, hung);
+            backend->addService("stopme", SERVICE_RUNNING, slow);
+            backend->addService("disableme", SERVICE_RUNNING, slow);
+            ServiceBatch batch(backend, fastOptions());
+            const std::vector<ServiceRequest> requests = {
+                {"ok", ServiceCommand::START},       {"already", ServiceCommand::START},
+                {"crashes", ServiceCommand::START},  {"denied", ServiceCommand::START},
+                {"stuck", ServiceCommand::START},    {"stopme", ServiceCommand::STOP},
+                {"disableme", ServiceCommand::DISABLE}, {"missing", ServiceCommand::START}};
+            state.ResumeTiming();
+
+            auto results = batch.run(requests);
+
+            struct Expected {
+                bool success;
+                DWORD state;
+                const char* error; // Début du message attendu ("" : aucun)
+            };
+            const Expected expected[] = {
+                {true, SERVICE_RUNNING, ""},   {true, SERVICE_RUNNING, ""},
+                {false, SERVICE_STOPPED, "service stopped while starting"},
+                {false, SERVICE_STOPPED, "access denied"},
+                {false, SERVICE_START_PENDING, "timeout"},
+                {true, SERVICE_STOPPED, ""},   {true, SERVICE_STOPPED, ""},
+                {false, 0, "service not found"}};
+            for (size_t i = 0; i < requests.size(); ++i) {
+                const ServiceResult& r = results[i];
+                const Expected& e = expected[i];
+                if (r.name != requests[i].name || r.success != e.success || r.finalState != e.state ||
+                    r.error.rfind(e.error, 0) != 0) {
+                    state.SkipWithError(("unexpected result for " + requests[i].name + ": " + r.error).c_str());
+                    return;
+                }
+            }
+            if (!backend->isDisabled("disableme")) {
+                state.SkipWithError("DISABLE did not disable the service");
+                return;
+            }
+        }
+    }
+
+    // Lots soumis à la suite (GUI) : exécutés dans l'ordre de soumission, chacun après la fin du
+    // précédent. Un lot qui dépend du précédent (START après STOP) voit donc son effet.
+    void BM_ServiceBatch_SubmitOrder(benchmark::State& state) {
+        constexpr int kServices = 8;
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto backend = std::make_shared<FakeServiceBackend>();
+            FakeServiceBackend::Behaviour slow;
+            slow.transition = kTransition;
+            std::vector<ServiceRequest> stop, start;
+            for (int i = 0; i < kServices; ++i) {
+                backend->addService(serviceName(i), SERVICE_RUNNING, slow);
+                stop.push_back({serviceName(i), ServiceCommand::STOP});
+                start.push_back({serviceName(i), ServiceCommand::START});
+            }
+            std::mutex mutex;
+            std::condition_variable done;
+            std::vector<std::string> order;
+            bool ok = true;
+            auto check = [&](const char* label, DWORD target) {
+                return [&, label, target](std::vector<ServiceResult> results) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    order.push_back(label);
+                    for (const auto& r : results) ok = ok && r.success && r.finalState == target;
+                    done.notify_all();
+                };
+            };
+            ServiceBatch batch(backend, fastOptions()); // Détruit en premier : le dispatcher s'arrête avant les captures
+            state.ResumeTiming();
+
+            batch.submit(stop, check("stop", SERVICE_STOPPED));
+            batch.submit(start, check("start", SERVICE_RUNNING));
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [&]() { return order.size() == 2; });
+            }
+
+            bool finalRunning = true;
+            for (int i = 0; i < kServices; ++i) finalRunning = finalRunning && backend->queryState(serviceName(i)) == SERVICE_RUNNING;
+            if (!ok || order[0] != "stop" || order[1] != "start" || !finalRunning) {
+                state.SkipWithError("batches did not run in submission order");
+                return;
+            }
+        }
+    }
+
+}
+
+BENCHMARK(BM_ServiceBatch_Parallel)->Arg(8)->Arg(64)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ServiceBatch_Outcomes)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(BM_ServiceBatch_SubmitOrder)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,80 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include "core/IMonitor.hpp"
+#include "core/MetricRegistry.hpp"
+#include "engine/RuleEngine.hpp"
+
+namespace lsaa::bench {
+
+    // Moniteur synthétique : `count` métriques REAL dont les valeurs changent à chaque collect().
+    // Aucun appel système : isole le coût du moteur.
+    class SyntheticMonitor : public IMonitor {
+    public:
+        SyntheticMonitor(std::string prefix, int count) : prefix_(std::move(prefix)) {
+            for (int i = 0; i < count; ++i) names_.push_back(prefix_ + std::to_string(i));
+            values_.assign((size_t)count, 0.0);
+        }
+
+        std::string getName() const override { return "Synthetic:" + prefix_; }
+        bool initialize() override { return true; }
+
+        bool collect() override {
+            tick_++;
+            for (size_t i = 0; i < values_.size(); ++i) values_[i] = (double)((tick_ * 7 + i * 13) % 100);
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            std::vector<MetricDescriptor> out;
+            for (const auto& n : names_) out.push_back({n, MetricType::REAL, "percent"});
+            return out;
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            for (size_t i = 0; i < names_.size(); ++i) setMetric(store, names_[i], values_[i]);
+        }
+
+        const std::vector<std::string>& names() const { return names_; }
+
+    private:
+        std::string prefix_;
+        std::vector<std::string> names_;
+        std::vector<double> values_;
+        long long tick_ = 0;
+    };
+
+    class NullAction : public IAction {
+    public:
+        void execute() override {}
+        std::string getName() const override { return "NullAction"; }
+    };
+
+    // `count` règles réparties sur les métriques ; résolues via le registre (handles) si `registry` est fourni
+    inline std::shared_ptr<RuleSet> makeRuleSet(const std::vector<std::string>& metrics, int count,
+                                                MetricRegistry* registry = nullptr) {
+        auto set = std::make_shared<RuleSet>();
+        set->reserve((size_t)count);
+        for (int i = 0; i < count; ++i) {
+            const std::string& metric = metrics[(size_t)i % metrics.size()];
+            auto rule = std::make_unique<Rule>("Rule_" + std::to_string(i));
+            MetricHandle handle;
+            if (registry && registry->resolve(metric, handle)) {
+                rule->setCondition(std::make_unique<ConditionGeneric>(handle, ConditionGeneric::Operator::GREATER, (double)(i % 100)));
+            } else {
+                rule->setCondition(std::make_unique<ConditionGeneric>(metric, ConditionGeneric::Operator::GREATER, (double)(i % 100)));
+            }
+            rule->setAction(std::make_unique<NullAction>());
+            set->push_back(std::move(rule));
+        }
+        return set;
+    }
+
+}
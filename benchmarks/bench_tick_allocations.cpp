@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include "bench_support.hpp"
+#include "core/AllocationCounter.hpp"
+#include "core/Engine.hpp"
+#include "engine/AnomalyCondition.hpp"
+#include "monitors/DiskMonitor.hpp"
+#include "monitors/ProcessMonitor.hpp"
+#include "monitors/SelfMonitor.hpp"
+#ifdef __linux__
+#include "monitors/CgroupMonitor.hpp"
+#endif
+
+// Garde-fou : un tick du moteur en régime établi ne fait aucune allocation sur le tas
+// (compteur global de LSAA_COUNT_ALLOCATIONS, voir bench_alloc_main.cpp). Le benchmark échoue
+// (SkipWithError, lsaa-bench-alloc renvoie alors 1) dès qu'un tick alloue ; compteur
+// "allocs_per_tick" dans les résultats.
+namespace {
+
+    using lsaa::bench::SyntheticMonitor;
+
+    constexpr int kWarmupTicks = 5; // Arène agrandie, listes recyclées, magasin complet
+
+    // Moniteurs sans dépendance à l'activité de la machine + `rules` règles dont une sur dix est
+    // une condition d'anomalie. Seuils jamais atteints : les fronts (log, journal, liste des
+    // événements) allouent toujours, ils ne font pas partie du régime établi.
+    void addMonitorsAndRules(lsaa::Engine& engine, int rules) {
+        std::vector<std::string> metrics;
+        for (int m = 0; m < 4; ++m) {
+            auto mon = std::make_unique<SyntheticMonitor>("mon" + std::to_string(m) + "_metric_with_a_long_name_", 16);
+            metrics.insert(metrics.end(), mon->names().begin(), mon->names().end());
+            engine.addMonitor(std::move(mon));
+        }
+        engine.addMonitor(std::make_unique<lsaa::DiskMonitor>());
+        engine.addMonitor(std::make_unique<lsaa::SelfMonitor>());
+#ifdef __linux__
+        engine.addMonitor(std::make_unique<lsaa::CgroupMonitor>());
+#endif
+        auto set = std::make_shared<lsaa::RuleSet>();
+        for (int i = 0; i < rules; ++i) {
+            const std::string& metric = metrics[(size_t)i % metrics.size()];
+            auto rule = std::make_unique<lsaa::Rule>("Rule_" + std::to_string(i));
+            lsaa::MetricHandle handle;
+            if (i % 10 == 9) {
+                rule->setCondition(std::make_unique<lsaa::ConditionAnomaly>(metric, lsaa::ConditionAnomaly::Kind::ZSCORE,
+                                                                            lsaa::ConditionGeneric::Operator::GREATER, 1e9));
+            } else if (engine.getMetricRegistry().resolve(metric, handle)) {
+                rule->setCondition(std::make_unique<lsaa::ConditionGeneric>(handle, lsaa::ConditionGeneric::Operator::GREATER, 1e9));
+            }
+            rule->setAction(std::make_unique<lsaa::bench::NullAction>());
+            set->push_back(std::move(rule));
+        }
+        engine.publishRules(std::move(set));
+    }
+
+    void measure(benchmark::State& state, lsaa::Engine& engine) {
+        if (!lsaa::allocationCountingEnabled()) {
+            state.SkipWithError("LSAA_COUNT_ALLOCATIONS() missing from bench_alloc_main.cpp");
+            return;
+        }
+        for (int i = 0; i < kWarmupTicks; ++i) engine.step();
+
+        uint64_t allocations = 0;
+        uint64_t worst = 0;
+        for (auto _ : state) {
+            uint64_t before = lsaa::allocationCount();
+            engine.step();
+            uint64_t tick = lsaa::allocationCount() - before;
+            allocations += tick;
+            if (tick > worst) worst = tick;
+        }
+        state.counters["allocs_per_tick"] = benchmark::Counter((double)allocations / (double)state.iterations());
+        state.counters["allocs_worst_tick"] = (double)worst;
+        state.counters["arena_bytes"] = (double)engine.getTickArena().lastTickBytes();
+        if (allocations > 0) state.SkipWithError("Engine::step allocated on the heap in steady state");
+    }
+
+    // range(0) = nombre de règles
+    void BM_Engine_TickAllocations(benchmark::State& state) {
+        lsaa::Engine engine;
+        addMonitorsAndRules(engine, (int)state.range(0));
+        measure(state, engine);
+    }
+
+    // ProcessMonitor (polling) sur un ensemble stable de range(0) processus : table figée à la
+    // place de la vraie, dont les apparitions (noeud, nom, entrée de l'index) dépendent de la machine
+    void BM_Engine_TickAllocations_Processes(benchmark::State& state) {
+        std::vector<lsaa::ProcessInfo> processes((size_t)state.range(0));
+        for (size_t i = 0; i < processes.size(); ++i) {
+            processes[i].pid = (DWORD)(100000 + i);
+            processes[i].name = "process_with_a_long_name_" + std::to_string(i % 40) + ".exe";
+            processes[i].memoryBytes = (SIZE_T)((i * 7919) % 1000) << 20;
+            processes[i].parentPid = 1;
+        }
+        lsaa::Engine engine;
+        auto pm = std::make_unique<lsaa::ProcessMonitor>(false);
+        pm->setSnapshotSource([&processes](std::vector<lsaa::ProcessInfo>& out) {
+            out = processes; // Éléments réutilisés : pas d'allocation une fois la capacité atteinte
+            return true;
+        });
+        engine.addMonitor(std::move(pm));
+        addMonitorsAndRules(engine, 100);
+        measure(state, engine);
+    }
+
+}
+
+BENCHMARK(BM_Engine_TickAllocations)->Arg(10)->Arg(1000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Engine_TickAllocations_Processes)->Arg(60)->Arg(1000)->Unit(benchmark::kMicrosecond);
@@ -1,17 +1,114 @@
 #pragma once
-#include "../engine/Rule.hpp"
+#include "../engine/ActionLimiter.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <windows.h>
 
 namespace lsaa {
 
-    class ActionNotification : public IAction {
+    // Regroupe les notifications émises dans une même fenêtre : la première ouvre la
+    // fenêtre, à son expiration une seule bulle est affichée (le message seul, ou un
+    // résumé "N alertes"). Un seul processus PowerShell par fenêtre au lieu d'un par alerte.
+    class NotificationBatcher {
     public:
-        ActionNotification(std::string title, std::string message) 
-            : title_(std::move(title)), message_(std::move(message)) {}
+        static constexpr size_t kMaxSummaryLines = 5;
 
-        void execute() override {
+        static NotificationBatcher& instance() {
+            static NotificationBatcher batcher;
+            return batcher;
+        }
+
+        ~NotificationBatcher() {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            cv_.notify_all();
+            if (thread_.joinable()) thread_.join();
+        }
+
+        // 0 : affichage immédiat
+        void setWindow(std::chrono::milliseconds window) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            window_ = window;
+        }
+
+        void post(std::string title, std::string message) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (window_.count() <= 0) {
+                lock.unlock();
+                show(title, message);
+                return;
+            }
+            if (pending_.empty()) deadline_ = std::chrono::steady_clock::now() + window_;
+            pending_.push_back({std::move(title), std::move(message)});
+            if (!thread_.joinable()) thread_ = std::thread([this]() { loop(); });
+            cv_.notify_all();
+        }
+
+    private:
+        struct Pending {
+            std::string title;
+            std::string message;
+        };
+
+        std::mutex mutex_;
+        std::condition_variable cv_;
+        std::thread thread_;
+        std::vector<Pending> pending_;
+        std::chrono::steady_clock::time_point deadline_{};
+        std::chrono::milliseconds window_{10000};
+        bool stopping_ = false;
+
+        NotificationBatcher() = default;
+
+        void loop() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (true) {
+                if (pending_.empty()) {
+                    if (stopping_) return;
+                    cv_.wait(lock);
+                    continue;
+                }
+                if (!stopping_ && cv_.wait_until(lock, deadline_) != std::cv_status::timeout) continue;
+                std::vector<Pending> batch;
+                batch.swap(pending_);
+                lock.unlock();
+                flush(batch);
+                lock.lock();
+            }
+        }
+
+        static void flush(const std::vector<Pending>& batch) {
+            if (batch.size() == 1) {
+                show(batch[0].title, batch[0].message);
+                return;
+            }
+            std::string summary;
+            for (size_t i = 0; i < batch.size() && i < kMaxSummaryLines; ++i) {
+                if (i) summary += " | ";
+                summary += batch[i].message;
+            }
+            if (batch.size() > kMaxSummaryLines) summary += " (+" + std::to_string(batch.size() - kMaxSummaryLines) + ")";
+            ActionLimiter::instance().countMerged(batch.size() - 1);
+            show("LSAA: " + std::to_string(batch.size()) + " alerts", summary);
+        }
+
+        // Chaîne PowerShell entre apostrophes : ' doublée
+        static std::string quote(const std::string& text) {
+            std::string out = "'";
+            for (char c : text) {
+                if (c == '\'') out += "''";
+                else if (c != '"') out += c;
+            }
+            return out + "'";
+        }
+
+        static void show(const std::string& title, const std::string& message) {
             // PowerScript command to show a balloon tip
             // Note: We use ExtractAssociatedIcon to get the current exe icon
             std::string psCommand = "powershell -WindowStyle Hidden -Command \"& {";
@@ -20,7 +117,7 @@ namespace lsaa {
             psCommand += "$notify = New-Object System.Windows.Forms.NotifyIcon; ";
             psCommand += "$notify.Icon = [System.Drawing.Icon]::ExtractAssociatedIcon((Get-Process -Id $pid).Path); ";
             psCommand += "$notify.Visible = $True; ";
-            psCommand += "$notify.ShowBalloonTip(0, '" + title_ + "', '" + message_ + "', [System.Windows.Forms.ToolTipIcon]::Warning); ";
+            psCommand += "$notify.ShowBalloonTip(0, " + quote(title) + ", " + quote(message) + ", [System.Windows.Forms.ToolTipIcon]::Warning); ";
             // Need to sleep briefly to let the notification appear before disposal, but doing it in a detached process/thread is better 
             // simplifcation: we start it via CreateProcess so it runs async
             psCommand += "Start-Sleep -s 5; "; 
@@ -39,13 +136,23 @@ namespace lsaa {
             cmd.push_back(0);
 
             if (CreateProcessA(NULL, cmd.data(), NULL, NULL, FALSE, 0, NULL, NULL, &si, &pi)) {
-                LSAA_LOG_INFO("Notification Sent: " + title_);
+                LSAA_LOG_INFO("Notification Sent: " + title);
                 CloseHandle(pi.hProcess);
                 CloseHandle(pi.hThread);
             } else {
                 LSAA_LOG_ERROR("Failed to send notification.");
             }
         }
+    };
+
+    class ActionNotification : public IAction {
+    public:
+        ActionNotification(std::string title, std::string message) 
+            : title_(std::move(title)), message_(std::move(message)) {}
+
+        void execute() override {
+            NotificationBatcher::instance().post(title_, message_);
+        }
 
         std::string getName() const override { return "ActionNotification: " + title_; }
 
@@ -1,52 +1,41 @@
 #pragma once
 #include <windows.h>
-#include <tlhelp32.h>
 #include <string>
+#include <string_view>
+#include "ProcessTarget.hpp"
 #include "../engine/Rule.hpp"
 
 namespace lsaa {
 
     class ActionKillProcess : public IAction {
     public:
-        ActionKillProcess(std::string processName) : processName_(std::move(processName)), targetPid_(0) {}
-        ActionKillProcess(DWORD pid) : processName_("PID:" + std::to_string(pid)), targetPid_(pid) {}
+        // Cible : PID, nom, motif, "@top_mem" ou "@rule" (voir ProcessTarget)
+        ActionKillProcess(std::string_view target, std::shared_ptr<const ProcessIndex> index = nullptr, std::string_view ruleMetric = {})
+            : target_(target, std::move(index), ruleMetric) {}
+        ActionKillProcess(DWORD pid) : target_(pid) {}
 
-        void execute() override {
-            if (targetPid_ != 0) {
-                 terminatePid(targetPid_);
-                 return;
-            }
-
-            HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
-            if (hSnapshot == INVALID_HANDLE_VALUE) return;
+        bool valid() const { return target_.valid(); }
 
-            PROCESSENTRY32 pe32;
-            pe32.dwSize = sizeof(PROCESSENTRY32);
-
-            if (Process32First(hSnapshot, &pe32)) {
-                do {
-                    if (processName_ == pe32.szExeFile) {
-                        terminatePid(pe32.th32ProcessID);
-                    }
-                } while (Process32Next(hSnapshot, &pe32));
+        // Les processus protégés (voir safeProcessTarget) ne sont jamais tués, même depuis la GUI
+        void execute() override {
+            for (DWORD pid : target_.resolve()) {
+                if (safeProcessTarget(pid)) terminatePid(pid);
+                else LSAA_LOG_WARN("ActionKillProcess: refusing to terminate protected process (PID: " + std::to_string(pid) + ")");
             }
-
-            CloseHandle(hSnapshot);
         }
 
-        std::string getName() const override { return "ActionKillProcess: " + processName_; }
+        std::string getName() const override { return "ActionKillProcess: " + target_.describe(); }
 
     private:
-        std::string processName_;
-        DWORD targetPid_;
+        ProcessTarget target_;
 
         void terminatePid(DWORD pid) {
             HANDLE hProcess = OpenProcess(PROCESS_TERMINATE, FALSE, pid);
             if (hProcess) {
                 if (TerminateProcess(hProcess, 1)) {
-                     LSAA_LOG_WARN("ActionKillProcess: Terminated " + processName_ + " (PID: " + std::to_string(pid) + ")");
+                     LSAA_LOG_WARN("ActionKillProcess: Terminated " + target_.describe() + " (PID: " + std::to_string(pid) + ")");
                 } else {
-                     LSAA_LOG_ERROR("ActionKillProcess: Failed to terminate " + processName_ + " (PID: " + std::to_string(pid) + ")");
+                     LSAA_LOG_ERROR("ActionKillProcess: Failed to terminate " + target_.describe() + " (PID: " + std::to_string(pid) + ")");
                 }
                 CloseHandle(hProcess);
             }
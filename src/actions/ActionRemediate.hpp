@@ -0,0 +1,324 @@
+#pragma once
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ProcessTarget.hpp"
+#include "../engine/Rule.hpp"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sched.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <fstream>
+#include "../monitors/CgroupMonitor.hpp"
+#endif
+
+namespace lsaa {
+
+    // Remédiations sous pression mémoire/CPU, appliquées à chaque processus de la cible
+    // (voir ProcessTarget). Paramètre de la règle : "<cible> <valeur>", ou "<cible>" pour TRIM.
+    // Les processus protégés (safeProcessTarget) sont ignorés.
+    class ActionProcessRemediation : public IAction {
+    public:
+        void execute() override {
+            auto pids = target_.resolve();
+            size_t done = 0;
+            for (DWORD pid : pids) {
+                if (!safeProcessTarget(pid)) continue;
+                if (apply(pid)) done++;
+            }
+            if (pids.empty()) LSAA_LOG_WARN(getName() + ": no process matches");
+            else LSAA_LOG_WARN(getName() + ": applied to " + std::to_string(done) + "/" + std::to_string(pids.size()) + " process(es)");
+        }
+
+    protected:
+        explicit ActionProcessRemediation(ProcessTarget target) : target_(std::move(target)) {}
+        virtual bool apply(DWORD pid) = 0;
+
+        ProcessTarget target_;
+    };
+
+#ifndef _WIN32
+    // Les réglages par processus de Linux (nice, ioprio, affinité) portent sur un thread : on les applique à tous
+    template <typename Fn>
+    inline bool forEachThread(DWORD pid, Fn&& fn) {
+        std::string path = "/proc/" + std::to_string(pid) + "/task";
+        DIR* dir = opendir(path.c_str());
+        if (!dir) return false;
+        bool ok = true;
+        while (dirent* entry = readdir(dir)) {
+            if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+            ok = fn((pid_t)std::atoi(entry->d_name)) && ok;
+        }
+        closedir(dir);
+        return ok;
+    }
+#endif
+
+    // PRIORITY "<cible> idle|low|normal" : priorité CPU et E/S
+    class ActionSetPriority : public ActionProcessRemediation {
+    public:
+        enum class Level { IDLE, LOW, NORMAL };
+
+        static std::unique_ptr<IAction> create(std::string_view param, std::shared_ptr<const ProcessIndex> index, std::string_view ruleMetric = {}) {
+            std::string_view target, value;
+            if (!splitTargetParam(param, target, value)) return nullptr;
+            Level level;
+            if (value == "idle") level = Level::IDLE;
+            else if (value == "low") level = Level::LOW;
+            else if (value == "normal") level = Level::NORMAL;
+            else return nullptr;
+            ProcessTarget t(target, std::move(index), ruleMetric);
+            if (!t.valid()) return nullptr;
+            return std::unique_ptr<IAction>(new ActionSetPriority(std::move(t), level, std::string(value)));
+        }
+
+        std::string getName() const override { return "ActionSetPriority: " + target_.describe() + " " + levelName_; }
+
+    protected:
+        bool apply(DWORD pid) override {
+#ifdef _WIN32
+            HANDLE h = OpenProcess(PROCESS_SET_INFORMATION, FALSE, pid);
+            if (!h) return false;
+            DWORD cls = level_ == Level::IDLE ? IDLE_PRIORITY_CLASS : level_ == Level::LOW ? BELOW_NORMAL_PRIORITY_CLASS : NORMAL_PRIORITY_CLASS;
+            bool ok = SetPriorityClass(h, cls) != 0;
+            // Priorité E/S : NtSetInformationProcess(ProcessIoPriority), sans équivalent documenté
+            using NtSetInformationProcessFn = LONG(NTAPI*)(HANDLE, ULONG, PVOID, ULONG);
+            static auto setInformation = (NtSetInformationProcessFn)(void*)GetProcAddress(GetModuleHandleA("ntdll.dll"), "NtSetInformationProcess");
+            if (setInformation) {
+                ULONG ioPriority = level_ == Level::IDLE ? 0 : level_ == Level::LOW ? 1 : 2; // Very low, low, normal
+                setInformation(h, 33 /* ProcessIoPriority */, &ioPriority, sizeof(ioPriority));
+            }
+            CloseHandle(h);
+            return ok;
+#else
+            int nice = level_ == Level::IDLE ? 19 : level_ == Level::LOW ? 10 : 0;
+            // ioprio : classe idle (3), ou best-effort (2) niveau 7 / 4
+            int ioprio = level_ == Level::IDLE ? (3 << 13) : (2 << 13) | (level_ == Level::LOW ? 7 : 4);
+            return forEachThread(pid, [&](pid_t tid) {
+                bool ok = setpriority(PRIO_PROCESS, (id_t)tid, nice) == 0;
+#ifdef SYS_ioprio_set
+                syscall(SYS_ioprio_set, 1 /* IOPRIO_WHO_PROCESS */, tid, ioprio);
+#endif
+                return ok;
+            });
+#endif
+        }
+
+    private:
+        ActionSetPriority(ProcessTarget target, Level level, std::string levelName)
+            : ActionProcessRemediation(std::move(target)), level_(level), levelName_(std::move(levelName)) {}
+
+        Level level_;
+        std::string levelName_;
+    };
+
+    // AFFINITY "<cible> <masque>" : masque de CPU (0x3 = CPU 0 et 1)
+    class ActionSetAffinity : public ActionProcessRemediation {
+    public:
+        static std::unique_ptr<IAction> create(std::string_view param, std::shared_ptr<const ProcessIndex> index, std::string_view ruleMetric = {}) {
+            std::string_view target, value;
+            if (!splitTargetParam(param, target, value)) return nullptr;
+            std::string text(value);
+            char* end = nullptr;
+            unsigned long long mask = std::strtoull(text.c_str(), &end, 0);
+            if (*end != '\0' || mask == 0) return nullptr;
+            ProcessTarget t(target, std::move(index), ruleMetric);
+            if (!t.valid()) return nullptr;
+            return std::unique_ptr<IAction>(new ActionSetAffinity(std::move(t), mask));
+        }
+
+        std::string getName() const override { return "ActionSetAffinity: " + target_.describe(); }
+
+    protected:
+        bool apply(DWORD pid) override {
+#ifdef _WIN32
+            HANDLE h = OpenProcess(PROCESS_SET_INFORMATION | PROCESS_QUERY_INFORMATION, FALSE, pid);
+            if (!h) return false;
+            bool ok = SetProcessAffinityMask(h, (DWORD_PTR)mask_) != 0;
+            CloseHandle(h);
+            return ok;
+#else
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int cpu = 0; cpu < 64; ++cpu) if (mask_ & (1ull << cpu)) CPU_SET(cpu, &set);
+            return forEachThread(pid, [&](pid_t tid) { return sched_setaffinity(tid, sizeof(set), &set) == 0; });
+#endif
+        }
+
+    private:
+        ActionSetAffinity(ProcessTarget target, unsigned long long mask)
+            : ActionProcessRemediation(std::move(target)), mask_(mask) {}
+
+        unsigned long long mask_;
+    };
+
+    // MEMORY_LIMIT "<cible> <taille>" (512M, 2G...) : job object sous Windows, cgroup v2 sous Linux
+    class ActionLimitMemory : public ActionProcessRemediation {
+    public:
+        static std::unique_ptr<IAction> create(std::string_view param, std::shared_ptr<const ProcessIndex> index, std::string_view ruleMetric = {}) {
+            std::string_view target, value;
+            if (!splitTargetParam(param, target, value)) return nullptr;
+            unsigned long long bytes = parseSize(value);
+            if (bytes == 0) return nullptr;
+            ProcessTarget t(target, std::move(index), ruleMetric);
+            if (!t.valid()) return nullptr;
+            return std::unique_ptr<IAction>(new ActionLimitMemory(std::move(t), bytes));
+        }
+
+        ~ActionLimitMemory() override {
+#ifdef _WIN32
+            // Sans KILL_ON_JOB_CLOSE, le job et sa limite survivent tant qu'il contient des processus
+            if (job_) CloseHandle(job_);
+#endif
+        }
+
+        std::string getName() const override {
+            return "ActionLimitMemory: " + target_.describe() + " " + std::to_string(bytes_ / (1024 * 1024)) + " MB";
+        }
+
+        // "1048576", "512K", "512M", "2G"
+        static unsigned long long parseSize(std::string_view text) {
+            std::string s(text);
+            char* end = nullptr;
+            double n = std::strtod(s.c_str(), &end);
+            if (end == s.c_str() || n <= 0) return 0;
+            std::string unit(end);
+            double scale = unit.empty() ? 1.0 : unit == "K" || unit == "KB" ? 1024.0 : unit == "M" || unit == "MB" ? 1048576.0
+                         : unit == "G" || unit == "GB" ? 1073741824.0 : 0.0;
+            return (unsigned long long)(n * scale);
+        }
+
+    protected:
+        bool apply(DWORD pid) override {
+#ifdef _WIN32
+            if (!job_) {
+                job_ = CreateJobObjectA(nullptr, nullptr);
+                if (!job_) return false;
+                JOBOBJECT_EXTENDED_LIMIT_INFORMATION info{};
+                info.BasicLimitInformation.LimitFlags = JOB_OBJECT_LIMIT_PROCESS_MEMORY;
+                info.ProcessMemoryLimit = (SIZE_T)bytes_;
+                if (!SetInformationJobObject(job_, JobObjectExtendedLimitInformation, &info, sizeof(info))) {
+                    LSAA_LOG_ERROR("ActionLimitMemory: cannot configure job object");
+                    CloseHandle(job_);
+                    job_ = nullptr;
+                    return false;
+                }
+            }
+            HANDLE h = OpenProcess(PROCESS_SET_QUOTA | PROCESS_TERMINATE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!h) return false;
+            BOOL inJob = FALSE;
+            bool ok = (IsProcessInJob(h, job_, &inJob) && inJob) || AssignProcessToJobObject(h, job_);
+            CloseHandle(h);
+            return ok;
+#else
+            if (group_.empty() && !createCgroup()) return false;
+            return writeFile(group_ + "/cgroup.procs", std::to_string(pid));
+#endif
+        }
+
+    private:
+        ActionLimitMemory(ProcessTarget target, unsigned long long bytes)
+            : ActionProcessRemediation(std::move(target)), bytes_(bytes) {}
+
+        unsigned long long bytes_;
+#ifdef _WIN32
+        HANDLE job_ = nullptr;
+#else
+        std::string group_;
+
+        // <cgroup2>/lsaa.limits/<cible> avec memory.max ; le contrôleur memory doit être délégable
+        bool createCgroup() {
+            std::string mount = CgroupMonitor::findCgroup2Mount();
+            if (mount.empty()) {
+                LSAA_LOG_ERROR("ActionLimitMemory: no cgroup2 hierarchy mounted");
+                return false;
+            }
+            std::string parent = mount + "/lsaa.limits";
+            mkdir(parent.c_str(), 0755);
+            writeFile(mount + "/cgroup.subtree_control", "+memory");
+            writeFile(parent + "/cgroup.subtree_control", "+memory");
+
+            std::string name;
+            for (char c : target_.describe()) name += std::isalnum((unsigned char)c) || c == '.' || c == '-' ? c : '_';
+            std::string group = parent + "/" + name;
+            mkdir(group.c_str(), 0755);
+            if (!writeFile(group + "/memory.max", std::to_string(bytes_))) {
+                LSAA_LOG_ERROR("ActionLimitMemory: cannot set memory.max in " + group);
+                return false;
+            }
+            group_ = group;
+            return true;
+        }
+
+        static bool writeFile(const std::string& path, const std::string& text) {
+            std::ofstream out(path);
+            out << text;
+            out.flush();
+            return (bool)out;
+        }
+#endif
+    };
+
+    // TRIM "<cible>" : vide le working set (les pages reviennent à la demande)
+    class ActionTrimWorkingSet : public ActionProcessRemediation {
+    public:
+        static std::unique_ptr<IAction> create(std::string_view param, std::shared_ptr<const ProcessIndex> index, std::string_view ruleMetric = {}) {
+            ProcessTarget t(param, std::move(index), ruleMetric);
+            if (!t.valid()) return nullptr;
+            return std::unique_ptr<IAction>(new ActionTrimWorkingSet(std::move(t)));
+        }
+
+        std::string getName() const override { return "ActionTrimWorkingSet: " + target_.describe(); }
+
+    protected:
+        bool apply(DWORD pid) override {
+#ifdef _WIN32
+            HANDLE h = OpenProcess(PROCESS_SET_QUOTA | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!h) return false;
+            bool ok = SetProcessWorkingSetSizeEx(h, (SIZE_T)-1, (SIZE_T)-1, 0) != 0;
+            CloseHandle(h);
+            return ok;
+#elif defined(SYS_process_madvise) && defined(SYS_pidfd_open)
+            // process_madvise(MADV_PAGEOUT) sur les zones privées inscriptibles (Linux 5.10+)
+            int pidfd = (int)syscall(SYS_pidfd_open, (pid_t)pid, 0);
+            if (pidfd < 0) return false;
+            std::ifstream maps("/proc/" + std::to_string(pid) + "/maps");
+            std::vector<iovec> ranges;
+            std::string line;
+            while (std::getline(maps, line)) {
+                unsigned long long start = 0, end = 0;
+                char perms[5] = {};
+                if (std::sscanf(line.c_str(), "%llx-%llx %4s", &start, &end, perms) != 3) continue;
+                if (perms[1] != 'w' || perms[3] != 'p') continue;
+                ranges.push_back({(void*)(uintptr_t)start, (size_t)(end - start)});
+            }
+            bool ok = true;
+            for (size_t i = 0; i < ranges.size(); i += 512) {
+                size_t n = std::min<size_t>(512, ranges.size() - i);
+                if (syscall(SYS_process_madvise, pidfd, ranges.data() + i, n, 21 /* MADV_PAGEOUT */, 0) < 0) ok = false;
+            }
+            close(pidfd);
+            return ok;
+#else
+            (void)pid;
+            return false;
+#endif
+        }
+
+    private:
+        explicit ActionTrimWorkingSet(ProcessTarget target) : ActionProcessRemediation(std::move(target)) {}
+    };
+
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cctype>
+#include <cstdlib>
+#include "../monitors/ProcessMonitor.hpp"
+
+namespace lsaa {
+
+    // Cible d'une action sur les processus, depuis le paramètre de la règle :
+    //   "1234"       : ce PID
+    //   "chrome.exe" : tous les processus de ce nom
+    //   "chrome*"    : motif (* et ?)
+    //   "@top_mem"   : le processus qui occupe le plus de mémoire au moment de l'action
+    //   "@rule"      : le processus désigné par la métrique de la règle (`ruleMetric`) :
+    //                  process_started.<nom> -> <nom>, top_mem_* -> @top_mem. Une métrique
+    //                  globale (RAM, CPU...) ne désigne aucun processus : cible invalide.
+    // Les noms sont résolus via l'index de ProcessMonitor ; sans index, un snapshot complet.
+    class ProcessTarget {
+    public:
+        enum class Kind { PID, NAME, PATTERN, TOP_MEMORY };
+
+        ProcessTarget(std::string_view spec, std::shared_ptr<const ProcessIndex> index = nullptr, std::string_view ruleMetric = {})
+            : spec_(spec), index_(std::move(index)) {
+            if (spec_ == "@rule") spec_ = offendingProcess(ruleMetric);
+            if (spec_ == "@top_mem") kind_ = Kind::TOP_MEMORY;
+            else if (spec_.find_first_of("*?") != std::string::npos) kind_ = Kind::PATTERN;
+            else if (!spec_.empty() && spec_.find_first_not_of("0123456789") == std::string::npos) {
+                kind_ = Kind::PID;
+                pid_ = spec_.size() <= 10 ? (DWORD)std::strtoul(spec_.c_str(), nullptr, 10) : 0;
+            }
+        }
+
+        explicit ProcessTarget(DWORD pid) : spec_("PID:" + std::to_string(pid)), kind_(Kind::PID), pid_(pid) {}
+
+        bool valid() const { return !spec_.empty() && (kind_ != Kind::PID || pid_ != 0); }
+        const std::string& describe() const { return spec_; }
+
+        std::vector<DWORD> resolve() const {
+            switch (kind_) {
+                case Kind::PID: return {pid_};
+                case Kind::TOP_MEMORY: {
+                    DWORD pid = index_ ? index_->topMemoryPid() : 0;
+                    if (pid == 0) pid = scanTopMemory();
+                    return pid ? std::vector<DWORD>{pid} : std::vector<DWORD>{};
+                }
+                case Kind::NAME:
+                    if (index_ && index_->ready()) return index_->find(spec_);
+                    return scan();
+                case Kind::PATTERN:
+                    if (index_ && index_->ready()) return index_->match(spec_);
+                    return scan();
+            }
+            return {};
+        }
+
+    private:
+        std::string spec_;
+        std::shared_ptr<const ProcessIndex> index_;
+
+        static std::string offendingProcess(std::string_view metric) {
+            constexpr std::string_view kStarted = "process_started.";
+            if (metric.starts_with(kStarted) && metric.size() > kStarted.size()) return std::string(metric.substr(kStarted.size()));
+            if (metric.starts_with("top_mem_")) return "@top_mem";
+            return {};
+        }
+        Kind kind_ = Kind::NAME;
+        DWORD pid_ = 0;
+
+        std::vector<DWORD> scan() const {
+            std::vector<ProcessInfo> processes;
+            std::vector<DWORD> out;
+            if (!ProcessMonitor::snapshot(processes)) return out;
+            std::string key = ProcessIndex::key(spec_);
+            for (const auto& p : processes) {
+                std::string name = ProcessIndex::key(p.name);
+                if (kind_ == Kind::PATTERN ? ProcessIndex::glob(key, name) : key == name) out.push_back(p.pid);
+            }
+            return out;
+        }
+
+        static DWORD scanTopMemory() {
+            std::vector<ProcessInfo> processes;
+            if (!ProcessMonitor::snapshot(processes)) return 0;
+            DWORD best = 0;
+            SIZE_T bestBytes = 0;
+            for (const auto& p : processes) {
+                if (p.memoryBytes > bestBytes) { best = p.pid; bestBytes = p.memoryBytes; }
+            }
+            return best;
+        }
+    };
+
+    // Processus que les actions ne touchent jamais : l'agent lui-même, les PID système et les
+    // processus dont l'arrêt ou le bridage fait tomber la session ou la machine. Un processus
+    // dont le nom est illisible est aussi écarté.
+    inline bool safeProcessTarget(DWORD pid) {
+#ifdef _WIN32
+        static constexpr std::string_view kProtected[] = {
+            "system", "registry", "smss.exe", "csrss.exe", "wininit.exe", "winlogon.exe", "services.exe",
+            "lsass.exe", "lsaiso.exe", "svchost.exe", "dwm.exe", "fontdrvhost.exe", "memory compression"};
+        if (pid <= 4 || pid == GetCurrentProcessId()) return false;
+#else
+        static constexpr std::string_view kProtected[] = {
+            "init", "systemd", "systemd-journal", "systemd-logind", "systemd-udevd", "dbus-daemon", "dbus-broker"};
+        if (pid <= 2 || pid == (DWORD)getpid()) return false;
+#endif
+        ProcessInfo info;
+        if (!ProcessMonitor::readIdentity(pid, info)) return false;
+#ifndef _WIN32
+        if (info.parentPid == 2) return false; // Thread noyau (enfant de kthreadd)
+#endif
+        std::string name = ProcessIndex::key(info.name);
+        for (std::string_view p : kProtected) {
+            if (name == p) return false;
+        }
+        return true;
+    }
+
+    // "<cible> <valeur>" : la valeur est après le dernier espace (les noms peuvent en contenir)
+    inline bool splitTargetParam(std::string_view param, std::string_view& target, std::string_view& value) {
+        auto space = param.find_last_of(' ');
+        if (space == std::string_view::npos) return false;
+        target = param.substr(0, space);
+        value = param.substr(space + 1);
+        while (!target.empty() && target.back() == ' ') target.remove_suffix(1);
+        return !target.empty() && !value.empty();
+    }
+
+}
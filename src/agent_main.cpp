@@ -0,0 +1,140 @@
+// lsaa-agent : agent sans interface pour Linux (serveurs, conteneurs). Mêmes moniteurs que
+// lsaa-core hors GUI, dont les cgroups v2, et actions portables (LOG et remédiations).
+// Usage : lsaa-agent [--rules rules.json] [--record trace.bin] [--metrics-port N] [--metrics-textfile f.prom]
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include "core/Engine.hpp"
+#include "core/Logger.hpp"
+#include "core/ConfigManager.hpp"
+#include "core/FileWatcher.hpp"
+#include "core/AllocationCounter.hpp"
+#include "core/PrometheusExporter.hpp"
+#include "core/EventJournal.hpp"
+#include "engine/Rule.hpp"
+#include "engine/RuleFactory.hpp"
+#include "monitors/ProcessMonitor.hpp"
+#include "monitors/SelfMonitor.hpp"
+#include "monitors/DiskMonitor.hpp"
+#include "monitors/ServiceMonitor.hpp"
+#include "monitors/CgroupMonitor.hpp"
+#include "actions/ActionRemediate.hpp"
+
+// lsaa_allocations_per_tick
+LSAA_COUNT_ALLOCATIONS();
+
+namespace {
+
+    volatile std::sig_atomic_t stopRequested = 0;
+
+    void onSignal(int) { stopRequested = 1; }
+
+    int usage() {
+        std::cerr << "Usage: lsaa-agent [--rules rules.json] [--record trace.bin] [--metrics-port N]"
+                  << " [--metrics-textfile f.prom]" << std::endl;
+        return 2;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    std::string rulesPath = "rules.json";
+    std::string recordPath;
+    int metricsPort = 0;
+    std::string textfilePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--rules" && i + 1 < argc) rulesPath = argv[++i];
+        else if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--metrics-port" && i + 1 < argc) metricsPort = std::atoi(argv[++i]);
+        else if (arg == "--metrics-textfile" && i + 1 < argc) textfilePath = argv[++i];
+        else return usage();
+    }
+
+    lsaa::Logger::instance().init("lsaa.log");
+    if (!lsaa::EventJournal::instance().open("events")) LSAA_LOG_WARN("Event journal unavailable (events/)");
+    LSAA_LOG_INFO("LSAA headless agent starting");
+
+    lsaa::Engine engine;
+    auto pm = std::make_unique<lsaa::ProcessMonitor>();
+    auto* pmPtr = pm.get();
+    auto processIndex = pm->getIndex();
+    engine.addMonitor(std::move(pm));
+    engine.addMonitor(std::make_unique<lsaa::DiskMonitor>());
+
+    auto services = std::make_shared<lsaa::ServiceRefresher>(lsaa::ServiceManager::makeBackend());
+    engine.addMonitor(std::make_unique<lsaa::ServiceMonitor>(services));
+    services->start();
+
+    engine.addMonitor(std::make_unique<lsaa::SelfMonitor>());
+
+    // Cgroup Monitor (limites du conteneur), plus les cgroups de LSAA_CGROUPS
+    auto cgroups = std::make_unique<lsaa::CgroupMonitor>();
+    cgroups->addFromEnvironment();
+    engine.addMonitor(std::move(cgroups));
+
+    if (!recordPath.empty()) engine.startRecording(recordPath);
+
+    // Actions portables uniquement : NOTIFY, KILL et SCRIPT restent propres à lsaa-core (Windows)
+    lsaa::RuleFactory ruleFactory(engine.getMetricRegistry());
+    ruleFactory.registerAction("LOG", [](const lsaa::RuleView& cfg) {
+        return lsaa::ActionLog::fromParam(cfg.actionParam);
+    });
+    ruleFactory.registerAction("PRIORITY", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionSetPriority::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("AFFINITY", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionSetAffinity::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("MEMORY_LIMIT", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionLimitMemory::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("TRIM", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionTrimWorkingSet::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+
+    auto reloadRulesFn = [&engine, &ruleFactory]() {
+        auto ruleSet = std::make_shared<lsaa::RuleSet>();
+        std::vector<lsaa::RuleIssue> issues;
+        size_t attempted = 0;
+        lsaa::ConfigManager::instance().forEachRule([&](const lsaa::RuleView& cfg) {
+            attempted++;
+            if (auto rule = ruleFactory.build(cfg, issues)) ruleSet->push_back(std::move(rule));
+        });
+        for (const auto& issue : issues) {
+            LSAA_LOG_WARN("Rule '" + issue.rule + "' skipped: " + issue.message);
+        }
+        size_t active = ruleSet->size();
+        engine.publishRules(std::move(ruleSet));
+        LSAA_LOG_INFO("Rules Reloaded: " + std::to_string(active) + " active / " + std::to_string(attempted) + " defined.");
+    };
+
+    lsaa::ConfigManager::instance().load(rulesPath);
+    reloadRulesFn();
+    lsaa::FileWatcher configWatcher(lsaa::ConfigManager::instance().getFilename(), [reloadRulesFn]() {
+        if (lsaa::ConfigManager::instance().reload()) reloadRulesFn();
+    });
+    configWatcher.start();
+
+    lsaa::PrometheusExporter exporter(engine.getMetricRegistry());
+    if (metricsPort > 0) exporter.serve(metricsPort);
+    if (!textfilePath.empty()) exporter.startTextfile(textfilePath, std::chrono::seconds(15));
+
+    std::signal(SIGINT, onSignal);
+    std::signal(SIGTERM, onSignal);
+
+    engine.setTopProcessSource([pmPtr]() { return pmPtr->getTopProcessesShared(); });
+    std::thread engineThread([&engine]() { engine.run(); });
+    while (!stopRequested) std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    LSAA_LOG_INFO("LSAA headless agent stopping");
+    configWatcher.stop();
+    exporter.stop();
+    services->stop();
+    engine.stop();
+    engineThread.join();
+    lsaa::EventJournal::instance().close();
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+namespace lsaa {
+
+    namespace detail {
+        // Par thread : le moteur ne compte que ses propres allocations, pas celles de la GUI
+        // ou des threads de fond (et l'incrément n'a pas besoin d'être atomique)
+        inline constinit thread_local uint64_t allocationCount = 0;
+        inline std::atomic<bool> allocationCounting{false};
+
+        inline void* alignedAlloc(std::size_t size, std::size_t alignment) {
+#ifdef _WIN32
+            return _aligned_malloc(size ? size : 1, alignment);
+#else
+            // aligned_alloc exige une taille multiple de l'alignement
+            std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+            return std::aligned_alloc(alignment, rounded ? rounded : alignment);
+#endif
+        }
+
+        inline void alignedFree(void* p) {
+#ifdef _WIN32
+            _aligned_free(p);
+#else
+            std::free(p);
+#endif
+        }
+    }
+
+    // Nombre d'allocations faites par le thread appelant depuis son démarrage
+    // (0 si LSAA_COUNT_ALLOCATIONS() n'est pas utilisé)
+    inline uint64_t allocationCount() { return detail::allocationCount; }
+    inline bool allocationCountingEnabled() { return detail::allocationCounting.load(std::memory_order_relaxed); }
+
+}
+
+#ifdef _MSC_VER
+#define LSAA_NOINLINE __declspec(noinline)
+#else
+#define LSAA_NOINLINE __attribute__((noinline))
+#endif
+
+// Remplace operator new/delete (variantes alignées comprises) pour compter les allocations.
+// A placer une seule fois, au niveau global, dans le fichier qui contient main().
+// (new et delete non inlinés : sinon GCC croit voir un free() sur un pointeur issu de new)
+#define LSAA_COUNT_ALLOCATIONS()                                                                     \
+    LSAA_NOINLINE void* operator new(std::size_t size) {                                             \
+        ++lsaa::detail::allocationCount;                                                             \
+        if (void* p = std::malloc(size ? size : 1)) return p;                                        \
+        throw std::bad_alloc();                                                                      \
+    }                                                                                                \
+    void* operator new[](std::size_t size) { return ::operator new(size); }                          \
+    LSAA_NOINLINE void operator delete(void* p) noexcept { std::free(p); }                           \
+    void operator delete[](void* p) noexcept { ::operator delete(p); }                               \
+    void operator delete(void* p, std::size_t) noexcept { ::operator delete(p); }                    \
+    void operator delete[](void* p, std::size_t) noexcept { ::operator delete(p); }                  \
+    LSAA_NOINLINE void* operator new(std::size_t size, std::align_val_t al) {                        \
+        ++lsaa::detail::allocationCount;                                                             \
+        if (void* p = lsaa::detail::alignedAlloc(size, (std::size_t)al)) return p;                   \
+        throw std::bad_alloc();                                                                      \
+    }                                                                                                \
+    void* operator new[](std::size_t size, std::align_val_t al) { return ::operator new(size, al); } \
+    LSAA_NOINLINE void operator delete(void* p, std::align_val_t) noexcept {                         \
+        lsaa::detail::alignedFree(p);                                                                \
+    }                                                                                                \
+    void operator delete[](void* p, std::align_val_t al) noexcept { ::operator delete(p, al); }      \
+    void operator delete(void* p, std::size_t, std::align_val_t al) noexcept {                       \
+        ::operator delete(p, al);                                                                    \
+    }                                                                                                \
+    void operator delete[](void* p, std::size_t, std::align_val_t al) noexcept {                     \
+        ::operator delete(p, al);                                                                    \
+    }                                                                                                \
+    static const bool lsaaAllocationCountingEnabled_ =                                               \
+        (lsaa::detail::allocationCounting.store(true, std::memory_order_relaxed), true)
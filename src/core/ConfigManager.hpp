@@ -2,26 +2,15 @@
 #include <string>
 #include <vector>
 #include <fstream>
-#include <nlohmann/json.hpp>
+#include <mutex>
+#include <memory>
+#include <filesystem>
+#include "RuleConfig.hpp"
+#include "RuleCache.hpp"
 #include "../core/Logger.hpp"
 
-using json = nlohmann::json;
-
 namespace lsaa {
 
-    struct RuleConfig {
-        std::string name;
-        std::string metric;     // e.g., "cpu_usage_percent"
-        std::string oper;       // e.g., ">"
-        double threshold;
-        bool enabled;
-        std::string actionType; // "LOG", "NOTIFY", "KILL"
-        std::string actionParam; // message or target
-    };
-
-    // JSON Serialization for RuleConfig
-    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(RuleConfig, name, metric, oper, threshold, enabled, actionType, actionParam)
-
     class ConfigManager {
     public:
         static ConfigManager& instance() {
@@ -29,17 +18,13 @@ namespace lsaa {
             return instance;
         }
 
-        void load(const std::string& filename = "rules.json") {
-            filename_ = filename;
-            std::ifstream file(filename);
-            if (file.is_open()) {
-                try {
-                    json j;
-                    file >> j;
-                    rules_ = j.get<std::vector<RuleConfig>>();
-                    LSAA_LOG_INFO("Configuration loaded: " + std::to_string(rules_.size()) + " rules.");
-                } catch (const std::exception& e) {
-                    LSAA_LOG_ERROR("Failed to parse config: " + std::string(e.what()));
+        void load(const std::string& filename = kDefaultFilename) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            filename_ = filename.empty() ? kDefaultFilename : filename;
+            if (std::filesystem::exists(filename_)) {
+                std::string error;
+                if (!loadFile(error)) {
+                    LSAA_LOG_ERROR("Failed to parse config: " + error);
                     createDefaultConfig();
                 }
             } else {
@@ -48,29 +33,118 @@ namespace lsaa {
             }
         }
 
+        // Rechargement à chaud : contrairement à load(), un fichier invalide (ou en cours
+        // d'écriture) ne remplace jamais la config courante par les valeurs par défaut.
+        bool reload() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::string error;
+            if (!loadFile(error)) {
+                LSAA_LOG_ERROR("Config reload rejected, keeping current rules: " + error);
+                return false;
+            }
+            return true;
+        }
+
         void save() {
-            std::ofstream file(filename_);
-            if (file.is_open()) {
-                json j = rules_;
-                file << j.dump(4);
-                LSAA_LOG_INFO("Configuration saved.");
+            std::lock_guard<std::mutex> lock(mutex_);
+            materialize();
+            writeFile();
+        }
+
+        std::vector<RuleConfig> getRules() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            materialize();
+            return rules_;
+        }
+
+        // Parcourt les règles sans les copier : directement dans le cache projeté s'il
+        // est à jour, sinon dans la liste chargée. C'est le chemin utilisé par le moteur.
+        template <typename Fn>
+        void forEachRule(Fn&& fn) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (compiled_) {
+                for (size_t i = 0; i < compiled_->size(); ++i) fn(compiled_->at(i));
+            } else {
+                for (const auto& r : rules_) fn(RuleView::of(r));
             }
         }
 
-        std::vector<RuleConfig>& getRules() { return rules_; }
+        size_t ruleCount() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return compiled_ ? compiled_->size() : rules_.size();
+        }
+
+        // Copie sous verrou : load() peut changer le chemin depuis un autre thread
+        std::string getFilename() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return filename_;
+        }
+        std::string getCachePath() const { return filename_ + ".cache"; }
 
     private:
+        static constexpr const char* kDefaultFilename = "rules.json";
+
         ConfigManager() = default;
-        std::string filename_;
+        std::mutex mutex_;
+        std::string filename_ = kDefaultFilename; // Jamais vide
         std::vector<RuleConfig> rules_;
+        // Non nul : les règles courantes sont celles du cache (rules_ n'est pas rempli)
+        std::shared_ptr<CompiledRuleSet> compiled_;
+
+        bool loadFile(std::string& error) {
+            MappedFile source;
+            if (!source.open(filename_)) {
+                error = "cannot read " + filename_;
+                return false;
+            }
+            uint64_t hash = hashBytes(source.data(), source.size());
+
+            // Chemin chaud : cache binaire à jour, aucune analyse JSON
+            if (auto cached = CompiledRuleSet::open(getCachePath()); cached && cached->matches(hash, source.size())) {
+                compiled_ = std::move(cached);
+                rules_.clear();
+                LSAA_LOG_INFO("Configuration loaded from cache: " + std::to_string(compiled_->size()) + " rules.");
+                return true;
+            }
+
+            // Chemin froid : analyse SAX en flux, puis (re)génération du cache
+            std::vector<RuleConfig> rules;
+            if (!parseRulesSax(source.data(), source.data() + source.size(), rules, error)) return false;
+
+            compiled_.reset(); // Libère la projection avant de remplacer le fichier (Windows)
+            rules_ = std::move(rules);
+            if (!writeRuleCache(getCachePath(), hash, source.size(), rules_)) {
+                LSAA_LOG_WARN("Could not write rule cache " + getCachePath());
+            }
+            LSAA_LOG_INFO("Configuration loaded: " + std::to_string(rules_.size()) + " rules.");
+            return true;
+        }
+
+        void materialize() {
+            if (!compiled_) return;
+            rules_.clear();
+            rules_.reserve(compiled_->size());
+            for (size_t i = 0; i < compiled_->size(); ++i) rules_.push_back(compiled_->at(i).toConfig());
+            compiled_.reset();
+        }
+
+        void writeFile() {
+            std::ofstream file(filename_);
+            if (file.is_open()) {
+                json j = rules_;
+                file << j.dump(4);
+                LSAA_LOG_INFO("Configuration saved.");
+            }
+        }
 
         void createDefaultConfig() {
+            compiled_.reset();
             rules_ = {
                 {"HighCPU", "cpu_usage_percent", ">", 90.0, true, "NOTIFY", "Alerte CPU Critique !"},
                 {"HighRAM", "ram_load_percent", ">", 85.0, true, "LOG", "Utilisation RAM elevee"},
                 {"TooManyProcs", "process_count", ">", 250.0, true, "LOG", "Nombre de processus anormal"}
             };
-            save(); // Save defaults
+            writeFile(); // Save defaults
         }
     };
 }
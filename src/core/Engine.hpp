@@ -3,35 +3,95 @@
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <functional>
 #include <sstream>
 #include <iomanip>
 #include "IMonitor.hpp"
+#include "EngineSnapshot.hpp"
 #include "Logger.hpp"
+#include "MetricRegistry.hpp"
+#include "MetricTrace.hpp"
+#include "Profiler.hpp"
+#include "TickArena.hpp"
+#include "TickClock.hpp"
+#include "Tracer.hpp"
 #include "../engine/RuleEngine.hpp"
 
 namespace lsaa {
 
     class Engine {
     public:
-        Engine() : running_(false) {}
+        Engine()
+            : tickLatency_(Profiler::instance().histogram("tick")),
+              evaluateLatency_(Profiler::instance().histogram("evaluate")),
+              running_(false) {
+            auto empty = std::make_shared<EngineSnapshot>();
+            empty->topProcesses = noProcesses_;
+            empty->ruleEvents = ruleEngine_.recentEvents();
+            snapshot_.store(std::move(empty));
+        }
 
         void addMonitor(std::unique_ptr<IMonitor> monitor) {
+            if (!monitor->initialize()) {
+                LSAA_LOG_WARN("Monitor failed to initialize: " + monitor->getName());
+            }
+            registry_.advertise(*monitor);
+            collectLatency_.push_back(&Profiler::instance().histogram("collect." + monitor->getName()));
+            collectTraceNames_.push_back(LSAA_TRACE_INTERN(monitor->getName()));
             monitors_.push_back(std::move(monitor));
+            collected_.push_back(false);
         }
 
-        void addRule(std::unique_ptr<Rule> rule) {
-            ruleEngine_.addRule(std::move(rule));
+        // Thread-safe : le jeu de règles est échangé atomiquement au prochain tick
+        void publishRules(std::shared_ptr<RuleSet> rules) {
+            ruleEngine_.publish(std::move(rules));
         }
-        
-        void clearRules() {
-            ruleEngine_.clear();
+
+        // Enregistre les métriques de chaque tick dans une trace binaire (voir ReplayMonitor).
+        // A appeler avant run() : le fichier est ensuite écrit par le thread moteur.
+        bool startRecording(const std::string& path) {
+            auto writer = std::make_unique<MetricTraceWriter>();
+            if (!writer->open(path)) {
+                LSAA_LOG_ERROR("Cannot open trace file " + path);
+                return false;
+            }
+            recorder_ = std::move(writer);
+            LSAA_LOG_INFO("Recording metrics to " + path);
+            return true;
+        }
+
+        // Appelé sur le thread moteur à la fin de chaque tick (réveil de la GUI). A définir avant run().
+        void setTickListener(std::function<void()> listener) { tickListener_ = std::move(listener); }
+
+        // Source des processus les plus gourmands pour le snapshot (ProcessMonitor). A définir avant run().
+        using TopProcessSource = std::function<std::shared_ptr<const std::vector<ProcessInfo>>()>;
+        void setTopProcessSource(TopProcessSource source) { topProcessSource_ = std::move(source); }
+
+        // Instant d'un tick en secondes et son heure murale, lus après la collecte (TickClock).
+        // Par défaut steady_clock et system_clock ; lsaa-replay y branche l'horodatage de la
+        // trace. A définir avant run().
+        void setTickClock(std::function<double()> clock, std::function<TickClock::WallClock::time_point()> wallClock) {
+            tickClock_ = std::move(clock);
+            tickWallClock_ = std::move(wallClock);
+        }
+
+        // Incrémentée à chaque tick : un lecteur qui a déjà vu cette version n'a rien à relire
+        uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
+        // Dernier état publié (métriques, top processus, fronts des règles), sans verrou ni copie.
+        // Jamais nul : un snapshot vide de version 0 avant le premier tick.
+        std::shared_ptr<const EngineSnapshot> getSnapshot() const {
+            return snapshot_.load(std::memory_order_acquire);
         }
 
         RuleEngine& getRuleEngine() { return ruleEngine_; }
+        MetricRegistry& getMetricRegistry() { return registry_; }
+        const TickArena& getTickArena() const { return arena_; }
 
         void run() {
              // Legacy run blocking
              running_ = true;
+             LSAA_TRACE_THREAD_NAME("engine");
              while(running_) {
                  auto start = std::chrono::steady_clock::now();
                  step();
@@ -40,25 +100,42 @@ namespace lsaa {
         }
 
         void step() {
-             // 1. Collect
-             MetricsMap currentMetrics;
-             for (auto& mon : monitors_) {
-                 if (mon->collect()) {
-                      auto m = mon->getMetrics();
-                      currentMetrics.insert(m.begin(), m.end());
-                      // logMetrics(mon.get()); // Trop verbeux si 60fps
-                 }
+             ScopedTimer tickTimer(tickLatency_);
+             LSAA_TRACE_SCOPE("engine", "tick");
+             // Temporaires des moniteurs et des règles : libérés d'un coup à la fin du tick
+             TickArena::Scope arenaScope(arena_);
+
+             // 1. Collect (sans verrou : chaque moniteur met à jour son état interne)
+             for (size_t i = 0; i < monitors_.size(); ++i) {
+                 ScopedTimer collectTimer(*collectLatency_[i]);
+                 LSAA_TRACE_SCOPE("collect", collectTraceNames_[i]);
+                 collected_[i] = monitors_[i]->collect();
+                 // logMetrics(monitors_[i].get()); // Trop verbeux si 60fps
              }
-             std::lock_guard<std::mutex> lock(metricsMutex_);
-             lastMetrics_ = currentMetrics;
 
-             // 2. Rules
-             ruleEngine_.evaluate(currentMetrics);
+             // 2. Publish : mise à jour en place du magasin (les handles des règles restent valides)
+             registry_.publish([this](MetricsMap& store) {
+                 for (size_t i = 0; i < monitors_.size(); ++i) {
+                     if (collected_[i]) monitors_[i]->publishMetrics(store);
+                     else clearMetrics(*monitors_[i], store);
+                 }
+             });
+
+             if (recorder_) recorder_->writeTick(registry_.values());
+
+             // 3. Rules (datées par l'instant du tick, pas par l'horloge au moment de l'évaluation)
+             TickClock::Scope clockScope(tickClock_ ? tickClock_() : TickClock::steadySeconds(),
+                                         tickWallClock_ ? tickWallClock_() : TickClock::WallClock::now());
+             ScopedTimer evaluateTimer(evaluateLatency_);
+             LSAA_TRACE_SCOPE("engine", "evaluate");
+             ruleEngine_.evaluate(registry_.values());
+
+             publishSnapshot();
+             if (tickListener_) tickListener_();
         }
 
         MetricsMap getLastMetrics() {
-             std::lock_guard<std::mutex> lock(metricsMutex_);
-             return lastMetrics_;
+             return registry_.snapshot();
         }
         
         void stop() {
@@ -66,10 +143,74 @@ namespace lsaa {
         }
 
     private:
-        std::mutex metricsMutex_;
-        MetricsMap lastMetrics_;
+        MetricRegistry registry_;
+        TickArena arena_;
+        std::vector<bool> collected_;
+        std::unique_ptr<MetricTraceWriter> recorder_;
+        std::function<void()> tickListener_;
+        std::function<double()> tickClock_;
+        std::function<TickClock::WallClock::time_point()> tickWallClock_;
+        TopProcessSource topProcessSource_;
+        std::shared_ptr<const std::vector<ProcessInfo>> noProcesses_ = std::make_shared<const std::vector<ProcessInfo>>();
+        std::atomic<uint64_t> version_{0};
+        std::atomic<std::shared_ptr<const EngineSnapshot>> snapshot_;
+
+        std::shared_ptr<EngineSnapshot> spare_;
+
+        // Une seule copie des métriques par tick, quel que soit le nombre de lecteurs. Le snapshot
+        // remplacé au tick précédent est recyclé dès que plus aucun lecteur ne le tient : il n'est
+        // plus atteignable via snapshot_, donc use_count() == 1 est définitif. Les valeurs sont
+        // recopiées dans ses nœuds (pas d'allocation en régime établi, voir copyMetrics).
+        // use_count() est une lecture relaxed : la barrière acquire ordonne nos écritures après
+        // les dernières lectures du lecteur qui a relâché sa référence.
+        void publishSnapshot() {
+            std::shared_ptr<EngineSnapshot> next;
+            if (spare_ && spare_.use_count() == 1) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                next = std::move(spare_);
+            } else {
+                next = std::make_shared<EngineSnapshot>();
+            }
+
+            uint64_t version = version_.load(std::memory_order_relaxed) + 1;
+            next->version = version;
+            next->time = std::chrono::system_clock::now();
+            copyMetrics(registry_.values(), next->metrics); // Thread moteur : seul écrivain du magasin
+            next->topProcesses = topProcessSource_ ? topProcessSource_() : nullptr;
+            if (!next->topProcesses) next->topProcesses = noProcesses_;
+            next->ruleEvents = ruleEngine_.recentEvents();
+
+            auto previous = snapshot_.exchange(std::move(next), std::memory_order_acq_rel);
+            spare_ = std::const_pointer_cast<EngineSnapshot>(std::move(previous));
+            version_.store(version, std::memory_order_release);
+        }
+
+        // Auto-profilage (publié par SelfMonitor)
+        LatencyHistogram& tickLatency_;
+        LatencyHistogram& evaluateLatency_;
+        std::vector<LatencyHistogram*> collectLatency_;
+        std::vector<const char*> collectTraceNames_; // Noms internés pour le Tracer
+
+        // Mêmes clés (cas courant) : affectation valeur par valeur, les chaînes gardent leur capacité.
+        // L'affectation d'une map reconstruirait chaque clé et chaque valeur texte dans ses nœuds.
+        static void copyMetrics(const MetricsMap& from, MetricsMap& to) {
+            if (from.size() == to.size()) {
+                auto dst = to.begin();
+                auto src = from.begin();
+                for (; src != from.end() && src->first == dst->first; ++src, ++dst) dst->second = src->second;
+                if (src == from.end()) return;
+            }
+            to = from;
+        }
+
+        // Un moniteur en échec ne doit pas laisser de valeurs périmées aux règles
+        static void clearMetrics(const IMonitor& mon, MetricsMap& store) {
+            for (const auto& [key, value] : mon.getMetrics()) {
+                auto it = store.find(key);
+                if (it != store.end()) it->second = std::monostate{};
+            }
+        }
 
-    private:
         void logMetrics(IMonitor* mon) {
             auto metrics = mon->getMetrics();
             std::stringstream ss;
@@ -81,8 +222,10 @@ namespace lsaa {
                     ss << std::get<long long>(value);
                 else if (std::holds_alternative<double>(value))
                     ss << std::fixed << std::setprecision(1) << std::get<double>(value);
-                else
+                else if (std::holds_alternative<std::string>(value))
                     ss << std::get<std::string>(value);
+                else
+                    ss << "-";
                 ss << " ";
             }
             LSAA_LOG_INFO(ss.str());
@@ -0,0 +1,41 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "IMonitor.hpp"
+#include "Platform.hpp"
+
+namespace lsaa {
+
+    struct ProcessInfo {
+        DWORD pid;
+        std::string name;
+        SIZE_T memoryBytes;
+        DWORD parentPid = 0;
+        // Renseignés seulement en mode détaillé (ProcessMonitor::setDetailed)
+        double cpuPercent = 0.0;       // Part de la machine entière, comme le Gestionnaire des tâches
+        double ioBytesPerSecond = 0.0; // Lectures + écritures
+        unsigned threads = 0;
+    };
+
+    // Front montant (déclenchement) ou descendant (retour à la normale) d'une règle
+    struct RuleEvent {
+        std::chrono::system_clock::time_point time;
+        std::string rule;
+        bool triggered;
+    };
+
+    // État du moteur à la fin d'un tick, immuable une fois publié (Engine::getSnapshot).
+    // Les lecteurs le gardent le temps qu'ils veulent sans verrou ni copie ; les listes
+    // inchangées d'un tick à l'autre sont partagées entre snapshots successifs.
+    struct EngineSnapshot {
+        uint64_t version = 0;
+        std::chrono::system_clock::time_point time;
+        MetricsMap metrics;
+        std::shared_ptr<const std::vector<ProcessInfo>> topProcesses;
+        std::shared_ptr<const std::vector<RuleEvent>> ruleEvents; // Plus récent en dernier
+    };
+
+}
@@ -0,0 +1,364 @@
+#pragma once
+#include "MappedFile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace lsaa {
+
+    // --- JOURNAL D'ÉVÉNEMENTS ---
+    // Dossier de segments events-000001.seg, events-000002.seg... de taille fixe, projetés en mémoire :
+    //   [EventSegmentHeader] puis `capacity` emplacements EventRecord (32 octets, ordre d'écriture).
+    // `count` est mis à jour après l'écriture de l'enregistrement : un lecteur (même pendant que
+    // l'agent écrit) ne voit que des enregistrements complets. minTimeUs / maxTimeUs permettent
+    // d'écarter un segment entier sans lire ses enregistrements.
+    // names.txt : noms des règles et des actions, un par ligne (identifiant = numéro de ligne).
+
+    enum class EventTransition : uint8_t { TRIGGERED = 1, CLEARED = 2 };
+
+    // Sort de l'action au déclenchement (verdict de l'ActionLimiter)
+    enum class ActionOutcome : uint8_t { NONE = 0, RUN = 1, DUPLICATE = 2, TYPE_LIMITED = 3, GLOBAL_LIMITED = 4 };
+
+    struct EventRecord {
+        int64_t timeUs;       // system_clock, microsecondes depuis 1970
+        uint32_t rule;        // Identifiant dans names.txt
+        uint32_t action;      // kNoEventName si aucune
+        double value;         // Valeur de la métrique au moment du front (NaN si inconnue)
+        uint32_t latencyUs;   // Durée d'exécution de l'action
+        uint8_t transition;   // EventTransition
+        uint8_t outcome;      // ActionOutcome
+        uint16_t reserved;
+    };
+
+    static_assert(sizeof(EventRecord) == 32, "EventRecord layout must stay stable");
+
+    struct EventSegmentHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+        uint32_t capacity;
+        uint32_t count;
+        int64_t minTimeUs;
+        int64_t maxTimeUs;
+        uint8_t reserved[24];
+    };
+
+    static_assert(sizeof(EventSegmentHeader) == 64, "EventSegmentHeader layout must stay stable");
+
+    constexpr char kEventJournalMagic[8] = {'L', 'S', 'A', 'A', 'E', 'V', 'N', 'T'};
+    constexpr uint32_t kEventJournalVersion = 1;
+    constexpr uint32_t kEventJournalByteOrder = 0x01020304;
+    constexpr uint32_t kNoEventName = UINT32_MAX;
+
+    inline const char* outcomeName(ActionOutcome outcome) {
+        switch (outcome) {
+            case ActionOutcome::NONE: return "-";
+            case ActionOutcome::RUN: return "run";
+            case ActionOutcome::DUPLICATE: return "deduplicated";
+            case ActionOutcome::TYPE_LIMITED: return "rate-limited (type)";
+            case ActionOutcome::GLOBAL_LIMITED: return "rate-limited (global)";
+        }
+        return "?";
+    }
+
+    inline int64_t eventTimeNow() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Validation commune à l'écriture (reprise d'un segment) et à la lecture
+    inline const EventSegmentHeader* eventSegmentHeader(const MappedFile& file) {
+        if (file.size() < sizeof(EventSegmentHeader)) return nullptr;
+        const auto* header = (const EventSegmentHeader*)file.data();
+        if (std::memcmp(header->magic, kEventJournalMagic, sizeof(header->magic)) != 0) return nullptr;
+        if (header->version != kEventJournalVersion || header->byteOrder != kEventJournalByteOrder) return nullptr;
+        if (file.size() < sizeof(EventSegmentHeader) + (size_t)header->capacity * sizeof(EventRecord)) return nullptr;
+        return header;
+    }
+
+    // Numéros des segments présents dans `dir`, croissants
+    inline std::vector<uint32_t> eventSegmentNumbers(const std::filesystem::path& dir) {
+        std::vector<uint32_t> numbers;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+            unsigned number = 0;
+            char tail = 0;
+            std::string name = entry.path().filename().string();
+            if (std::sscanf(name.c_str(), "events-%u.se%c", &number, &tail) == 2 && tail == 'g' && number > 0) {
+                numbers.push_back(number);
+            }
+        }
+        std::sort(numbers.begin(), numbers.end());
+        return numbers;
+    }
+
+    inline std::filesystem::path eventSegmentPath(const std::filesystem::path& dir, uint32_t number) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "events-%06u.seg", number);
+        return dir / name;
+    }
+
+    // Ecriture des fronts de règles (thread moteur). Sans open(), record() ne fait rien.
+    class EventJournal {
+    public:
+        static constexpr uint32_t kSegmentRecords = 1u << 16; // 2 Mo par segment
+
+        static EventJournal& instance() {
+            static EventJournal journal;
+            return journal;
+        }
+
+        EventJournal() = default;
+        EventJournal(const EventJournal&) = delete;
+        EventJournal& operator=(const EventJournal&) = delete;
+
+        // Reprend le dernier segment s'il n'est pas plein
+        bool open(const std::string& dir) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closeLocked();
+            std::error_code ec;
+            dir_ = dir;
+            std::filesystem::create_directories(dir_, ec);
+
+            {
+                std::ifstream in(dir_ / "names.txt");
+                std::string line;
+                while (std::getline(in, line)) ids_.emplace(line, (uint32_t)ids_.size());
+            }
+            names_.open(dir_ / "names.txt", std::ios::app);
+            if (!names_.is_open()) return false;
+
+            auto numbers = eventSegmentNumbers(dir_);
+            uint32_t last = numbers.empty() ? 0 : numbers.back();
+            if (last && openSegment(last, false)) return true;
+            return openSegment(last + 1, true);
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closeLocked();
+        }
+
+        bool isOpen() const { return open_.load(std::memory_order_acquire); }
+        uint64_t recorded() const { return recorded_.load(std::memory_order_relaxed); }
+
+        void record(std::string_view rule, std::string_view action, EventTransition transition, double value,
+                    ActionOutcome outcome, std::chrono::microseconds latency, int64_t timeUs = eventTimeNow()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!segment_) return;
+            auto* header = (EventSegmentHeader*)segment_.writableData();
+            if (header->count >= header->capacity) {
+                if (!openSegment(segmentNumber_ + 1, true)) return;
+                header = (EventSegmentHeader*)segment_.writableData();
+            }
+
+            EventRecord r{};
+            r.timeUs = timeUs;
+            r.rule = intern(rule);
+            r.action = action.empty() ? kNoEventName : intern(action);
+            r.value = value;
+            r.latencyUs = (uint32_t)std::clamp<long long>(latency.count(), 0, UINT32_MAX);
+            r.transition = (uint8_t)transition;
+            r.outcome = (uint8_t)outcome;
+            std::memcpy(segment_.writableData() + sizeof(EventSegmentHeader) + (size_t)header->count * sizeof(EventRecord), &r, sizeof(r));
+            header->minTimeUs = std::min(header->minTimeUs, timeUs);
+            header->maxTimeUs = std::max(header->maxTimeUs, timeUs);
+            std::atomic_thread_fence(std::memory_order_release);
+            header->count++;
+            recorded_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+    private:
+        std::mutex mutex_;
+        std::filesystem::path dir_;
+        MappedFile segment_;
+        uint32_t segmentNumber_ = 0;
+        std::map<std::string, uint32_t, std::less<>> ids_;
+        std::ofstream names_;
+        std::atomic<bool> open_{false};
+        std::atomic<uint64_t> recorded_{0};
+
+        bool openSegment(uint32_t number, bool create) {
+            std::filesystem::path path = eventSegmentPath(dir_, number);
+            const size_t size = sizeof(EventSegmentHeader) + (size_t)kSegmentRecords * sizeof(EventRecord);
+            if (!create) {
+                // Segment existant : repris seulement s'il est valide et pas plein
+                MappedFile existing;
+                if (!existing.openWritable(path.string(), size)) return false;
+                const EventSegmentHeader* header = eventSegmentHeader(existing);
+                if (!header || header->count >= header->capacity) return false;
+                segment_ = std::move(existing);
+            } else {
+                std::error_code ec;
+                std::filesystem::remove(path, ec);
+                if (!segment_.openWritable(path.string(), size)) {
+                    open_.store(false, std::memory_order_release);
+                    return false;
+                }
+                EventSegmentHeader header{};
+                std::memcpy(header.magic, kEventJournalMagic, sizeof(header.magic));
+                header.version = kEventJournalVersion;
+                header.byteOrder = kEventJournalByteOrder;
+                header.capacity = kSegmentRecords;
+                header.minTimeUs = std::numeric_limits<int64_t>::max();
+                header.maxTimeUs = std::numeric_limits<int64_t>::min();
+                std::memcpy(segment_.writableData(), &header, sizeof(header));
+            }
+            segmentNumber_ = number;
+            open_.store(true, std::memory_order_release);
+            return true;
+        }
+
+        void closeLocked() {
+            segment_.close();
+            names_.close();
+            ids_.clear();
+            open_.store(false, std::memory_order_release);
+        }
+
+        // Nouveau nom écrit dans names.txt avant tout enregistrement qui l'utilise
+        uint32_t intern(std::string_view name) {
+            if (auto it = ids_.find(name); it != ids_.end()) return it->second;
+            std::string line(name);
+            std::replace(line.begin(), line.end(), '\n', ' ');
+            uint32_t id = (uint32_t)ids_.size();
+            names_ << line << '\n';
+            names_.flush();
+            ids_.emplace(std::move(line), id);
+            return id;
+        }
+    };
+
+    // Lecture des segments (projection en lecture seule), utilisable pendant que l'agent écrit
+    class EventJournalReader {
+    public:
+        bool open(const std::string& dir) {
+            names_.clear();
+            segments_.clear();
+            std::ifstream in(std::filesystem::path(dir) / "names.txt");
+            if (!in.is_open()) return false;
+            std::string line;
+            while (std::getline(in, line)) names_.push_back(line);
+
+            for (uint32_t number : eventSegmentNumbers(dir)) {
+                MappedFile file;
+                if (file.open(eventSegmentPath(dir, number).string()) && eventSegmentHeader(file)) {
+                    segments_.push_back(std::move(file));
+                }
+            }
+            return true;
+        }
+
+        size_t segmentCount() const { return segments_.size(); }
+
+        std::string name(uint32_t id) const {
+            if (id == kNoEventName) return "";
+            return id < names_.size() ? names_[id] : "#" + std::to_string(id);
+        }
+
+        // Identifiant d'un nom, kNoEventName s'il n'a jamais été journalisé
+        uint32_t find(std::string_view name) const {
+            auto it = std::find(names_.begin(), names_.end(), name);
+            return it == names_.end() ? kNoEventName : (uint32_t)(it - names_.begin());
+        }
+
+        // Appelle f(record) pour les enregistrements de [fromUs, toUs), dans l'ordre d'écriture.
+        // Retourne le nombre de segments parcourus (les autres sont écartés par leur en-tête).
+        template <typename Fn>
+        size_t forEach(int64_t fromUs, int64_t toUs, Fn&& f) const {
+            size_t scanned = 0;
+            for (const auto& file : segments_) {
+                EventSegmentHeader header;
+                std::memcpy(&header, file.data(), sizeof(header));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (header.count == 0 || header.maxTimeUs < fromUs || header.minTimeUs >= toUs) continue;
+                scanned++;
+                const char* records = file.data() + sizeof(EventSegmentHeader);
+                for (uint32_t i = 0; i < std::min(header.count, header.capacity); ++i) {
+                    EventRecord r;
+                    std::memcpy(&r, records + (size_t)i * sizeof(EventRecord), sizeof(r));
+                    if (r.timeUs >= fromUs && r.timeUs < toUs) f(r);
+                }
+            }
+            return scanned;
+        }
+
+    private:
+        std::vector<std::string> names_;
+        std::vector<MappedFile> segments_;
+    };
+
+    struct RuleEventStats {
+        uint32_t rule = kNoEventName;
+        uint64_t triggers = 0;
+        uint64_t clears = 0;
+        int64_t activeUs = 0;    // Temps passé déclenchée dans la plage
+        int64_t longestUs = 0;
+        uint64_t actionsRun = 0;
+        uint64_t actionsSuppressed = 0; // Dédupliquées ou limitées
+        uint64_t latencyUs = 0;         // Somme, à diviser par actionsRun
+        double maxValue = std::nan("");
+    };
+
+    // Statistiques par règle sur [fromUs, toUs). Une période déclenchée est coupée aux bornes :
+    // si le premier front d'une règle dans la plage est un retour à la normale, la période compte
+    // depuis fromUs ; une règle encore déclenchée compte jusqu'à toUs (ou maintenant).
+    // `rule` = kNoEventName : toutes les règles.
+    inline std::vector<RuleEventStats> summarizeEvents(const EventJournalReader& reader, int64_t fromUs, int64_t toUs,
+                                                       uint32_t rule = kNoEventName) {
+        std::map<uint32_t, RuleEventStats> stats;
+        std::map<uint32_t, int64_t> activeSince;
+        auto close = [](RuleEventStats& s, int64_t since, int64_t until) {
+            int64_t d = std::max<int64_t>(0, until - since);
+            s.activeUs += d;
+            s.longestUs = std::max(s.longestUs, d);
+        };
+        reader.forEach(fromUs, toUs, [&](const EventRecord& r) {
+            if (rule != kNoEventName && r.rule != rule) return;
+            RuleEventStats& s = stats[r.rule];
+            const bool first = s.triggers + s.clears == 0;
+            s.rule = r.rule;
+            if (!std::isnan(r.value) && (std::isnan(s.maxValue) || r.value > s.maxValue)) s.maxValue = r.value;
+            if (r.transition == (uint8_t)EventTransition::TRIGGERED) {
+                s.triggers++;
+                activeSince.try_emplace(r.rule, r.timeUs); // Redémarrage de l'agent : la période continue
+                if (r.outcome == (uint8_t)ActionOutcome::RUN) {
+                    s.actionsRun++;
+                    s.latencyUs += r.latencyUs;
+                } else if (r.outcome != (uint8_t)ActionOutcome::NONE) {
+                    s.actionsSuppressed++;
+                }
+            } else if (r.transition == (uint8_t)EventTransition::CLEARED) {
+                s.clears++;
+                if (auto it = activeSince.find(r.rule); it != activeSince.end()) {
+                    close(s, it->second, r.timeUs);
+                    activeSince.erase(it);
+                } else if (first && fromUs != std::numeric_limits<int64_t>::min()) {
+                    close(s, fromUs, r.timeUs); // Déclenchée avant la plage
+                }
+            }
+        });
+        int64_t end = std::min(toUs, eventTimeNow());
+        for (const auto& [id, since] : activeSince) close(stats[id], since, end);
+
+        std::vector<RuleEventStats> out;
+        out.reserve(stats.size());
+        for (auto& [id, s] : stats) out.push_back(s);
+        std::sort(out.begin(), out.end(), [](const RuleEventStats& a, const RuleEventStats& b) {
+            return a.triggers != b.triggers ? a.triggers > b.triggers : a.activeUs > b.activeUs;
+        });
+        return out;
+    }
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+#include "Platform.hpp"
+#include "Logger.hpp"
+#include <string>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace lsaa {
+
+    // Surveille un fichier (via son dossier parent, pour survivre aux sauvegardes par
+    // renommage des éditeurs) et appelle onChange sur son propre thread. Les rafales
+    // d'écritures sont regroupées : le callback part après `debounce` sans activité.
+    class FileWatcher {
+    public:
+        FileWatcher(std::string path, std::function<void()> onChange,
+                    std::chrono::milliseconds debounce = std::chrono::milliseconds(250))
+            : path_(std::move(path)), onChange_(std::move(onChange)), debounce_(debounce) {}
+
+        ~FileWatcher() { stop(); }
+
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        bool start() {
+            namespace fs = std::filesystem;
+            if (path_.empty()) {
+                LSAA_LOG_WARN("FileWatcher: no file to watch, hot reload disabled.");
+                return false;
+            }
+            fs::path p = fs::absolute(path_);
+            dir_ = p.parent_path().string();
+            fileName_ = p.filename().string();
+
+            if (!openWatch()) {
+                LSAA_LOG_WARN("FileWatcher: cannot watch " + path_ + ", hot reload disabled.");
+                return false;
+            }
+            running_ = true;
+            thread_ = std::thread([this]() { loop(); });
+            LSAA_LOG_INFO("FileWatcher: watching " + path_);
+            return true;
+        }
+
+        void stop() {
+            if (!running_) return;
+            running_ = false;
+#ifdef _WIN32
+            SetEvent(stopEvent_);
+#endif
+            if (thread_.joinable()) thread_.join();
+            closeWatch();
+        }
+
+    private:
+        std::string path_;
+        std::string dir_;
+        std::string fileName_;
+        std::function<void()> onChange_;
+        std::chrono::milliseconds debounce_;
+        std::atomic<bool> running_{false};
+        std::thread thread_;
+
+        void loop() {
+            while (running_) {
+                if (!waitChange(500)) continue;
+                // Debounce : on attend que le fichier soit stable
+                while (running_ && waitChange((int)debounce_.count())) {}
+                if (!running_) break;
+                try {
+                    onChange_();
+                } catch (const std::exception& e) {
+                    LSAA_LOG_ERROR("FileWatcher: reload failed: " + std::string(e.what()));
+                }
+            }
+        }
+
+        // waitChange(timeoutMs) : attend le prochain changement du fichier, faux sur timeout / arrêt.
+#ifdef _WIN32
+        HANDLE dirHandle_ = INVALID_HANDLE_VALUE;
+        HANDLE stopEvent_ = NULL;
+        HANDLE ioEvent_ = NULL;
+        OVERLAPPED overlapped_{};
+        alignas(DWORD) BYTE buffer_[4096];
+        bool pending_ = false;
+
+        bool openWatch() {
+            dirHandle_ = CreateFileA(dir_.c_str(), FILE_LIST_DIRECTORY,
+                                     FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                                     OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+            if (dirHandle_ == INVALID_HANDLE_VALUE) return false;
+            stopEvent_ = CreateEventA(NULL, TRUE, FALSE, NULL);
+            ioEvent_ = CreateEventA(NULL, TRUE, FALSE, NULL);
+            return stopEvent_ && ioEvent_;
+        }
+
+        void closeWatch() {
+            if (dirHandle_ != INVALID_HANDLE_VALUE) {
+                CancelIoEx(dirHandle_, NULL);
+                CloseHandle(dirHandle_);
+                dirHandle_ = INVALID_HANDLE_VALUE;
+            }
+            if (stopEvent_) { CloseHandle(stopEvent_); stopEvent_ = NULL; }
+            if (ioEvent_) { CloseHandle(ioEvent_); ioEvent_ = NULL; }
+            pending_ = false;
+        }
+
+        bool armRead() {
+            ZeroMemory(&overlapped_, sizeof(overlapped_));
+            overlapped_.hEvent = ioEvent_;
+            ResetEvent(ioEvent_);
+            pending_ = ReadDirectoryChangesW(dirHandle_, buffer_, sizeof(buffer_), FALSE,
+                                             FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE,
+                                             NULL, &overlapped_, NULL) != 0;
+            return pending_;
+        }
+
+        bool matchesFile(DWORD bytes) const {
+            if (bytes == 0) return true; // Débordement du buffer : on recharge par précaution
+            const BYTE* p = buffer_;
+            for (;;) {
+                auto* info = (const FILE_NOTIFY_INFORMATION*)p;
+                int len = WideCharToMultiByte(CP_ACP, 0, info->FileName, (int)(info->FileNameLength / sizeof(WCHAR)), NULL, 0, NULL, NULL);
+                std::string name((size_t)len, '\0');
+                WideCharToMultiByte(CP_ACP, 0, info->FileName, (int)(info->FileNameLength / sizeof(WCHAR)), name.data(), len, NULL, NULL);
+                if (_stricmp(name.c_str(), fileName_.c_str()) == 0) return true;
+                if (info->NextEntryOffset == 0) return false;
+                p += info->NextEntryOffset;
+            }
+        }
+
+        bool waitChange(int timeoutMs) {
+            if (!pending_ && !armRead()) return false;
+            HANDLE handles[2] = {stopEvent_, ioEvent_};
+            DWORD r = WaitForMultipleObjects(2, handles, FALSE, (DWORD)timeoutMs);
+            if (r != WAIT_OBJECT_0 + 1) return false;
+
+            DWORD bytes = 0;
+            pending_ = false;
+            if (!GetOverlappedResult(dirHandle_, &overlapped_, &bytes, FALSE)) return false;
+            return matchesFile(bytes);
+        }
+#else
+        int fd_ = -1;
+        int wd_ = -1;
+
+        bool openWatch() {
+            fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd_ < 0) return false;
+            wd_ = inotify_add_watch(fd_, dir_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+            if (wd_ < 0) { closeWatch(); return false; }
+            return true;
+        }
+
+        void closeWatch() {
+            if (fd_ >= 0) close(fd_);
+            fd_ = -1;
+            wd_ = -1;
+        }
+
+        bool waitChange(int timeoutMs) {
+            pollfd pfd{fd_, POLLIN, 0};
+            if (poll(&pfd, 1, timeoutMs) <= 0) return false;
+
+            alignas(inotify_event) char buf[4096];
+            bool match = false;
+            ssize_t len;
+            while ((len = read(fd_, buf, sizeof(buf))) > 0) {
+                for (char* p = buf; p < buf + len; ) {
+                    auto* ev = (inotify_event*)p;
+                    if ((ev->mask & IN_Q_OVERFLOW) || (ev->len > 0 && fileName_ == ev->name)) match = true;
+                    p += sizeof(inotify_event) + ev->len;
+                }
+            }
+            return match;
+        }
+#endif
+    };
+
+}
@@ -1,13 +1,55 @@
 #pragma once
 #include <string>
 #include <map>
+#include <string_view>
+#include <utility>
+#include <vector>
 #include <variant>
+#include <memory_resource>
+#include "TickArena.hpp"
 
 namespace lsaa {
 
-    // Types de métriques simples
-    using MetricValue = std::variant<long long, double, std::string>;
-    using MetricsMap = std::map<std::string, MetricValue>;
+    // Types de métriques simples (std::monostate = pas encore de valeur)
+    using MetricValue = std::variant<std::monostate, long long, double, std::string>;
+    using MetricsMap = std::map<std::string, MetricValue, std::less<>>; // Recherche par string_view
+
+    enum class MetricType { INTEGER, REAL, TEXT };
+
+    // Description d'une métrique publiée par un moniteur
+    struct MetricDescriptor {
+        std::string name;
+        MetricType type;
+        std::string unit;        // "percent", "bytes", "count", "per_second"...
+        bool family = false;     // name est un préfixe : les métriques concrètes sont name + suffixe
+        std::string label = {};  // Famille : nom du label Prometheus porté par le suffixe ("cgroup", "process"...)
+        bool counter = false;    // Total cumulé qui ne fait que croître (Prometheus : counter, nom en "_total")
+    };
+
+    // Valeur numérique d'une métrique (faux pour le texte ou l'absence de valeur)
+    inline bool metricAsDouble(const MetricValue& v, double& out) {
+        if (auto d = std::get_if<double>(&v)) { out = *d; return true; }
+        if (auto i = std::get_if<long long>(&v)) { out = static_cast<double>(*i); return true; }
+        return false;
+    }
+
+    // Mise à jour en place d'une entrée du magasin : aucune allocation quand la clé existe déjà
+    // et que la valeur garde son type (une chaîne réutilise sa capacité)
+    template <typename T>
+    void setMetric(MetricsMap& store, std::string_view key, T&& value) {
+        auto it = store.find(key);
+        if (it == store.end()) it = store.emplace(std::string(key), MetricValue{}).first;
+        it->second = std::forward<T>(value);
+    }
+
+    // Membre d'une famille ("<préfixe><suffixe>") : la clé est composée dans l'arène du tick
+    template <typename T>
+    void setMetric(MetricsMap& store, std::string_view prefix, std::string_view suffix, T&& value) {
+        std::pmr::string key(TickArena::current());
+        key.reserve(prefix.size() + suffix.size());
+        key.append(prefix).append(suffix);
+        setMetric(store, std::string_view(key), std::forward<T>(value));
+    }
 
     class IMonitor {
     public:
@@ -24,6 +66,18 @@ namespace lsaa {
 
         // Nom unique du moniteur
         virtual std::string getName() const = 0;
+
+        // Métriques publiées, annoncées au registre lors de l'ajout au moteur
+        virtual std::vector<MetricDescriptor> describeMetrics() const { return {}; }
+
+        // Demande la publication d'une métrique d'une famille (ex: "process_started.chrome.exe")
+        virtual bool subscribe(const std::string& metric) { (void)metric; return false; }
+
+        // Ecrit les résultats dans le magasin du moteur (mise à jour en place des entrées).
+        // A redéfinir avec setMetric() : la version par défaut construit une map par tick.
+        virtual void publishMetrics(MetricsMap& store) const {
+            for (auto& [key, value] : getMetrics()) store.insert_or_assign(key, std::move(value));
+        }
     };
 
 }
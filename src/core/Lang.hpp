@@ -1,9 +1,137 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <memory>
 #include <string>
-#include <map>
+#include <string_view>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "Logger.hpp"
+
+// Catalogue des textes de l'interface : X(CLE, anglais, français).
+// Les autres langues viennent de fichiers JSON chargés au démarrage (Lang::loadDirectory).
+#define LSAA_LANG_CATALOGUE(X) \
+    X(DASHBOARD, " DASHBOARD ", " TABLEAU DE BORD ") \
+    X(RULES, " AUTOMATION RULES ", " REGLES D'AUTOMATISATION ") \
+    X(OPTIMIZER, " CLEANER ", " NETTOYEUR ") \
+    X(STARTUP, " STARTUP APPS ", " DEMARRAGE ") \
+    X(PROCESSES, " PROCESSES ", " PROCESSUS ") \
+    X(FILTER_PROCESSES, "Filter by name...", "Filtrer par nom...") \
+    X(SYSTEM_ONLINE, " | SYSTEM ONLINE", " | SYSTEME EN LIGNE") \
+    X(PROCESSOR_LOAD, "PROCESSOR LOAD (CPU)", "CHARGE DU PROCESSEUR (CPU)") \
+    X(MEMORY_USAGE, "MEMORY USAGE (RAM)", "MEMOIRE VIVE (RAM)") \
+    X(QUICK_ACTIONS, "QUICK ACTIONS", "ACTIONS RAPIDES") \
+    X(AGENT_OVERHEAD, "AGENT OVERHEAD", "COUT DE L'AGENT") \
+    X(SAVE_TRACE, "Save trace", "Enregistrer la trace") \
+    X(RUN_CLEANER, "RUN CLEAN SCRIPT", "LANCER LE NETTOYAGE") \
+    X(TEST_NOTIF, "TEST NOTIFICATION", "TESTER LES NOTIFICATIONS") \
+    X(TOP_PROCESSES, "TOP MEMORY CONSUMERS", "APPLICATIONS GOURMANDES") \
+    X(TopProcessDesc, "List of apps using the most memory. Click KILL to stop them forcefully.", "Liste des applications utilisant le plus de memoire. Cliquez sur TUER pour les arreter.") \
+    X(LOGS, "SYSTEM EVENT LOG", "JOURNAL D'ACTIVITE") \
+    X(LogsDesc, "Real-time log of system events and rule triggers.", "Historique en temps reel des actions du systeme.") \
+    X(SAVE_CONFIG, "SAVE & APPLY CONFIGURATION", "SAUVEGARDER & APPLIQUER") \
+    X(RULE_EVENTS, "Recent rule events", "Derniers déclenchements") \
+    X(NO_RULE_EVENTS, "No rule has fired yet.", "Aucune règle ne s'est encore déclenchée.") \
+    X(RULE_TRIGGERED, "triggered", "déclenchée") \
+    X(RULE_CLEARED, "cleared", "rétablie") \
+    X(SCAN_NOW, "SCAN FOR JUNK FILES", "ANALYSER LES FICHIERS INUTILES") \
+    X(CLEAN_ALL, "DELETE ALL JUNK FILES", "TOUT NETTOYER") \
+    X(NO_JUNK, "Your system is clean! No temporary files found.", "Votre systeme est propre ! Aucun fichier temporaire trouve.") \
+    X(FOUND_FILES, "Found %zu files taking up %.2f MB of space.", "%zu fichiers trouves occupant %.2f Mo d'espace.") \
+    X(STARTUP_MANAGER, "Startup Programs Manager", "Gestionnaire de Demarrage Windows") \
+    X(BOOT_COST, "BOOT COST (measured after login)", "COUT AU DEMARRAGE (mesure apres l'ouverture de session)") \
+    X(BOOT_MEASURING, "Measuring the first %d minutes of the session...", "Mesure des %d premieres minutes de la session...") \
+    X(BOOT_IDLE, "System idle %.0f s after login.", "Systeme au repos %.0f s apres l'ouverture de session.") \
+    X(BOOT_NOT_IDLE, "System still busy after %d minutes.", "Systeme encore occupe apres %d minutes.") \
+    X(BOOT_UNAVAILABLE, "No measurement: the agent must start within %d minutes of login.", "Pas de mesure : l'agent doit demarrer dans les %d minutes suivant l'ouverture de session.") \
+    X(ADD, "ADD PROGRAM", "AJOUTER") \
+    X(REMOVE, "DISABLE", "DESACTIVER") \
+    X(PATH, "File Path", "Chemin du fichier") \
+    X(NAME, "Application Name", "Nom de l'application") \
+    X(ACTION, "Action", "Action") \
+    X(SYS_TEMP, "System Temporary Files", "Fichiers Temporaires Systeme") \
+    X(CHROME_CACHE, "Google Chrome Cache", "Cache Google Chrome") \
+    X(EDGE_CACHE, "Microsoft Edge Cache", "Cache Microsoft Edge") \
+    X(FIREFOX_CACHE, "Firefox Cache", "Cache Firefox") \
+    X(DNS_CACHE, "DNS Cache (Flush)", "Cache DNS (Vider)") \
+    X(SERVICES, " SERVICES ", " SERVICES ") \
+    X(DESC_SERVICES, "Manage Windows background services. Stop unnecessary services to free up resources.", "Gerez les services Windows en arriere-plan. Arretez les services inutiles pour gagner des ressources.") \
+    X(START_SERVICE, "START", "DEMARRER") \
+    X(STOP_SERVICE, "STOP", "ARRETER") \
+    X(STATUS, "Status", "Etat") \
+    X(DISPLAY_NAME, "Display Name", "Nom Affiché") \
+    X(PID, "PID", "PID") \
+    X(START_SELECTED, "Start selected", "Démarrer la sélection") \
+    X(STOP_SELECTED, "Stop selected", "Arrêter la sélection") \
+    X(DISABLE_SELECTED, "Disable selected", "Désactiver la sélection") \
+    X(LAST_BATCH, "Last batch: %zu/%zu reached their target state, slowest %lld ms", "Dernier lot : %zu/%zu dans l'état voulu, le plus lent %lld ms") \
+    X(LOG_EXPLORER, " LOG EXPLORER ", " JOURNAL ") \
+    X(LOG_SEARCH_HINT, "Search lsaa.log (case-sensitive)...", "Rechercher dans lsaa.log (respecte la casse)...") \
+    X(LOG_FROM, "From YYYY-MM-DD HH:MM:SS", "Du AAAA-MM-JJ HH:MM:SS") \
+    X(LOG_TO, "To YYYY-MM-DD HH:MM:SS", "Au AAAA-MM-JJ HH:MM:SS") \
+    X(LOG_GO, "GO", "ALLER") \
+    X(LOG_INDEXING, "Indexing %.0f / %.0f MB...", "Indexation %.0f / %.0f Mo...") \
+    X(LOG_LINES, "%zu lines, %.1f MB", "%zu lignes, %.1f Mo") \
+    X(LOG_HITS, "| %zu matches, %.0f%% scanned in %.0f ms", "| %zu resultats, %.0f%% parcouru en %.0f ms") \
+    X(LOG_TRUNCATED, "(first matches only, refine the search)", "(premiers resultats seulement, affinez la recherche)") \
+    /* Explications / Tooltips */ \
+    X(DESC_DASHBOARD, "Overview of your computer's health. Monitor CPU/RAM usage and control active processes.", "Vue d'ensemble de la sante de votre PC. Surveillez le processeur, la memoire et les logiciels actifs.") \
+    X(DESC_RULES, "Automate your PC! Set limits (e.g., 'If RAM > 90%') and let the agent alert you or act automatically.", "Automatisez votre PC ! Definissez des limites (ex: 'Si RAM > 90%') pour recevoir une alerte.") \
+    X(DESC_OPTIMIZER, "Reclaim disk space by deleting temporary files and system leftovers safely.", "Liberez de l'espace disque en supprimant les fichiers temporaires et les residus systeme.") \
+    X(DESC_STARTUP, "Speed up your Windows boot time by disabling programs that start automatically.", "Accelerez le demarrage de Windows en desactivant les logiciels qui se lancent inutilement.") \
+    X(HELP_CPU, "Percentage of your processor's power currently being used.", "Pourcentage de la puissance de calcul actuellement utilisee.") \
+    X(HELP_RAM, "Amount of short-term memory (RAM) used by open apps.", "Quantite de memoire rapide (RAM) utilisee par vos applications ouvertes.") \
+    X(HELP_KILL, "Forcefully crashes/stops the application. Data may be lost.", "Force l'arret immediat du logiciel. Des donnees non sauvegardees peuvent etre perdues.")
 
 namespace lsaa {
 
+    // Index des textes, résolus à la compilation
+    enum class Str : uint16_t {
+#define LSAA_LANG_ID(id, en, fr) id,
+        LSAA_LANG_CATALOGUE(LSAA_LANG_ID)
+#undef LSAA_LANG_ID
+        COUNT
+    };
+
+    inline constexpr size_t kLangKeyCount = (size_t)Str::COUNT;
+
+    inline constexpr std::array<std::string_view, kLangKeyCount> kLangKeyNames = {
+#define LSAA_LANG_NAME(id, en, fr) #id,
+        LSAA_LANG_CATALOGUE(LSAA_LANG_NAME)
+#undef LSAA_LANG_NAME
+    };
+
+    // Clé de traduction. Construite depuis un littéral, elle est résolue à la compilation :
+    // get("DASHBOARD") ne coûte qu'un accès tableau, et une clé inconnue ne compile pas.
+    class LangKey {
+    public:
+        consteval LangKey(const char* name) : index_(resolve(name)) {}
+        constexpr LangKey(Str id) : index_((uint16_t)id) {}
+
+        constexpr size_t index() const { return index_; }
+
+        // Recherche à l'exécution (fichiers de langue), -1 si la clé n'existe pas
+        static constexpr int find(std::string_view name) {
+            for (size_t i = 0; i < kLangKeyCount; ++i) {
+                if (kLangKeyNames[i] == name) return (int)i;
+            }
+            return -1;
+        }
+
+    private:
+        uint16_t index_;
+
+        static consteval uint16_t resolve(std::string_view name) {
+            int i = find(name);
+            if (i < 0) throw "unknown Lang key"; // Erreur de compilation
+            return (uint16_t)i;
+        }
+    };
+
+    // Langues intégrées, dans l'ordre des tables
     enum class Language { EN, FR };
 
     class Lang {
@@ -14,122 +142,109 @@ namespace lsaa {
         }
 
         void setLanguage(Language lang) {
-            currentLang_ = lang;
+            current_ = (size_t)lang;
         }
 
-        Language getLanguage() const { return currentLang_; }
-        
+        // Langue courante : index dans la liste (intégrées puis fichiers chargés)
+        size_t getLanguage() const { return current_; }
+        size_t languageCount() const { return tables_.size(); }
+        const char* code(size_t index) const { return tables_[index].code.c_str(); }
+        const char* name(size_t index) const { return tables_[index].name.c_str(); }
+
+        void setLanguage(size_t index) {
+            if (index < tables_.size()) current_ = index;
+        }
+
+        // Passe à la langue suivante (EN -> FR -> langues chargées -> EN)
         void toggle() {
-            currentLang_ = (currentLang_ == Language::EN) ? Language::FR : Language::EN;
+            current_ = (current_ + 1) % tables_.size();
+        }
+
+        const char* get(LangKey key) const {
+            return tables_[current_].strings[key.index()];
         }
 
-        const char* get(const std::string& key) {
-            const auto& dict = (currentLang_ == Language::FR) ? fr_ : en_;
-            if (dict.count(key)) return dict.at(key).c_str();
-            return key.c_str();
+        // Fichier de langue : {"code": "DE", "name": "Deutsch", "strings": {"DASHBOARD": "...", ...}}
+        // Les textes absents restent en anglais. Un code existant remplace la table correspondante.
+        // A appeler au démarrage, avant le premier rendu.
+        bool loadFile(const std::filesystem::path& path) {
+            try {
+                std::ifstream f(path);
+                if (!f.is_open()) return false;
+                nlohmann::json j = nlohmann::json::parse(f);
+
+                Table table;
+                table.code = j.at("code").get<std::string>();
+                table.name = j.value("name", table.code);
+                table.strings = kEnglish;
+                table.owned = std::make_unique<std::string[]>(kLangKeyCount);
+
+                size_t translated = 0;
+                for (const auto& [key, value] : j.at("strings").items()) {
+                    int i = LangKey::find(key);
+                    if (i < 0) {
+                        LSAA_LOG_WARN("Lang: unknown key '" + key + "' in " + path.string());
+                        continue;
+                    }
+                    table.owned[i] = value.get<std::string>();
+                    table.strings[i] = table.owned[i].c_str();
+                    translated++;
+                }
+                if (translated < kLangKeyCount) {
+                    LSAA_LOG_WARN("Lang: " + table.code + " translates " + std::to_string(translated) + "/" +
+                                  std::to_string(kLangKeyCount) + " strings, the rest stays in English");
+                }
+
+                for (auto& existing : tables_) {
+                    if (existing.code == table.code) {
+                        existing = std::move(table);
+                        return true;
+                    }
+                }
+                tables_.push_back(std::move(table));
+                LSAA_LOG_INFO("Lang: loaded " + tables_.back().code + " from " + path.string());
+                return true;
+            } catch (const std::exception& e) {
+                LSAA_LOG_ERROR("Lang: failed to load " + path.string() + ": " + e.what());
+                return false;
+            }
+        }
+
+        // Charge tous les *.json d'un dossier (ex: "lang"), par ordre alphabétique
+        size_t loadDirectory(const std::filesystem::path& dir) {
+            std::error_code ec;
+            if (!std::filesystem::is_directory(dir, ec)) return 0;
+            std::vector<std::filesystem::path> files;
+            for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+                if (entry.path().extension() == ".json") files.push_back(entry.path());
+            }
+            std::sort(files.begin(), files.end());
+            size_t loaded = 0;
+            for (const auto& file : files) loaded += loadFile(file);
+            return loaded;
         }
 
     private:
+        struct Table {
+            std::string code;
+            std::string name;
+            std::array<const char*, kLangKeyCount> strings{};
+            std::unique_ptr<std::string[]> owned; // Textes des fichiers (vide pour les langues intégrées)
+        };
+
+#define LSAA_LANG_EN(id, en, fr) en,
+#define LSAA_LANG_FR(id, en, fr) fr,
+        static constexpr std::array<const char*, kLangKeyCount> kEnglish = { LSAA_LANG_CATALOGUE(LSAA_LANG_EN) };
+        static constexpr std::array<const char*, kLangKeyCount> kFrench = { LSAA_LANG_CATALOGUE(LSAA_LANG_FR) };
+#undef LSAA_LANG_EN
+#undef LSAA_LANG_FR
+
         Lang() {
-            // --- ENGLISH ---
-            en_["DASHBOARD"] = " DASHBOARD ";
-            en_["RULES"] = " AUTOMATION RULES ";
-            en_["OPTIMIZER"] = " CLEANER ";
-            en_["STARTUP"] = " STARTUP APPS ";
-            en_["SYSTEM_ONLINE"] = " | SYSTEM ONLINE";
-            en_["PROCESSOR_LOAD"] = "PROCESSOR LOAD (CPU)";
-            en_["MEMORY_USAGE"] = "MEMORY USAGE (RAM)";
-            en_["QUICK_ACTIONS"] = "QUICK ACTIONS";
-            en_["RUN_CLEANER"] = "RUN CLEAN SCRIPT";
-            en_["TEST_NOTIF"] = "TEST NOTIFICATION";
-            en_["TOP_PROCESSES"] = "TOP MEMORY CONSUMERS";
-            en_["TopProcessDesc"] = "List of apps using the most memory. Click KILL to stop them forcefully.";
-            en_["LOGS"] = "SYSTEM EVENT LOG";
-            en_["LogsDesc"] = "Real-time log of system events and rule triggers.";
-            en_["SAVE_CONFIG"] = "SAVE & APPLY CONFIGURATION";
-            en_["SCAN_NOW"] = "SCAN FOR JUNK FILES";
-            en_["CLEAN_ALL"] = "DELETE ALL JUNK FILES";
-            en_["NO_JUNK"] = "Your system is clean! No temporary files found.";
-            en_["FOUND_FILES"] = "Found %zu files taking up %.2f MB of space.";
-            en_["STARTUP_MANAGER"] = "Startup Programs Manager";
-            en_["ADD"] = "ADD PROGRAM";
-            en_["REMOVE"] = "DISABLE";
-            en_["PATH"] = "File Path";
-            en_["NAME"] = "Application Name";
-            en_["ACTION"] = "Action";
-            en_["SYS_TEMP"] = "System Temporary Files";
-            en_["CHROME_CACHE"] = "Google Chrome Cache";
-            en_["EDGE_CACHE"] = "Microsoft Edge Cache";
-            en_["FIREFOX_CACHE"] = "Firefox Cache";
-            en_["DNS_CACHE"] = "DNS Cache (Flush)";
-            en_["SERVICES"] = " SERVICES ";
-            en_["DESC_SERVICES"] = "Manage Windows background services. Stop unnecessary services to free up resources.";
-            en_["START_SERVICE"] = "START";
-            en_["STOP_SERVICE"] = "STOP";
-            en_["STATUS"] = "Status";
-            en_["DISPLAY_NAME"] = "Display Name";
-            en_["PID"] = "PID";
-            
-            // Explanations / Tooltips
-            en_["DESC_DASHBOARD"] = "Overview of your computer's health. Monitor CPU/RAM usage and control active processes.";
-            en_["DESC_RULES"] = "Automate your PC! Set limits (e.g., 'If RAM > 90%') and let the agent alert you or act automatically.";
-            en_["DESC_OPTIMIZER"] = "Reclaim disk space by deleting temporary files and system leftovers safely.";
-            en_["DESC_STARTUP"] = "Speed up your Windows boot time by disabling programs that start automatically.";
-            en_["HELP_CPU"] = "Percentage of your processor's power currently being used.";
-            en_["HELP_RAM"] = "Amount of short-term memory (RAM) used by open apps.";
-            en_["HELP_KILL"] = "Forcefully crashes/stops the application. Data may be lost.";
-
-            // --- FRANCAIS ---
-            fr_["DASHBOARD"] = " TABLEAU DE BORD ";
-            fr_["RULES"] = " REGLES D'AUTOMATISATION ";
-            fr_["OPTIMIZER"] = " NETTOYEUR ";
-            fr_["STARTUP"] = " DEMARRAGE ";
-            fr_["SYSTEM_ONLINE"] = " | SYSTEME EN LIGNE";
-            fr_["PROCESSOR_LOAD"] = "CHARGE DU PROCESSEUR (CPU)";
-            fr_["MEMORY_USAGE"] = "MEMOIRE VIVE (RAM)";
-            fr_["QUICK_ACTIONS"] = "ACTIONS RAPIDES";
-            fr_["RUN_CLEANER"] = "LANCER LE NETTOYAGE";
-            fr_["TEST_NOTIF"] = "TESTER LES NOTIFICATIONS";
-            fr_["TOP_PROCESSES"] = "APPLICATIONS GOURMANDES";
-            fr_["TopProcessDesc"] = "Liste des applications utilisant le plus de memoire. Cliquez sur TUER pour les arreter.";
-            fr_["LOGS"] = "JOURNAL D'ACTIVITE";
-            fr_["LogsDesc"] = "Historique en temps reel des actions du systeme.";
-            fr_["SAVE_CONFIG"] = "SAUVEGARDER & APPLIQUER";
-            fr_["SCAN_NOW"] = "ANALYSER LES FICHIERS INUTILES";
-            fr_["CLEAN_ALL"] = "TOUT NETTOYER";
-            fr_["NO_JUNK"] = "Votre systeme est propre ! Aucun fichier temporaire trouve.";
-            fr_["FOUND_FILES"] = "%zu fichiers trouves occupant %.2f Mo d'espace.";
-            fr_["STARTUP_MANAGER"] = "Gestionnaire de Demarrage Windows";
-            fr_["ADD"] = "AJOUTER";
-            fr_["REMOVE"] = "DESACTIVER";
-            fr_["PATH"] = "Chemin du fichier";
-            fr_["NAME"] = "Nom de l'application";
-            fr_["ACTION"] = "Action";
-            fr_["SYS_TEMP"] = "Fichiers Temporaires Systeme";
-            fr_["CHROME_CACHE"] = "Cache Google Chrome";
-            fr_["EDGE_CACHE"] = "Cache Microsoft Edge";
-            fr_["FIREFOX_CACHE"] = "Cache Firefox";
-            fr_["DNS_CACHE"] = "Cache DNS (Vider)";
-            fr_["SERVICES"] = " SERVICES ";
-            fr_["DESC_SERVICES"] = "Gerez les services Windows en arriere-plan. Arretez les services inutiles pour gagner des ressources.";
-            fr_["START_SERVICE"] = "DEMARRER";
-            fr_["STOP_SERVICE"] = "ARRETER";
-            fr_["STATUS"] = "Etat";
-            fr_["DISPLAY_NAME"] = "Nom Affiché";
-            fr_["PID"] = "PID";
-
-            // Explications / Tooltips
-            fr_["DESC_DASHBOARD"] = "Vue d'ensemble de la sante de votre PC. Surveillez le processeur, la memoire et les logiciels actifs.";
-            fr_["DESC_RULES"] = "Automatisez votre PC ! Definissez des limites (ex: 'Si RAM > 90%') pour recevoir une alerte.";
-            fr_["DESC_OPTIMIZER"] = "Liberez de l'espace disque en supprimant les fichiers temporaires et les residus systeme.";
-            fr_["DESC_STARTUP"] = "Accelerez le demarrage de Windows en desactivant les logiciels qui se lancent inutilement.";
-            fr_["HELP_CPU"] = "Pourcentage de la puissance de calcul actuellement utilisee.";
-            fr_["HELP_RAM"] = "Quantite de memoire rapide (RAM) utilisee par vos applications ouvertes.";
-            fr_["HELP_KILL"] = "Force l'arret immediat du logiciel. Des donnees non sauvegardees peuvent etre perdues.";
+            tables_.push_back({"EN", "English", kEnglish, nullptr});
+            tables_.push_back({"FR", "Français", kFrench, nullptr});
         }
 
-        Language currentLang_ = Language::EN;
-        std::map<std::string, std::string> en_;
-        std::map<std::string, std::string> fr_;
+        std::vector<Table> tables_;
+        size_t current_ = (size_t)Language::EN;
     };
 }
@@ -0,0 +1,83 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace lsaa {
+
+    // Droite des moindres carrés sur les N derniers points (t en secondes, y quelconque).
+    // Les sommes sont mises à jour à chaque point (ajout du nouveau, retrait du plus ancien),
+    // sans relire l'historique. Elles sont exprimées par rapport au dernier t, recentrées
+    // algébriquement à chaque ajout : pas de perte de précision quand t grandit.
+    class LinearTrend {
+    public:
+        explicit LinearTrend(size_t window) : t_(window), y_(window) {}
+
+        void add(double t, double y) {
+            // Recentrage des sommes sur le nouveau t
+            double shift = count_ ? t - last_ : 0.0;
+            sumTT_ -= 2.0 * shift * sumT_ - (double)count_ * shift * shift;
+            sumTY_ -= shift * sumY_;
+            sumT_ -= (double)count_ * shift;
+            last_ = t;
+
+            if (count_ == t_.size()) {
+                double oldT = t_[head_] - t, oldY = y_[head_];
+                sumT_ -= oldT;
+                sumY_ -= oldY;
+                sumTT_ -= oldT * oldT;
+                sumTY_ -= oldT * oldY;
+                count_--;
+            }
+            t_[head_] = t;
+            y_[head_] = y;
+            head_ = (head_ + 1) % t_.size();
+            sumY_ += y;
+            count_++;
+        }
+
+        size_t size() const { return count_; }
+        size_t capacity() const { return t_.size(); }
+
+        void clear() {
+            count_ = head_ = 0;
+            sumT_ = sumY_ = sumTT_ = sumTY_ = 0.0;
+        }
+
+        // Pente (unités de y par seconde) ; 0 si moins de 2 points distincts
+        double slope() const {
+            double n = (double)count_;
+            double denom = n * sumTT_ - sumT_ * sumT_;
+            if (count_ < 2 || denom <= 1e-12 * n * sumTT_) return 0.0;
+            return (n * sumTY_ - sumT_ * sumY_) / denom;
+        }
+
+        // Valeur ajustée au dernier point
+        double current() const {
+            if (count_ == 0) return 0.0;
+            return (sumY_ - slope() * sumT_) / (double)count_;
+        }
+
+        // Secondes avant que la droite atteigne `level` : 0 si déjà atteint, +inf si la tendance n'y mène pas
+        double secondsUntil(double level) const {
+            double y = current(), s = slope();
+            if (y >= level) return 0.0;
+            if (s <= 0.0) return std::numeric_limits<double>::infinity();
+            return (level - y) / s;
+        }
+
+    private:
+        std::vector<double> t_;
+        std::vector<double> y_;
+        size_t head_ = 0;
+        size_t count_ = 0;
+        double last_ = 0.0;
+        // Sommes sur t' = t - last_
+        double sumT_ = 0.0;
+        double sumY_ = 0.0;
+        double sumTT_ = 0.0;
+        double sumTY_ = 0.0;
+    };
+
+}
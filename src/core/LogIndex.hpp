@@ -0,0 +1,511 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "MappedFile.hpp"
+#include "Tracer.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LSAA_LOG_SIMD 1
+#endif
+
+namespace lsaa {
+
+    // Première occurrence de `needle` dans [first, last), nullptr sinon.
+    // D'abord memchr sur le premier caractère (vectorisé par la libc, imbattable quand ce
+    // caractère est rare). Si les faux candidats se rapprochent (caractère fréquent), SSE2 :
+    // le premier et le dernier caractère sont comparés sur 16 positions à la fois, memcmp
+    // seulement pour les candidats.
+    inline const char* findSubstring(const char* first, const char* last, std::string_view needle) {
+        const size_t n = needle.size();
+        if (n == 0) return first;
+        if ((size_t)(last - first) < n) return nullptr;
+        if (n == 1) return (const char*)memchr(first, needle[0], (size_t)(last - first));
+
+        const char* p = first;
+        const char* stop = last - n + 1; // Départs possibles : [first, stop)
+#ifdef LSAA_LOG_SIMD
+        // Bascule sur SSE2 quand 16 faux candidats tiennent dans moins de 16 * 256 octets
+        constexpr size_t kProbeMisses = 16;
+        constexpr size_t kDenseBytes = kProbeMisses * 256;
+        const char* probeStart = p;
+        size_t misses = 0;
+        while (p < stop) {
+            const char* hit = (const char*)memchr(p, needle[0], (size_t)(stop - p));
+            if (!hit) return nullptr;
+            if (hit[n - 1] == needle[n - 1] && memcmp(hit + 1, needle.data() + 1, n - 2) == 0) return hit;
+            p = hit + 1;
+            if (++misses < kProbeMisses) continue;
+            if ((size_t)(p - probeStart) < kDenseBytes) break;
+            probeStart = p;
+            misses = 0;
+        }
+
+        const __m128i head = _mm_set1_epi8(needle[0]);
+        const __m128i tail = _mm_set1_epi8(needle[n - 1]);
+        auto candidates = [&](const char* at) {
+            __m128i a = _mm_loadu_si128((const __m128i*)at);
+            __m128i b = _mm_loadu_si128((const __m128i*)(at + n - 1));
+            return (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, head), _mm_cmpeq_epi8(b, tail)));
+        };
+        // 64 positions par tour : les candidats sont rares, le test de masque domine
+        for (; p + 64 <= stop; p += 64) {
+            uint64_t mask = (uint64_t)candidates(p) | ((uint64_t)candidates(p + 16) << 16) |
+                            ((uint64_t)candidates(p + 32) << 32) | ((uint64_t)candidates(p + 48) << 48);
+            while (mask) {
+                int bit = std::countr_zero(mask);
+                if (memcmp(p + bit + 1, needle.data() + 1, n - 2) == 0) return p + bit;
+                mask &= mask - 1;
+            }
+        }
+        for (; p + 16 <= stop; p += 16) {
+            unsigned mask = candidates(p);
+            while (mask) {
+                int bit = std::countr_zero(mask);
+                if (memcmp(p + bit + 1, needle.data() + 1, n - 2) == 0) return p + bit;
+                mask &= mask - 1;
+            }
+        }
+#endif
+        for (; p < stop; ++p) {
+            p = (const char*)memchr(p, needle[0], (size_t)(stop - p));
+            if (!p) return nullptr;
+            if (p[n - 1] == needle[n - 1] && memcmp(p + 1, needle.data() + 1, n - 2) == 0) return p;
+        }
+        return nullptr;
+    }
+
+    // Appelle f(position) pour chaque '\n' de [first, last)
+    template<class F>
+    inline void forEachNewline(const char* first, const char* last, F&& f) {
+        const char* p = first;
+#ifdef LSAA_LOG_SIMD
+        const __m128i nl = _mm_set1_epi8('\n');
+        for (; p + 16 <= last; p += 16) {
+            unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+            while (mask) {
+                f(p + std::countr_zero(mask));
+                mask &= mask - 1;
+            }
+        }
+#endif
+        while (p < last && (p = (const char*)memchr(p, '\n', (size_t)(last - p)))) f(p++);
+    }
+
+    // "2026-02-03 18:53:57" (crochet initial et heure facultatifs) -> 20260203185357, 0 si invalide.
+    // Les valeurs se comparent dans l'ordre chronologique.
+    inline uint64_t parseLogTime(std::string_view s) {
+        if (!s.empty() && s[0] == '[') s.remove_prefix(1);
+        auto digits = [&](size_t pos, size_t count, uint64_t& out) {
+            if (pos + count > s.size()) return false;
+            for (size_t i = pos; i < pos + count; ++i) {
+                if (s[i] < '0' || s[i] > '9') return false;
+                out = out * 10 + (uint64_t)(s[i] - '0');
+            }
+            return true;
+        };
+        uint64_t t = 0;
+        if (s.size() < 10 || !digits(0, 4, t) || s[4] != '-' || !digits(5, 2, t) || s[7] != '-' || !digits(8, 2, t)) return 0;
+        uint64_t h = 0, m = 0, sec = 0;
+        if (s.size() > 10 && s[10] == ' ' && digits(11, 2, h) && s.size() > 13 && s[13] == ':' && digits(14, 2, m)) {
+            if (s.size() > 16 && s[16] == ':') digits(17, 2, sec);
+        } else {
+            h = m = sec = 0;
+        }
+        return ((t * 100 + h) * 100 + m) * 100 + sec;
+    }
+
+    // Niveau d'une ligne du journal ("[horodatage] [WARN]  ..."), -1 si absent
+    inline int parseLogLevel(std::string_view line) {
+        if (line.size() > 1 && line[0] == '[' && line[1] >= '0' && line[1] <= '9') {
+            size_t close = line.substr(0, 32).find("] ");
+            if (close == std::string_view::npos) return -1;
+            line.remove_prefix(close + 2);
+        }
+        static constexpr std::string_view kTags[] = {"[DEBUG]", "[INFO]", "[WARN]", "[ERROR]"};
+        for (int i = 0; i < 4; ++i) {
+            if (line.substr(0, kTags[i].size()) == kTags[i]) return i;
+        }
+        return -1;
+    }
+
+    // Index clairsemé d'un journal (lsaa.log) construit en arrière-plan : un point de repère
+    // (offset, horodatage) toutes les kStride lignes. Le fichier est projeté en mémoire, jamais
+    // lu en entier ; l'index suit la fin du fichier tant qu'il grandit.
+    class LogIndex {
+    public:
+        static constexpr size_t kStride = 256;
+        static constexpr size_t kPublishBytes = 16u << 20; // Lignes publiées par tranches pendant l'indexation
+        static constexpr std::chrono::seconds kPollInterval{1};
+
+        // Etat cohérent pour les lecteurs : projection + lignes complètes indexées
+        struct View {
+            std::shared_ptr<const MappedFile> file;
+            size_t lines = 0;
+            uint64_t bytes = 0; // Fin de la dernière ligne indexée
+            uint64_t fileBytes = 0;
+        };
+
+        explicit LogIndex(std::string path) : path_(std::move(path)) {}
+        ~LogIndex() { stop(); }
+
+        LogIndex(const LogIndex&) = delete;
+        LogIndex& operator=(const LogIndex&) = delete;
+
+        const std::string& path() const { return path_; }
+
+        // Démarre l'indexation (sans effet si déjà lancée)
+        void start() {
+            std::lock_guard<std::mutex> lock(threadMutex_);
+            if (thread_.joinable()) return;
+            running_ = true;
+            thread_ = std::thread([this]() { run(); });
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(threadMutex_);
+                running_ = false;
+            }
+            wake_.notify_all();
+            if (thread_.joinable()) thread_.join();
+        }
+
+        // Incrémentée à chaque publication de lignes
+        uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+        View view() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return view_;
+        }
+
+        // Offset du début de la ligne `line` (v.bytes pour line >= v.lines)
+        uint64_t lineOffset(const View& v, size_t line) const {
+            if (line >= v.lines) return v.bytes;
+            uint64_t offset;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                offset = checkpoints_[line / kStride].offset;
+            }
+            const char* base = v.file->data();
+            for (size_t skip = line % kStride; skip > 0; --skip) {
+                offset = (uint64_t)((const char*)memchr(base + offset, '\n', (size_t)(v.bytes - offset)) - base) + 1;
+            }
+            return offset;
+        }
+
+        // Appelle f(numéro, texte) pour les lignes [first, first + count) de la vue
+        template<class F>
+        void forEachLine(const View& v, size_t first, size_t count, F&& f) const {
+            if (first >= v.lines) return;
+            count = std::min(count, v.lines - first);
+            const char* base = v.file->data();
+            const char* p = base + lineOffset(v, first);
+            const char* end = base + v.bytes;
+            for (size_t i = 0; i < count; ++i) {
+                const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+                size_t length = (size_t)(nl - p);
+                if (length > 0 && p[length - 1] == '\r') length--;
+                f(first + i, std::string_view(p, length));
+                p = nl + 1;
+            }
+        }
+
+        // Première ligne horodatée >= time (v.lines si aucune). Suppose le journal chronologique.
+        size_t lineAtTime(const View& v, uint64_t time) const {
+            size_t cp;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                size_t count = std::min(checkpoints_.size(), (v.lines + kStride - 1) / kStride);
+                auto it = std::lower_bound(checkpoints_.begin(), checkpoints_.begin() + count, time,
+                                           [](const Checkpoint& c, uint64_t t) { return c.time < t; });
+                cp = (size_t)(it - checkpoints_.begin());
+                if (cp > 0) cp--; // La cible peut se trouver avant le repère suivant
+            }
+            size_t found = v.lines;
+            forEachLine(v, cp * kStride, 2 * kStride, [&](size_t line, std::string_view text) {
+                if (found != v.lines) return;
+                uint64_t t = parseLogTime(text);
+                if (t != 0 && t >= time) found = line;
+            });
+            if (found == v.lines && cp * kStride + 2 * kStride < v.lines) found = cp * kStride + 2 * kStride;
+            return found;
+        }
+
+    private:
+        struct Checkpoint {
+            uint64_t offset;
+            uint64_t time; // Horodatage de la ligne (ou du dernier repère horodaté)
+        };
+
+        std::string path_;
+
+        std::mutex threadMutex_;
+        std::condition_variable wake_;
+        bool running_ = false;
+        std::thread thread_;
+
+        mutable std::mutex mutex_; // view_ et checkpoints_
+        View view_;
+        std::vector<Checkpoint> checkpoints_;
+        std::atomic<uint64_t> version_{0};
+
+        void run() {
+            LSAA_TRACE_THREAD_NAME("log-index");
+            // Etat du parcours, propre à ce thread
+            uint64_t lineStart = 0;
+            uint64_t scanned = 0; // Peut dépasser lineStart (ligne incomplète)
+            size_t lineNo = 0;
+            uint64_t lastTime = 0;
+            std::shared_ptr<const MappedFile> file;
+
+            while (true) {
+                std::error_code ec;
+                uint64_t size = std::filesystem::exists(path_, ec) ? (uint64_t)std::filesystem::file_size(path_, ec) : 0;
+                if (ec) size = 0;
+
+                // Fichier tronqué ou remplacé : on repart de zéro
+                if (size < scanned) {
+                    lineStart = 0;
+                    scanned = 0;
+                    lineNo = 0;
+                    lastTime = 0;
+                    file.reset();
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    view_ = View{};
+                    checkpoints_.clear();
+                    version_.fetch_add(1, std::memory_order_release);
+                }
+
+                // Nouvelle projection quand le fichier a grandi (l'ancienne reste valide pour ses lecteurs)
+                if (size > (file ? file->size() : 0)) {
+                    auto mapped = std::make_shared<MappedFile>();
+                    if (mapped->open(path_)) file = std::move(mapped);
+                }
+
+                while (file && scanned < file->size()) {
+                    {
+                        std::lock_guard<std::mutex> lock(threadMutex_);
+                        if (!running_) return;
+                    }
+                    LSAA_TRACE_SCOPE("log", "LogIndex::index");
+                    const char* base = file->data();
+                    uint64_t chunkBegin = scanned;
+                    uint64_t chunkEnd = std::min<uint64_t>(file->size(), chunkBegin + kPublishBytes);
+                    scanned = chunkEnd;
+                    std::vector<Checkpoint> added;
+                    forEachNewline(base + chunkBegin, base + chunkEnd, [&](const char* nl) {
+                        if (lineNo % kStride == 0) {
+                            uint64_t t = parseLogTime(std::string_view(base + lineStart, (size_t)(nl - base - lineStart)));
+                            if (t != 0) lastTime = t;
+                            added.push_back({lineStart, lastTime});
+                        }
+                        lineNo++;
+                        lineStart = (uint64_t)(nl - base) + 1;
+                    });
+
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                        checkpoints_.insert(checkpoints_.end(), added.begin(), added.end());
+                        view_.file = file;
+                        view_.lines = lineNo;
+                        view_.bytes = lineStart;
+                        view_.fileBytes = file->size();
+                    }
+                    version_.fetch_add(1, std::memory_order_release);
+                    // Ligne incomplète en fin de fichier : attendre la suite
+                    if (chunkEnd == file->size()) break;
+                }
+
+                std::unique_lock<std::mutex> lock(threadMutex_);
+                if (wake_.wait_for(lock, kPollInterval, [this]() { return !running_; })) return;
+            }
+        }
+    };
+
+    struct LogQuery {
+        std::string text;          // Sous-chaîne (sensible à la casse), vide = toutes les lignes
+        unsigned levels = 0xF;     // Bit i = LogLevel i
+        uint64_t from = 0, to = 0; // Bornes parseLogTime incluses, 0 = sans borne
+
+        static constexpr unsigned kAllLevels = 0xF;
+        bool filters() const { return !text.empty() || (levels & kAllLevels) != kAllLevels; }
+    };
+
+    // Recherche sur tout le journal indexé, dans un thread dédié. Les résultats (offsets de
+    // ligne) sont publiés par tranches : la vue les affiche pendant que le parcours continue.
+    class LogSearch {
+    public:
+        static constexpr size_t kMaxResults = 1u << 20;
+        static constexpr uint64_t kChunkBytes = 4u << 20;
+
+        struct Progress {
+            uint64_t scanned = 0;
+            uint64_t total = 0;
+            size_t hits = 0;
+            bool done = true;
+            bool truncated = false;
+            double ms = 0.0;
+        };
+
+        ~LogSearch() { cancel(); }
+
+        // Annule la recherche en cours et lance `query` sur l'état actuel de l'index
+        void start(std::shared_ptr<LogIndex> index, LogQuery query) {
+            cancel();
+            LogIndex::View v = index->view();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                view_ = v;
+                results_.clear();
+                progress_ = Progress{};
+                progress_.done = false;
+            }
+            version_.fetch_add(1, std::memory_order_release);
+            cancelled_ = false;
+            thread_ = std::thread([this, index = std::move(index), v, query = std::move(query)]() { run(*index, v, query); });
+        }
+
+        void cancel() {
+            cancelled_ = true;
+            if (thread_.joinable()) thread_.join();
+        }
+
+        void clear() {
+            cancel();
+            std::lock_guard<std::mutex> lock(mutex_);
+            view_ = LogIndex::View{};
+            results_.clear();
+            progress_ = Progress{};
+            version_.fetch_add(1, std::memory_order_release);
+        }
+
+        uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+        Progress progress() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return progress_;
+        }
+
+        // Appelle f(texte) pour les résultats [first, first + count)
+        template<class F>
+        void forEachResult(size_t first, size_t count, F&& f) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!view_.file) return;
+            const char* base = view_.file->data();
+            const char* end = base + view_.bytes;
+            for (size_t i = first; i < std::min(results_.size(), first + count); ++i) {
+                const char* p = base + results_[i];
+                const char* nl = (const char*)memchr(p, '\n', (size_t)(end - p));
+                size_t length = (size_t)((nl ? nl : end) - p);
+                if (length > 0 && p[length - 1] == '\r') length--;
+                f(std::string_view(p, length));
+            }
+        }
+
+    private:
+        mutable std::mutex mutex_; // view_, results_, progress_
+        LogIndex::View view_;
+        std::vector<uint64_t> results_;
+        Progress progress_;
+        std::atomic<uint64_t> version_{0};
+        std::atomic<bool> cancelled_{false};
+        std::thread thread_;
+
+        void run(const LogIndex& index, const LogIndex::View& v, const LogQuery& query) {
+            LSAA_TRACE_THREAD_NAME("log-search");
+            const auto started = std::chrono::steady_clock::now();
+            const char* base = v.file ? v.file->data() : nullptr;
+            uint64_t begin = query.from ? index.lineOffset(v, index.lineAtTime(v, query.from)) : 0;
+            uint64_t end = query.to ? index.lineOffset(v, index.lineAtTime(v, query.to + 1)) : v.bytes;
+            end = std::max(begin, end);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                progress_.total = end - begin;
+            }
+
+            // Sans texte, un seul niveau demandé : son étiquette sert d'aiguille
+            const bool allLevels = (query.levels & LogQuery::kAllLevels) == LogQuery::kAllLevels;
+            static constexpr std::string_view kTags[] = {"] [DEBUG]", "] [INFO]", "] [WARN]", "] [ERROR]"};
+            std::string_view needle = query.text;
+            if (needle.empty() && std::has_single_bit(query.levels & LogQuery::kAllLevels)) {
+                needle = kTags[std::countr_zero(query.levels & LogQuery::kAllLevels)];
+            }
+            auto accept = [&](std::string_view line) {
+                if (allLevels) return true;
+                int level = parseLogLevel(line);
+                return level >= 0 && (query.levels & (1u << level));
+            };
+
+            std::vector<uint64_t> found;
+            bool truncated = false;
+            uint64_t pos = begin;
+            while (pos < end && !cancelled_ && !truncated) {
+                LSAA_TRACE_SCOPE("log", "LogSearch::chunk");
+                // Tranches alignées sur les fins de ligne : une aiguille (sans '\n') n'est jamais coupée
+                uint64_t chunkEnd = std::min(end, pos + kChunkBytes);
+                if (chunkEnd < end) {
+                    const char* nl = (const char*)memchr(base + chunkEnd, '\n', (size_t)(end - chunkEnd));
+                    chunkEnd = nl ? (uint64_t)(nl - base) + 1 : end;
+                }
+                found.clear();
+                const char* chunkFirst = base + pos;
+                const char* chunkLast = base + chunkEnd;
+                if (!needle.empty()) {
+                    const char* p = chunkFirst;
+                    while (const char* hit = findSubstring(p, chunkLast, needle)) {
+                        const char* lineBegin = hit;
+                        while (lineBegin > chunkFirst && lineBegin[-1] != '\n') lineBegin--;
+                        const char* lineEnd = (const char*)memchr(hit, '\n', (size_t)(chunkLast - hit));
+                        if (!lineEnd) lineEnd = chunkLast;
+                        if (accept(std::string_view(lineBegin, (size_t)(lineEnd - lineBegin)))) {
+                            found.push_back((uint64_t)(lineBegin - base));
+                        }
+                        p = lineEnd + 1;
+                        if (p >= chunkLast) break;
+                    }
+                } else {
+                    const char* lineBegin = chunkFirst;
+                    forEachNewline(chunkFirst, chunkLast, [&](const char* nl) {
+                        if (accept(std::string_view(lineBegin, (size_t)(nl - lineBegin)))) found.push_back((uint64_t)(lineBegin - base));
+                        lineBegin = nl + 1;
+                    });
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    size_t room = kMaxResults - results_.size();
+                    if (found.size() > room) {
+                        found.resize(room);
+                        truncated = true;
+                    }
+                    results_.insert(results_.end(), found.begin(), found.end());
+                    progress_.scanned = chunkEnd - begin;
+                    progress_.hits = results_.size();
+                    progress_.truncated = truncated;
+                    progress_.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+                }
+                version_.fetch_add(1, std::memory_order_release);
+                pos = chunkEnd;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            progress_.done = true;
+            progress_.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+            version_.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+}
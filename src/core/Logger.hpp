@@ -3,9 +3,13 @@
 #include <fstream>
 #include <string>
 #include <mutex>
+#include <atomic>
+#include <cstdint>
 #include <vector>
 #include <deque>
 #include <sstream>
+#include <ctime>
+#include "Tracer.hpp"
 
 namespace lsaa {
 
@@ -48,6 +52,15 @@ namespace lsaa {
             write(ss.str());
         }
 
+        // Désactive la sortie console (benchmarks, outils en ligne de commande)
+        void setConsoleOutput(bool enabled) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            console_ = enabled;
+        }
+
+        // Incrémentée à chaque message : évite de recopier un historique inchangé
+        uint64_t getVersion() const { return version_.load(std::memory_order_acquire); }
+
         std::vector<std::string> getHistory() {
             std::lock_guard<std::mutex> lock(mutex_);
             return std::vector<std::string>(history_.begin(), history_.end());
@@ -62,22 +75,34 @@ namespace lsaa {
         std::ofstream fileStream_;
         std::mutex mutex_;
         std::deque<std::string> history_;
+        bool console_ = true;
+        std::atomic<uint64_t> version_{0};
 
         void write(const std::string& message) {
+            LSAA_TRACE_SCOPE("log", "write");
             std::lock_guard<std::mutex> lock(mutex_);
             
             // Console
-            std::cout << message << std::endl;
+            if (console_) std::cout << message << std::endl;
             
-            // File
+            // File (horodaté : l'explorateur de journal s'en sert pour l'index temporel)
             if (fileStream_.is_open()) {
-                fileStream_ << message << std::endl;
-                fileStream_.flush();
+                char stamp[32];
+                std::time_t now = std::time(nullptr);
+                std::tm local{};
+#ifdef _WIN32
+                localtime_s(&local, &now);
+#else
+                localtime_r(&now, &local);
+#endif
+                std::strftime(stamp, sizeof(stamp), "[%Y-%m-%d %H:%M:%S] ", &local);
+                fileStream_ << stamp << message << std::endl;
             }
 
             // History
             if (history_.size() > 50) history_.pop_front();
             history_.push_back(message);
+            version_.fetch_add(1, std::memory_order_release);
         }
     };
 }
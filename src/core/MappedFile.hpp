@@ -0,0 +1,131 @@
+#pragma once
+#include "Platform.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <cstddef>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace lsaa {
+
+    // Projection d'un fichier complet (CreateFileMapping / mmap), en lecture seule par défaut.
+    // Les pages ne sont chargées qu'à l'accès : rien n'est copié en RAM à l'ouverture.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        ~MappedFile() { close(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+        MappedFile& operator=(MappedFile&& other) noexcept {
+            if (this != &other) {
+                close();
+                data_ = other.data_;
+                size_ = other.size_;
+                writable_ = other.writable_;
+                other.data_ = nullptr;
+                other.size_ = 0;
+                other.writable_ = false;
+            }
+            return *this;
+        }
+
+        // Faux si le fichier est absent, illisible ou vide
+        bool open(const std::string& path) {
+            close();
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                      NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (file == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) { CloseHandle(file); return false; }
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+            CloseHandle(file); // La projection garde sa propre référence
+            if (!mapping) return false;
+            void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!view) return false;
+            data_ = (const char*)view;
+            size_ = (size_t)size.QuadPart;
+#else
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); return false; }
+            void* view = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (view == MAP_FAILED) return false;
+            data_ = (const char*)view;
+            size_ = (size_t)st.st_size;
+#endif
+            return true;
+        }
+
+        // Projection partagée en lecture/écriture, fichier créé ou agrandi à `size` octets.
+        // Les écritures atteignent le fichier via le cache du système, même si le processus est tué.
+        bool openWritable(const std::string& path, size_t size) {
+            close();
+            if (size == 0) return false;
+#ifdef _WIN32
+            HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                      NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+            if (file == INVALID_HANDLE_VALUE) return false;
+            LARGE_INTEGER current;
+            if (!GetFileSizeEx(file, &current)) { CloseHandle(file); return false; }
+            size = std::max(size, (size_t)current.QuadPart);
+            // La projection agrandit le fichier à la taille demandée
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)((uint64_t)size >> 32), (DWORD)size, NULL);
+            CloseHandle(file);
+            if (!mapping) return false;
+            void* view = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+            CloseHandle(mapping);
+            if (!view) return false;
+#else
+            int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0) { ::close(fd); return false; }
+            if ((size_t)st.st_size < size && ftruncate(fd, (off_t)size) != 0) { ::close(fd); return false; }
+            size = std::max(size, (size_t)st.st_size);
+            void* view = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            if (view == MAP_FAILED) return false;
+#endif
+            data_ = (const char*)view;
+            size_ = size;
+            writable_ = true;
+            return true;
+        }
+
+        void close() {
+            if (!data_) return;
+#ifdef _WIN32
+            UnmapViewOfFile(data_);
+#else
+            munmap((void*)data_, size_);
+#endif
+            data_ = nullptr;
+            size_ = 0;
+            writable_ = false;
+        }
+
+        const char* data() const { return data_; }
+        char* writableData() const { return writable_ ? const_cast<char*>(data_) : nullptr; }
+        size_t size() const { return size_; }
+        explicit operator bool() const { return data_ != nullptr; }
+
+    private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+        bool writable_ = false;
+    };
+
+}
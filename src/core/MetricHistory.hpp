@@ -0,0 +1,73 @@
+#pragma once
+#include "MetricTrace.hpp"
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace lsaa {
+
+    // Historique en colonnes : une colonne de doubles par métrique, alignée sur `times`.
+    // Une valeur absente ou non numérique vaut NaN (même effet que std::monostate pour une condition).
+    class MetricHistory {
+    public:
+        // Charge les métriques demandées (toutes si `names` est vide) sur [fromSec, toSec] de la trace
+        void load(MetricTraceReader& reader, const std::vector<std::string>& names,
+                  double fromSec = 0.0, double toSec = std::numeric_limits<double>::infinity()) {
+            times_.clear();
+            columns_.clear();
+            index_.clear();
+
+            const auto& metrics = reader.metrics();
+            std::unordered_set<std::string> wanted(names.begin(), names.end());
+            std::vector<int> columnOf(metrics.size(), -1);
+            for (size_t id = 0; id < metrics.size(); ++id) {
+                if (!wanted.empty() && !wanted.count(metrics[id].name)) continue;
+                columnOf[id] = (int)columns_.size();
+                index_.emplace(metrics[id].name, columns_.size());
+                columns_.emplace_back();
+            }
+
+            std::vector<double> current(columns_.size(), kMissing);
+            uint64_t from = toNs(fromSec), to = toNs(toSec);
+            uint64_t time = 0;
+            reader.rewind();
+            while (reader.next(time, [&](uint32_t id, MetricValue&& value) {
+                int col = columnOf[id];
+                if (col < 0) return;
+                double d;
+                current[col] = metricAsDouble(value, d) ? d : kMissing;
+            })) {
+                if (time < from) continue;
+                if (time > to) break;
+                times_.push_back(time);
+                for (size_t c = 0; c < columns_.size(); ++c) columns_[c].push_back(current[c]);
+            }
+        }
+
+        size_t size() const { return times_.size(); }
+        const std::vector<uint64_t>& times() const { return times_; }
+
+        // nullptr si la métrique n'a pas été chargée
+        const std::vector<double>* column(const std::string& name) const {
+            auto it = index_.find(name);
+            return it != index_.end() ? &columns_[it->second] : nullptr;
+        }
+
+        static constexpr double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+    private:
+        std::vector<uint64_t> times_;
+        std::vector<std::vector<double>> columns_;
+        std::unordered_map<std::string, size_t> index_;
+
+        static uint64_t toNs(double sec) {
+            if (!(sec > 0.0)) return 0;
+            if (sec >= 1.8e10) return UINT64_MAX;
+            return (uint64_t)(sec * 1e9);
+        }
+    };
+
+}
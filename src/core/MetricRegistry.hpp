@@ -0,0 +1,132 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include "IMonitor.hpp"
+#include "Logger.hpp"
+
+namespace lsaa {
+
+    // Métrique résolue une fois pour toutes à la construction d'une règle : l'évaluateur
+    // lit directement la valeur via `value` (noeud stable du magasin), sans recherche par nom.
+    struct MetricHandle {
+        const MetricValue* value = nullptr;
+        MetricDescriptor descriptor;
+    };
+
+    // Registre des métriques annoncées par les moniteurs + magasin des dernières valeurs.
+    // Les entrées du magasin ne sont jamais supprimées, ce qui garantit la stabilité des handles.
+    // Seul le thread moteur modifie le magasin (publish) : une métrique résolue ailleurs attend
+    // dans un noeud détaché, inséré tel quel au tick suivant (l'adresse de la valeur ne change pas).
+    class MetricRegistry {
+    public:
+        void advertise(IMonitor& owner) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& desc : owner.describeMetrics()) {
+                auto [it, inserted] = entries_.try_emplace(desc.name, Entry{desc, &owner});
+                if (!inserted) {
+                    LSAA_LOG_WARN("MetricRegistry: " + desc.name + " already published by " + it->second.owner->getName());
+                }
+            }
+        }
+
+        // Résout un nom de métrique (exact, ou membre d'une famille) en handle.
+        // Thread-safe : appelé par les constructeurs de règles hors du thread moteur.
+        // subscribe = false : validation seule (règle désactivée), sans abonner la famille
+        // ni réserver d'entrée dans le magasin.
+        bool resolve(const std::string& name, MetricHandle& out, bool subscribe = true) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const Entry* entry = find(name);
+            if (!entry) return false;
+
+            out.descriptor = entry->desc;
+            out.descriptor.name = name;
+            out.descriptor.family = false;
+            if (!subscribe) return true;
+            if (entry->desc.family && !entry->owner->subscribe(name)) return false;
+
+            // Lecture seule du magasin : le thread moteur le lit sans verrou en parallèle
+            if (auto it = store_.find(name); it != store_.end()) {
+                out.value = &it->second;
+                return true;
+            }
+            for (auto& node : pending_) {
+                if (node.key() == name) {
+                    out.value = &node.mapped();
+                    return true;
+                }
+            }
+            MetricsMap detached;
+            pending_.push_back(detached.extract(detached.try_emplace(name).first));
+            out.value = &pending_.back().mapped();
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describe() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::vector<MetricDescriptor> out;
+            out.reserve(entries_.size());
+            for (const auto& [name, entry] : entries_) out.push_back(entry.desc);
+            return out;
+        }
+
+        // Publication des valeurs du tick (thread moteur uniquement). Les entrées en attente
+        // sont insérées avant les moniteurs : aucun d'eux n'a pu créer la même clé entre-temps.
+        template <typename Fn>
+        void publish(Fn&& fn) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& node : pending_) store_.insert(std::move(node));
+            pending_.clear();
+            fn(store_);
+        }
+
+        // Lecture sans verrou : réservée au thread moteur, seul écrivain du magasin
+        const MetricsMap& values() const { return store_; }
+
+        // Lecture cohérente sous verrou, sans copie (exporteurs) : fn(const MetricsMap&)
+        template <typename Fn>
+        void read(Fn&& fn) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fn(static_cast<const MetricsMap&>(store_));
+        }
+
+        // Descripteur d'une entrée du magasin (celui de la famille pour un membre).
+        // Uniquement depuis read() : le verrou doit déjà être tenu.
+        const MetricDescriptor* describeLocked(const std::string& name) const {
+            const Entry* entry = find(name);
+            return entry ? &entry->desc : nullptr;
+        }
+
+        // Copie cohérente pour les autres threads (GUI)
+        MetricsMap snapshot() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return store_;
+        }
+
+    private:
+        struct Entry {
+            MetricDescriptor desc;
+            IMonitor* owner;
+        };
+
+        mutable std::mutex mutex_;
+        std::map<std::string, Entry, std::less<>> entries_;
+        MetricsMap store_;
+        std::vector<MetricsMap::node_type> pending_; // Résolues hors du thread moteur, pas encore insérées
+
+        const Entry* find(const std::string& name) const {
+            auto it = entries_.find(name);
+            if (it != entries_.end()) return it->second.desc.family ? nullptr : &it->second;
+            // Familles : le préfixe le plus long l'emporte
+            const Entry* best = nullptr;
+            for (const auto& [prefix, entry] : entries_) {
+                if (!entry.desc.family || name.size() <= prefix.size()) continue;
+                if (name.compare(0, prefix.size(), prefix) != 0) continue;
+                if (!best || prefix.size() > best->desc.name.size()) best = &entry;
+            }
+            return best;
+        }
+    };
+
+}
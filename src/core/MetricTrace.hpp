@@ -0,0 +1,252 @@
+#pragma once
+#include "IMonitor.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <fstream>
+#include <chrono>
+
+namespace lsaa {
+
+    // --- FORMAT DE TRACE ---
+    // [MetricTraceHeader], i64 début de l'enregistrement (ns depuis l'epoch Unix, version 2),
+    // puis une suite d'enregistrements préfixés par un tag :
+    //   NAME : u32 id, u8 type, u16 longueur, nom        (première apparition d'une métrique)
+    //   TICK : u64 temps (ns depuis le début), u32 n, n x [u32 id, u8 kind, valeur]
+    // Un TICK ne contient que les valeurs qui ont changé depuis le tick précédent.
+    // Valeur : rien (monostate), i64, f64, ou u32 longueur + octets (texte).
+    // Un enregistrement tronqué (arrêt brutal pendant l'écriture) marque la fin de la trace.
+
+    struct MetricTraceHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;
+    };
+
+    static_assert(sizeof(MetricTraceHeader) == 16, "MetricTraceHeader layout must stay stable");
+
+    constexpr char kMetricTraceMagic[8] = {'L', 'S', 'A', 'A', 'T', 'R', 'C', 'E'};
+    constexpr uint32_t kMetricTraceVersion = 2; // 1 : sans heure de début
+    constexpr uint32_t kMetricTraceByteOrder = 0x01020304;
+
+    enum class TraceTag : uint8_t { NAME = 1, TICK = 2 };
+
+    struct TraceMetric {
+        std::string name;
+        MetricType type;
+    };
+
+    // Enregistre les métriques tick après tick (appelé par le thread moteur)
+    class MetricTraceWriter {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        bool open(const std::string& path) {
+            out_.open(path, std::ios::binary | std::ios::trunc);
+            if (!out_.is_open()) return false;
+            MetricTraceHeader header{};
+            std::memcpy(header.magic, kMetricTraceMagic, sizeof(header.magic));
+            header.version = kMetricTraceVersion;
+            header.byteOrder = kMetricTraceByteOrder;
+            out_.write((const char*)&header, sizeof(header));
+            int64_t startUnixNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            out_.write((const char*)&startUnixNs, sizeof(startUnixNs));
+            start_ = Clock::now();
+            return out_.good();
+        }
+
+        bool isOpen() const { return out_.is_open(); }
+
+        void writeTick(const MetricsMap& metrics) {
+            uint64_t time = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count();
+
+            tick_.clear();
+            uint32_t changed = 0;
+            for (const auto& [name, value] : metrics) {
+                auto [it, inserted] = known_.try_emplace(name, Known{(uint32_t)known_.size(), value});
+                if (inserted) {
+                    writeName(it->second.id, name, value);
+                } else if (it->second.last == value) {
+                    continue;
+                } else {
+                    it->second.last = value;
+                }
+                put(tick_, it->second.id);
+                writeValue(tick_, value);
+                changed++;
+            }
+
+            uint8_t tag = (uint8_t)TraceTag::TICK;
+            out_.write((const char*)&tag, 1);
+            out_.write((const char*)&time, sizeof(time));
+            out_.write((const char*)&changed, sizeof(changed));
+            out_.write(tick_.data(), (std::streamsize)tick_.size());
+            out_.flush(); // Trace exploitable même si l'agent est tué
+        }
+
+    private:
+        struct Known {
+            uint32_t id;
+            MetricValue last;
+        };
+
+        std::ofstream out_;
+        Clock::time_point start_;
+        std::unordered_map<std::string, Known> known_;
+        std::string tick_;
+
+        template <typename T>
+        static void put(std::string& buf, const T& v) { buf.append((const char*)&v, sizeof(T)); }
+
+        static uint8_t kindOf(const MetricValue& v) { return (uint8_t)v.index(); }
+
+        void writeName(uint32_t id, const std::string& name, const MetricValue& value) {
+            std::string rec;
+            put(rec, (uint8_t)TraceTag::NAME);
+            put(rec, id);
+            uint8_t type = (uint8_t)(std::holds_alternative<std::string>(value) ? MetricType::TEXT
+                                   : std::holds_alternative<double>(value) ? MetricType::REAL : MetricType::INTEGER);
+            put(rec, type);
+            put(rec, (uint16_t)std::min<size_t>(name.size(), UINT16_MAX));
+            rec.append(name, 0, UINT16_MAX);
+            out_.write(rec.data(), (std::streamsize)rec.size());
+        }
+
+        static void writeValue(std::string& buf, const MetricValue& value) {
+            put(buf, kindOf(value));
+            if (auto i = std::get_if<long long>(&value)) put(buf, (int64_t)*i);
+            else if (auto d = std::get_if<double>(&value)) put(buf, *d);
+            else if (auto s = std::get_if<std::string>(&value)) {
+                put(buf, (uint32_t)s->size());
+                buf += *s;
+            }
+        }
+    };
+
+    // Relit une trace depuis sa projection mémoire
+    class MetricTraceReader {
+    public:
+        // Valide l'en-tête et indexe les noms (un seul parcours, sans copier les valeurs)
+        bool open(const std::string& path) {
+            if (!file_.open(path) || file_.size() < sizeof(MetricTraceHeader)) return false;
+            MetricTraceHeader header;
+            std::memcpy(&header, file_.data(), sizeof(header));
+            if (std::memcmp(header.magic, kMetricTraceMagic, sizeof(header.magic)) != 0) return false;
+            if (header.version < 1 || header.version > kMetricTraceVersion || header.byteOrder != kMetricTraceByteOrder) return false;
+
+            dataStart_ = sizeof(MetricTraceHeader);
+            startUnixNs_ = 0;
+            if (header.version >= 2) {
+                pos_ = dataStart_;
+                if (!get(startUnixNs_)) return false;
+                dataStart_ = pos_;
+            }
+
+            metrics_.clear();
+            tickCount_ = 0;
+            pos_ = dataStart_;
+            uint64_t time = 0;
+            while (nextRecord(time, nullptr)) {}
+            end_ = pos_;
+            rewind();
+            return true;
+        }
+
+        const std::vector<TraceMetric>& metrics() const { return metrics_; }
+        size_t tickCount() const { return tickCount_; }
+
+        void rewind() { pos_ = dataStart_; }
+
+        // Début de l'enregistrement (ns depuis l'epoch Unix), 0 si inconnu (trace version 1)
+        int64_t startUnixNs() const { return startUnixNs_; }
+
+        // Avance jusqu'au prochain tick : onChange(id, MetricValue&&) pour chaque valeur modifiée
+        template <typename Fn>
+        bool next(uint64_t& timeNs, Fn&& onChange) {
+            while (pos_ < end_) {
+                if (nextRecord(timeNs, &onChange)) {
+                    if (lastWasTick_) return true;
+                } else {
+                    return false;
+                }
+            }
+            return false;
+        }
+
+    private:
+        MappedFile file_;
+        std::vector<TraceMetric> metrics_;
+        size_t tickCount_ = 0;
+        size_t pos_ = 0;
+        size_t dataStart_ = sizeof(MetricTraceHeader);
+        size_t end_ = 0;
+        int64_t startUnixNs_ = 0;
+        bool lastWasTick_ = false;
+
+        template <typename T>
+        bool get(T& v) {
+            if (file_.size() - pos_ < sizeof(T)) return false;
+            std::memcpy(&v, file_.data() + pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return true;
+        }
+
+        // Lit un enregistrement. Sans callback (indexation), les noms sont enregistrés et les valeurs sautées.
+        template <typename Fn>
+        bool nextRecord(uint64_t& timeNs, Fn* onChange) {
+            size_t start = pos_;
+            auto truncated = [&]() { pos_ = start; return false; };
+
+            uint8_t tag = 0;
+            if (!get(tag)) return truncated();
+            if (tag == (uint8_t)TraceTag::NAME) {
+                uint32_t id; uint8_t type; uint16_t len;
+                if (!get(id) || !get(type) || !get(len) || file_.size() - pos_ < len) return truncated();
+                if (!onChange) {
+                    if (id != metrics_.size() || type > (uint8_t)MetricType::TEXT) return truncated();
+                    metrics_.push_back({std::string(file_.data() + pos_, len), (MetricType)type});
+                }
+                pos_ += len;
+                lastWasTick_ = false;
+                return true;
+            }
+            if (tag != (uint8_t)TraceTag::TICK) return truncated();
+
+            uint32_t count;
+            if (!get(timeNs) || !get(count)) return truncated();
+            for (uint32_t i = 0; i < count; ++i) {
+                uint32_t id; uint8_t kind;
+                if (!get(id) || !get(kind)) return truncated();
+                if (!onChange && id >= metrics_.size()) return truncated();
+                MetricValue value;
+                switch (kind) {
+                    case 0: break;
+                    case 1: { int64_t v; if (!get(v)) return truncated(); value = (long long)v; break; }
+                    case 2: { double v; if (!get(v)) return truncated(); value = v; break; }
+                    case 3: {
+                        uint32_t len;
+                        if (!get(len) || file_.size() - pos_ < len) return truncated();
+                        if (onChange) value = std::string(file_.data() + pos_, len);
+                        pos_ += len;
+                        break;
+                    }
+                    default: return truncated();
+                }
+                if (onChange) (*onChange)(id, std::move(value));
+            }
+            if (!onChange) tickCount_++;
+            lastWasTick_ = true;
+            return true;
+        }
+
+        bool nextRecord(uint64_t& timeNs, std::nullptr_t) {
+            return nextRecord<void(uint32_t, MetricValue&&)>(timeNs, nullptr);
+        }
+    };
+
+}
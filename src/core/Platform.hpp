@@ -0,0 +1,11 @@
+#pragma once
+// Couche OS minimale : WinAPI sous Windows, types équivalents ailleurs
+// pour que les structures partagées (ProcessInfo, ...) restent portables.
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cstdint>
+#include <cstddef>
+typedef uint32_t DWORD;
+typedef size_t SIZE_T;
+#endif
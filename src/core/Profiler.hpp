@@ -0,0 +1,135 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace lsaa {
+
+    // Histogramme de latences façon HDR : 16 sous-intervalles linéaires par puissance de 2
+    // (erreur relative < 6.25 %), de 1 ns à ~36 min. record() est un simple fetch_add relâché :
+    // aucun verrou, utilisable depuis n'importe quel thread.
+    class LatencyHistogram {
+    public:
+        static constexpr int kSubBits = 4;
+        static constexpr int kSub = 1 << kSubBits;
+        static constexpr int kMaxBits = 41;
+        static constexpr size_t kBuckets = (size_t)(kMaxBits - kSubBits + 1) * kSub;
+
+        struct Snapshot {
+            std::array<uint64_t, kBuckets> counts{};
+            uint64_t total = 0;
+
+            // Valeur (ns) du quantile q dans [0, 1] ; 0 si aucun échantillon
+            double percentile(double q) const {
+                if (total == 0) return 0.0;
+                uint64_t rank = (uint64_t)(q * (double)(total - 1)) + 1;
+                uint64_t seen = 0;
+                for (size_t i = 0; i < kBuckets; ++i) {
+                    seen += counts[i];
+                    if (seen >= rank) return midpoint(i);
+                }
+                return midpoint(kBuckets - 1);
+            }
+
+            Snapshot since(const Snapshot& earlier) const {
+                Snapshot d;
+                for (size_t i = 0; i < kBuckets; ++i) d.counts[i] = counts[i] - earlier.counts[i];
+                d.total = total - earlier.total;
+                return d;
+            }
+        };
+
+        void record(uint64_t ns) {
+            counts_[index(ns)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Snapshot snapshot() const {
+            Snapshot s;
+            for (size_t i = 0; i < kBuckets; ++i) {
+                s.counts[i] = counts_[i].load(std::memory_order_relaxed);
+                s.total += s.counts[i];
+            }
+            return s;
+        }
+
+        static size_t index(uint64_t ns) {
+            if (ns < (uint64_t)2 * kSub) return (size_t)ns;
+            int msb = std::bit_width(ns) - 1;
+            if (msb >= kMaxBits) return kBuckets - 1;
+            int shift = msb - kSubBits;
+            return (size_t)(shift + 1) * kSub + (size_t)((ns >> shift) & (kSub - 1));
+        }
+
+        static double lowerBound(size_t i) {
+            if (i < (size_t)2 * kSub) return (double)i;
+            int shift = (int)(i / kSub) - 1;
+            return (double)((uint64_t)(kSub + i % kSub) << shift);
+        }
+
+        static double midpoint(size_t i) {
+            if (i < (size_t)2 * kSub) return (double)i;
+            int shift = (int)(i / kSub) - 1;
+            return lowerBound(i) + (double)(1ull << shift) / 2.0;
+        }
+
+    private:
+        std::array<std::atomic<uint64_t>, kBuckets> counts_{};
+    };
+
+    // Mesure la durée de sa portée
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(LatencyHistogram& histogram)
+            : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            histogram_.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        LatencyHistogram& histogram_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    // Histogrammes nommés de l'agent ("tick", "evaluate", "action", "collect.<Moniteur>").
+    // Les références rendues par histogram() restent valides : à récupérer une fois, hors du chemin chaud.
+    class Profiler {
+    public:
+        static Profiler& instance() {
+            static Profiler instance;
+            return instance;
+        }
+
+        LatencyHistogram& histogram(const std::string& name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& slot = histograms_[name];
+            if (!slot) slot = std::make_unique<LatencyHistogram>();
+            return *slot;
+        }
+
+        bool has(const std::string& name) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return histograms_.count(name) != 0;
+        }
+
+        template <typename Fn>
+        void forEach(Fn&& fn) const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, histogram] : histograms_) fn(name, *histogram);
+        }
+
+    private:
+        Profiler() = default;
+        mutable std::mutex mutex_;
+        std::map<std::string, std::unique_ptr<LatencyHistogram>> histograms_;
+    };
+
+}
@@ -0,0 +1,356 @@
+#pragma once
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "MetricRegistry.hpp"
+#include "Logger.hpp"
+
+namespace lsaa {
+
+    // Exposition des métriques du registre pour Prometheus :
+    //  - serve() : écoute HTTP locale, GET /metrics (OpenMetrics si le client l'accepte, sinon texte 0.0.4)
+    //  - startTextfile() : fichier .prom réécrit atomiquement pour le textfile collector de node_exporter
+    //
+    // Le corps est rendu directement depuis le magasin du registre (sous son verrou, sans copie)
+    // dans un tampon réutilisé. Les noms prennent le préfixe "lsaa_" ; un membre de famille devient
+    // un label ("cgroup_oom_kills_total.web" -> lsaa_cgroup_oom_kills_total{cgroup="web"}), au plus
+    // maxSeriesPerFamily par famille (les suivants sont comptés dans lsaa_exporter_dropped_series).
+    // Les totaux cumulés (MetricDescriptor::counter, noms en "_total") sont de type counter, le
+    // reste des valeurs numériques des jauges.
+    class PrometheusExporter {
+    public:
+        enum class Format { OPENMETRICS, PROMETHEUS_TEXT };
+
+        explicit PrometheusExporter(MetricRegistry& registry, size_t maxSeriesPerFamily = 100)
+            : registry_(registry), maxSeriesPerFamily_(maxSeriesPerFamily) {}
+
+        ~PrometheusExporter() { stop(); }
+
+        PrometheusExporter(const PrometheusExporter&) = delete;
+        PrometheusExporter& operator=(const PrometheusExporter&) = delete;
+
+        // Corps complet ; la référence reste valide jusqu'au rendu suivant (même thread)
+        const std::string& render(Format format) {
+            std::lock_guard<std::mutex> lock(renderMutex_);
+            renderLocked(format);
+            return body_;
+        }
+
+        // Ecoute sur address:port (127.0.0.1 par défaut : pas d'exposition réseau involontaire)
+        bool serve(int port, const std::string& address = "127.0.0.1") {
+            if (listener_ != kInvalidSocket) return false;
+#ifdef _WIN32
+            WSADATA wsa;
+            if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+            wsaStarted_ = true;
+#endif
+            listener_ = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (listener_ == kInvalidSocket) return false;
+
+            int yes = 1;
+            setsockopt(listener_, SOL_SOCKET, SO_REUSEADDR, (const char*)&yes, sizeof(yes));
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons((unsigned short)port);
+            if (inet_pton(AF_INET, address.c_str(), &addr.sin_addr) != 1 ||
+                ::bind(listener_, (const sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(listener_, 8) != 0) {
+                LSAA_LOG_ERROR("PrometheusExporter: cannot listen on " + address + ":" + std::to_string(port));
+                closeSocket(listener_);
+                listener_ = kInvalidSocket;
+                return false;
+            }
+
+            running_ = true;
+            server_ = std::thread([this]() { serverLoop(); });
+            LSAA_LOG_INFO("Metrics exposed on http://" + address + ":" + std::to_string(port) + "/metrics");
+            return true;
+        }
+
+        // Réécrit `path` toutes les `interval` (écriture dans path.tmp puis renommage)
+        void startTextfile(const std::string& path, std::chrono::seconds interval) {
+            if (textfile_.joinable()) return;
+            running_ = true;
+            textfile_ = std::thread([this, path, interval]() {
+                std::unique_lock<std::mutex> lock(waitMutex_);
+                while (running_) {
+                    lock.unlock();
+                    if (!writeTextfile(path)) LSAA_LOG_WARN("PrometheusExporter: cannot write " + path);
+                    lock.lock();
+                    wake_.wait_for(lock, interval, [this]() { return !running_; });
+                }
+            });
+            LSAA_LOG_INFO("Metrics written to " + path);
+        }
+
+        bool writeTextfile(const std::string& path) {
+            std::lock_guard<std::mutex> lock(renderMutex_);
+            renderLocked(Format::PROMETHEUS_TEXT);
+            std::string tmp = path + ".tmp";
+            FILE* f = std::fopen(tmp.c_str(), "wb");
+            if (!f) return false;
+            bool ok = std::fwrite(body_.data(), 1, body_.size(), f) == body_.size();
+            ok = std::fclose(f) == 0 && ok;
+            std::error_code ec;
+            if (ok) std::filesystem::rename(tmp, path, ec);
+            if (!ok || ec) {
+                std::filesystem::remove(tmp, ec);
+                return false;
+            }
+            return true;
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(waitMutex_);
+                running_ = false;
+            }
+            wake_.notify_all();
+            if (server_.joinable()) server_.join();
+            if (textfile_.joinable()) textfile_.join();
+            if (listener_ != kInvalidSocket) {
+                closeSocket(listener_);
+                listener_ = kInvalidSocket;
+            }
+#ifdef _WIN32
+            if (wsaStarted_) WSACleanup();
+            wsaStarted_ = false;
+#endif
+        }
+
+    private:
+#ifdef _WIN32
+        using Socket = SOCKET;
+        static constexpr Socket kInvalidSocket = INVALID_SOCKET;
+        static void closeSocket(Socket s) { closesocket(s); }
+        bool wsaStarted_ = false;
+#else
+        using Socket = int;
+        static constexpr Socket kInvalidSocket = -1;
+        static void closeSocket(Socket s) { ::close(s); }
+#endif
+
+        // Série exportée : pointe vers le noeud stable du magasin
+        struct Series {
+            std::string label;              // Valeur du label (vide hors famille)
+            const MetricValue* value;
+        };
+
+        struct Family {
+            std::string name;               // Nom Prometheus
+            std::string labelName;
+            MetricType type;
+            bool counter;
+            std::vector<Series> series;
+        };
+
+        MetricRegistry& registry_;
+        size_t maxSeriesPerFamily_;
+
+        std::mutex renderMutex_;
+        std::string body_;
+        std::vector<Family> families_;
+        size_t cachedEntries_ = (size_t)-1;
+        size_t droppedSeries_ = 0;
+
+        std::atomic<bool> running_{false};
+        std::mutex waitMutex_;
+        std::condition_variable wake_;
+        Socket listener_ = kInvalidSocket;
+        std::thread server_;
+        std::thread textfile_;
+
+        void renderLocked(Format format) {
+            body_.clear();
+            registry_.read([&](const MetricsMap& store) {
+                // Les entrées ne sont jamais retirées : une taille inchangée = mêmes séries
+                if (store.size() != cachedEntries_) rebuild(store);
+                for (const auto& family : families_) appendFamily(family, format);
+            });
+
+            body_ += "# TYPE lsaa_exporter_dropped_series gauge\nlsaa_exporter_dropped_series ";
+            appendNumber((double)droppedSeries_);
+            body_ += '\n';
+            if (format == Format::OPENMETRICS) body_ += "# EOF\n";
+        }
+
+        // Appelé sous le verrou du registre (registry_.read)
+        void rebuild(const MetricsMap& store) {
+            families_.clear();
+            droppedSeries_ = 0;
+            std::map<std::string, size_t> index;
+            for (const auto& [key, value] : store) {
+                const MetricDescriptor* desc = registry_.describeLocked(key);
+                if (!desc) continue;
+                std::string label = desc->family ? key.substr(desc->name.size()) : std::string();
+
+                auto [it, inserted] = index.try_emplace(desc->name, families_.size());
+                if (inserted) {
+                    families_.push_back({promName(desc->name), desc->label.empty() ? "key" : desc->label, desc->type, desc->counter, {}});
+                }
+                Family& family = families_[it->second];
+                if (desc->family && family.series.size() >= maxSeriesPerFamily_) {
+                    droppedSeries_++;
+                    continue;
+                }
+                family.series.push_back({std::move(label), &value});
+            }
+            cachedEntries_ = store.size();
+        }
+
+        void appendFamily(const Family& family, Format format) {
+            bool text = family.type == MetricType::TEXT;
+            bool counter = family.counter && !text;
+            body_ += "# TYPE ";
+            // OpenMetrics : le counter est déclaré sans son suffixe "_total", porté par la série
+            std::string_view typeName = family.name;
+            if (counter && format == Format::OPENMETRICS && typeName.ends_with("_total")) typeName.remove_suffix(6);
+            body_ += typeName;
+            // Texte : série "info" (OpenMetrics) ou jauge à 1 (format 0.0.4), la valeur en label
+            if (text && format == Format::PROMETHEUS_TEXT) body_ += "_info";
+            if (text) body_ += format == Format::OPENMETRICS ? " info\n" : " gauge\n";
+            else body_ += counter ? " counter\n" : " gauge\n";
+
+            for (const auto& s : family.series) {
+                const std::string* str = std::get_if<std::string>(s.value);
+                double number = 0.0;
+                if (text ? !str : !metricAsDouble(*s.value, number)) continue; // Pas encore de valeur
+
+                body_ += family.name;
+                if (text) body_ += "_info";
+                bool labels = !s.label.empty() || text;
+                if (labels) body_ += '{';
+                if (!s.label.empty()) appendLabel(family.labelName, s.label);
+                if (text) {
+                    if (!s.label.empty()) body_ += ',';
+                    appendLabel("value", *str);
+                }
+                if (labels) body_ += '}';
+                body_ += ' ';
+                if (text) body_ += '1';
+                else appendNumber(number);
+                body_ += '\n';
+            }
+        }
+
+        void appendLabel(std::string_view name, std::string_view value) {
+            body_ += name;
+            body_ += "=\"";
+            for (char c : value) {
+                if (c == '\\') body_ += "\\\\";
+                else if (c == '"') body_ += "\\\"";
+                else if (c == '\n') body_ += "\\n";
+                else body_ += c;
+            }
+            body_ += '"';
+        }
+
+        void appendNumber(double v) {
+            if (std::isnan(v)) { body_ += "NaN"; return; }
+            if (std::isinf(v)) { body_ += v > 0 ? "+Inf" : "-Inf"; return; }
+            char buf[32];
+            auto res = std::to_chars(buf, buf + sizeof(buf), v);
+            body_.append(buf, res.ptr);
+        }
+
+        static std::string promName(const std::string& metric) {
+            std::string name = metric.compare(0, 5, "lsaa_") == 0 ? metric : "lsaa_" + metric;
+            if (!name.empty() && name.back() == '.') name.pop_back();
+            for (char& c : name) {
+                bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == ':';
+                if (!ok) c = '_';
+            }
+            return name;
+        }
+
+        // --- HTTP ---
+
+        void serverLoop() {
+            while (running_) {
+                fd_set readable;
+                FD_ZERO(&readable);
+                FD_SET(listener_, &readable);
+                timeval timeout{0, 200 * 1000};
+                if (select((int)listener_ + 1, &readable, nullptr, nullptr, &timeout) <= 0) continue;
+
+                Socket client = ::accept(listener_, nullptr, nullptr);
+                if (client == kInvalidSocket) continue;
+                handle(client);
+                closeSocket(client);
+            }
+        }
+
+        void handle(Socket client) {
+#ifdef _WIN32
+            DWORD recvTimeout = 2000;
+#else
+            timeval recvTimeout{2, 0};
+#endif
+            setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, (const char*)&recvTimeout, sizeof(recvTimeout));
+
+            // En-têtes seulement (GET sans corps)
+            char request[4096];
+            size_t size = 0;
+            while (size < sizeof(request) - 1) {
+                int n = (int)::recv(client, request + size, (int)(sizeof(request) - 1 - size), 0);
+                if (n <= 0) break;
+                size += (size_t)n;
+                request[size] = '\0';
+                if (std::strstr(request, "\r\n\r\n")) break;
+            }
+            std::string_view req(request, size);
+
+            if (req.compare(0, 13, "GET /metrics ") != 0 && req.compare(0, 13, "GET /metrics?") != 0) {
+                sendAll(client, "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                return;
+            }
+
+            Format format = req.find("application/openmetrics-text") != std::string_view::npos
+                ? Format::OPENMETRICS : Format::PROMETHEUS_TEXT;
+
+            std::lock_guard<std::mutex> lock(renderMutex_);
+            renderLocked(format);
+            std::string header = "HTTP/1.1 200 OK\r\nContent-Type: ";
+            header += format == Format::OPENMETRICS
+                ? "application/openmetrics-text; version=1.0.0; charset=utf-8"
+                : "text/plain; version=0.0.4; charset=utf-8";
+            header += "\r\nContent-Length: " + std::to_string(body_.size()) + "\r\nConnection: close\r\n\r\n";
+            if (sendAll(client, header)) sendAll(client, body_);
+        }
+
+        static bool sendAll(Socket s, std::string_view data) {
+#ifdef MSG_NOSIGNAL
+            const int flags = MSG_NOSIGNAL;
+#else
+            const int flags = 0;
+#endif
+            while (!data.empty()) {
+                int n = (int)::send(s, data.data(), (int)data.size(), flags);
+                if (n <= 0) return false;
+                data.remove_prefix((size_t)n);
+            }
+            return true;
+        }
+    };
+
+}
@@ -0,0 +1,284 @@
+#pragma once
+#include "RuleConfig.hpp"
+#include "MappedFile.hpp"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <memory>
+#include <fstream>
+#include <filesystem>
+#include <system_error>
+
+namespace lsaa {
+
+    // FNV-1a 64 bits : clé du cache (contenu exact de rules.json)
+    inline uint64_t hashBytes(const char* data, size_t size) {
+        uint64_t h = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < size; ++i) {
+            h ^= (unsigned char)data[i];
+            h *= 0x100000001b3ull;
+        }
+        return h;
+    }
+
+    // --- FORMAT BINAIRE ---
+    // [RuleCacheHeader][RuleCacheRecord x ruleCount][table de chaînes]
+    // Tous les offsets sont relatifs au début du fichier : le format est relogeable et
+    // utilisable tel quel depuis la projection mémoire.
+
+    struct RuleCacheString {
+        uint32_t offset; // Relatif au début de la table de chaînes
+        uint32_t length;
+    };
+
+    struct RuleCacheRecord {
+        RuleCacheString name;
+        RuleCacheString metric;
+        RuleCacheString oper;
+        RuleCacheString actionType;
+        RuleCacheString actionParam;
+        double threshold;
+        uint8_t enabled;
+        uint8_t reserved[7];
+    };
+
+    struct RuleCacheHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t byteOrder;   // 0x01020304 dans l'ordre natif de la machine qui a écrit
+        uint64_t sourceHash;
+        uint64_t sourceSize;
+        uint64_t ruleCount;
+        uint64_t recordsOffset;
+        uint64_t stringsOffset;
+        uint64_t stringsSize;
+    };
+
+    static_assert(sizeof(RuleCacheRecord) == 56, "RuleCacheRecord layout must stay stable");
+    static_assert(sizeof(RuleCacheHeader) == 64, "RuleCacheHeader layout must stay stable");
+
+    constexpr char kRuleCacheMagic[8] = {'L', 'S', 'A', 'A', 'R', 'U', 'L', 'E'};
+    constexpr uint32_t kRuleCacheVersion = 1;
+    constexpr uint32_t kRuleCacheByteOrder = 0x01020304;
+
+    // Jeu de règles compilé, lu directement dans le fichier projeté
+    class CompiledRuleSet {
+    public:
+        // nullptr si le fichier est absent, corrompu ou d'une autre version / architecture
+        static std::shared_ptr<CompiledRuleSet> open(const std::string& path) {
+            auto set = std::shared_ptr<CompiledRuleSet>(new CompiledRuleSet());
+            if (!set->file_.open(path) || !set->validate()) return nullptr;
+            return set;
+        }
+
+        bool matches(uint64_t sourceHash, uint64_t sourceSize) const {
+            return header().sourceHash == sourceHash && header().sourceSize == sourceSize;
+        }
+
+        size_t size() const { return (size_t)header().ruleCount; }
+
+        RuleView at(size_t i) const {
+            const RuleCacheRecord& r = records()[i];
+            return {str(r.name), str(r.metric), str(r.oper), r.threshold, r.enabled != 0,
+                    str(r.actionType), str(r.actionParam)};
+        }
+
+    private:
+        CompiledRuleSet() = default;
+        MappedFile file_;
+
+        const RuleCacheHeader& header() const { return *(const RuleCacheHeader*)file_.data(); }
+        const RuleCacheRecord* records() const { return (const RuleCacheRecord*)(file_.data() + header().recordsOffset); }
+        const char* strings() const { return file_.data() + header().stringsOffset; }
+
+        std::string_view str(const RuleCacheString& s) const { return std::string_view(strings() + s.offset, s.length); }
+
+        // Vérifie les bornes une fois à l'ouverture : ensuite les accès sont directs
+        bool validate() const {
+            if (file_.size() < sizeof(RuleCacheHeader)) return false;
+            const auto& h = header();
+            if (std::memcmp(h.magic, kRuleCacheMagic, sizeof(h.magic)) != 0) return false;
+            if (h.version != kRuleCacheVersion || h.byteOrder != kRuleCacheByteOrder) return false;
+            if (h.recordsOffset % alignof(RuleCacheRecord) != 0) return false;
+            if (h.recordsOffset > file_.size() || h.ruleCount > (file_.size() - h.recordsOffset) / sizeof(RuleCacheRecord)) return false;
+            if (h.stringsOffset > file_.size() || h.stringsSize > file_.size() - h.stringsOffset) return false;
+
+            auto inBounds = [&](const RuleCacheString& s) { return (uint64_t)s.offset + s.length <= h.stringsSize; };
+            const RuleCacheRecord* recs = records();
+            for (uint64_t i = 0; i < h.ruleCount; ++i) {
+                const auto& r = recs[i];
+                if (!inBounds(r.name) || !inBounds(r.metric) || !inBounds(r.oper) ||
+                    !inBounds(r.actionType) || !inBounds(r.actionParam)) return false;
+            }
+            return true;
+        }
+    };
+
+    // Ecrit le cache à côté de la source (fichier temporaire puis renommage atomique)
+    inline bool writeRuleCache(const std::string& path, uint64_t sourceHash, uint64_t sourceSize,
+                               const std::vector<RuleConfig>& rules) {
+        std::string strings;
+        std::vector<RuleCacheRecord> records;
+        records.reserve(rules.size());
+
+        auto intern = [&strings](const std::string& s) {
+            RuleCacheString ref{(uint32_t)strings.size(), (uint32_t)s.size()};
+            strings += s;
+            return ref;
+        };
+
+        for (const auto& r : rules) {
+            RuleCacheRecord rec{};
+            rec.name = intern(r.name);
+            rec.metric = intern(r.metric);
+            rec.oper = intern(r.oper);
+            rec.actionType = intern(r.actionType);
+            rec.actionParam = intern(r.actionParam);
+            rec.threshold = r.threshold;
+            rec.enabled = r.enabled ? 1 : 0;
+            records.push_back(rec);
+        }
+        if (strings.size() > UINT32_MAX) return false;
+
+        RuleCacheHeader header{};
+        std::memcpy(header.magic, kRuleCacheMagic, sizeof(header.magic));
+        header.version = kRuleCacheVersion;
+        header.byteOrder = kRuleCacheByteOrder;
+        header.sourceHash = sourceHash;
+        header.sourceSize = sourceSize;
+        header.ruleCount = records.size();
+        header.recordsOffset = sizeof(RuleCacheHeader);
+        header.stringsOffset = header.recordsOffset + records.size() * sizeof(RuleCacheRecord);
+        header.stringsSize = strings.size();
+
+        std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) return false;
+            out.write((const char*)&header, sizeof(header));
+            out.write((const char*)records.data(), (std::streamsize)(records.size() * sizeof(RuleCacheRecord)));
+            out.write(strings.data(), (std::streamsize)strings.size());
+            if (!out.good()) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmpPath, path, ec);
+        if (ec) std::filesystem::remove(tmpPath, ec);
+        return !ec;
+    }
+
+    // --- PARSEUR SAX (cas à froid) ---
+    // Construit les RuleConfig au fil des tokens, sans DOM nlohmann::json intermédiaire.
+    class RuleSaxHandler : public nlohmann::json_sax<json> {
+    public:
+        explicit RuleSaxHandler(std::vector<RuleConfig>& out) : out_(out) {}
+
+        std::string error;
+
+        bool null() override { return scalarError("null"); }
+        bool boolean(bool val) override {
+            if (!inField()) return skipScalar();
+            if (field_ != Field::ENABLED) return typeError();
+            current_.enabled = val;
+            return seen();
+        }
+        bool number_integer(number_integer_t val) override { return number((double)val); }
+        bool number_unsigned(number_unsigned_t val) override { return number((double)val); }
+        bool number_float(number_float_t val, const string_t&) override { return number(val); }
+        bool string(string_t& val) override {
+            if (!inField()) return skipScalar();
+            std::string* dst = nullptr;
+            switch (field_) {
+                case Field::NAME:         dst = &current_.name; break;
+                case Field::METRIC:       dst = &current_.metric; break;
+                case Field::OPER:         dst = &current_.oper; break;
+                case Field::ACTION_TYPE:  dst = &current_.actionType; break;
+                case Field::ACTION_PARAM: dst = &current_.actionParam; break;
+                default: return typeError();
+            }
+            *dst = std::move(val);
+            return seen();
+        }
+        bool binary(binary_t&) override { return scalarError("binary"); }
+
+        bool start_object(std::size_t) override {
+            if (depth_ == 1 && skipDepth_ == 0) {
+                current_ = RuleConfig{};
+                seenMask_ = 0;
+            } else if (depth_ >= 2) {
+                skipDepth_++; // Objet imbriqué inconnu : ignoré
+            } else {
+                return fail("expected an array of rules");
+            }
+            depth_++;
+            return true;
+        }
+        bool end_object() override {
+            depth_--;
+            if (skipDepth_ > 0) { skipDepth_--; field_ = Field::NONE; return true; }
+            if (seenMask_ != kAllFields) return fail("rule #" + std::to_string(out_.size()) + " is missing fields");
+            out_.push_back(std::move(current_));
+            return true;
+        }
+        bool start_array(std::size_t) override {
+            if (depth_ == 0) { depth_++; return true; }
+            if (depth_ < 2) return fail("unexpected nested array");
+            skipDepth_++;
+            depth_++;
+            return true;
+        }
+        bool end_array() override {
+            depth_--;
+            if (skipDepth_ > 0) { skipDepth_--; field_ = Field::NONE; }
+            return true;
+        }
+        bool key(string_t& val) override {
+            if (skipDepth_ > 0) return true;
+            if (val == "name") field_ = Field::NAME;
+            else if (val == "metric") field_ = Field::METRIC;
+            else if (val == "oper") field_ = Field::OPER;
+            else if (val == "threshold") field_ = Field::THRESHOLD;
+            else if (val == "enabled") field_ = Field::ENABLED;
+            else if (val == "actionType") field_ = Field::ACTION_TYPE;
+            else if (val == "actionParam") field_ = Field::ACTION_PARAM;
+            else field_ = Field::UNKNOWN;
+            return true;
+        }
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) override {
+            if (error.empty()) error = std::string(ex.what()) + " (offset " + std::to_string(position) + ")";
+            return false;
+        }
+
+    private:
+        enum class Field { NONE, UNKNOWN, NAME, METRIC, OPER, THRESHOLD, ENABLED, ACTION_TYPE, ACTION_PARAM };
+        static constexpr unsigned kAllFields = 0x7f;
+
+        std::vector<RuleConfig>& out_;
+        RuleConfig current_{};
+        Field field_ = Field::NONE;
+        unsigned seenMask_ = 0;
+        int depth_ = 0;
+        int skipDepth_ = 0;
+
+        bool inField() const { return skipDepth_ == 0 && depth_ == 2 && field_ != Field::NONE && field_ != Field::UNKNOWN; }
+        bool skipScalar() { if (skipDepth_ == 0) field_ = Field::NONE; return depth_ >= 2 || fail("expected an array of rules"); }
+        bool seen() { seenMask_ |= 1u << ((int)field_ - (int)Field::NAME); field_ = Field::NONE; return true; }
+        bool number(double val) {
+            if (!inField()) return skipScalar();
+            if (field_ != Field::THRESHOLD) return typeError();
+            current_.threshold = val;
+            return seen();
+        }
+        bool scalarError(const char* what) { return inField() ? fail(std::string("unexpected ") + what) : skipScalar(); }
+        bool typeError() { return fail("rule #" + std::to_string(out_.size()) + ": wrong type for a field"); }
+        bool fail(const std::string& msg) { if (error.empty()) error = msg; return false; }
+    };
+
+    inline bool parseRulesSax(const char* begin, const char* end, std::vector<RuleConfig>& out, std::string& error) {
+        out.clear();
+        RuleSaxHandler handler(out);
+        bool ok = json::sax_parse(begin, end, &handler);
+        if (!ok) error = handler.error.empty() ? "invalid JSON" : handler.error;
+        return ok;
+    }
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace lsaa {
+
+    struct RuleConfig {
+        std::string name;
+        std::string metric;     // e.g., "cpu_usage_percent"
+        std::string oper;       // e.g., ">"
+        double threshold;
+        bool enabled;
+        std::string actionType; // "LOG", "NOTIFY", "KILL"
+        std::string actionParam; // message or target
+    };
+
+    // JSON Serialization for RuleConfig
+    NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE(RuleConfig, name, metric, oper, threshold, enabled, actionType, actionParam)
+
+    // Vue non-propriétaire d'une règle : pointe soit dans un RuleConfig, soit directement
+    // dans le cache binaire projeté en mémoire (aucune copie de chaîne).
+    struct RuleView {
+        std::string_view name;
+        std::string_view metric;
+        std::string_view oper;
+        double threshold;
+        bool enabled;
+        std::string_view actionType;
+        std::string_view actionParam;
+
+        static RuleView of(const RuleConfig& r) {
+            return {r.name, r.metric, r.oper, r.threshold, r.enabled, r.actionType, r.actionParam};
+        }
+
+        RuleConfig toConfig() const {
+            return {std::string(name), std::string(metric), std::string(oper), threshold, enabled,
+                    std::string(actionType), std::string(actionParam)};
+        }
+    };
+
+    // Empreinte d'une règle : identique tant que la définition ne change pas. Le seuil est écrit
+    // au plus court aller-retour exact (to_chars) : 90 et 90.0000001 donnent deux clés différentes.
+    inline std::string ruleDefinitionKey(const RuleView& r) {
+        char threshold[32];
+        auto end = std::to_chars(threshold, threshold + sizeof(threshold), r.threshold).ptr;
+        std::ostringstream ss;
+        ss << r.name << '\x1f' << r.metric << '\x1f' << r.oper << '\x1f' << std::string_view(threshold, (size_t)(end - threshold))
+           << '\x1f' << r.enabled << '\x1f' << r.actionType << '\x1f' << r.actionParam;
+        return ss.str();
+    }
+
+    inline std::string ruleDefinitionKey(const RuleConfig& r) {
+        return ruleDefinitionKey(RuleView::of(r));
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace lsaa {
+
+    // Arène monotone d'un tick du moteur (std::pmr) : les temporaires des moniteurs et du moteur
+    // de règles y sont alloués, puis tout est libéré d'un coup à la fin du tick. Le tampon est
+    // réutilisé d'un tick à l'autre ; s'il a débordé (repli sur le tas), il est agrandi au reset
+    // suivant, si bien qu'en régime établi un tick n'alloue plus rien.
+    //
+    // Rien de ce qui est alloué dans l'arène ne doit survivre au tick (variables locales seulement).
+    class TickArena : public std::pmr::memory_resource {
+    public:
+        static constexpr size_t kInitialBytes = 64 * 1024;
+
+        explicit TickArena(size_t bytes = kInitialBytes) { allocateBuffer(bytes); }
+
+        TickArena(const TickArena&) = delete;
+        TickArena& operator=(const TickArena&) = delete;
+
+        // Libère tout ce qui a été alloué pendant le tick (thread moteur)
+        void reset() {
+            lastTickBytes_ = used_;
+            used_ = 0;
+            if (upstream_.overflow == 0) {
+                arena_->release();
+                return;
+            }
+            // Débordement : nouveau tampon assez grand pour ce tick, avec de la marge
+            size_t bytes = capacity_ * 2;
+            while (bytes < lastTickBytes_ * 2) bytes *= 2;
+            allocateBuffer(bytes);
+        }
+
+        size_t capacity() const { return capacity_; }
+        size_t lastTickBytes() const { return lastTickBytes_; }
+
+        // Arène du tick en cours sur ce thread, ou le tas hors d'un tick : utilisable partout
+        static std::pmr::memory_resource* current() {
+            return active_ ? static_cast<std::pmr::memory_resource*>(active_) : std::pmr::get_default_resource();
+        }
+
+        // Arène du tick en cours sur ce thread (nullptr hors d'un tick)
+        static TickArena* active() { return active_; }
+
+        // Durée d'un tick : rend l'arène courante sur ce thread, puis la remet à zéro
+        class Scope {
+        public:
+            explicit Scope(TickArena& arena) : arena_(arena), previous_(active_) { active_ = &arena; }
+            ~Scope() {
+                active_ = previous_;
+                arena_.reset();
+            }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            TickArena& arena_;
+            TickArena* previous_;
+        };
+
+    protected:
+        void* do_allocate(size_t bytes, size_t alignment) override {
+            used_ += bytes;
+            return arena_->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void*, size_t, size_t) override {} // Monotone : libéré par reset()
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    private:
+        // Repli sur le tas quand le tampon est plein ; compte ce qui a débordé
+        struct Upstream : std::pmr::memory_resource {
+            size_t overflow = 0;
+
+            void* do_allocate(size_t bytes, size_t alignment) override {
+                overflow += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+            void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+            bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+        };
+
+        static inline thread_local TickArena* active_ = nullptr;
+
+        Upstream upstream_;
+        std::unique_ptr<std::byte[]> buffer_;
+        size_t capacity_ = 0;
+        std::optional<std::pmr::monotonic_buffer_resource> arena_;
+        size_t used_ = 0;
+        size_t lastTickBytes_ = 0;
+
+        void allocateBuffer(size_t bytes) {
+            arena_.reset(); // Rend les blocs débordés au tas avant de remplacer le tampon
+            upstream_.overflow = 0;
+            buffer_ = std::make_unique_for_overwrite<std::byte[]>(bytes);
+            capacity_ = bytes;
+            arena_.emplace(buffer_.get(), capacity_, &upstream_);
+        }
+    };
+
+}
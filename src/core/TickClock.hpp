@@ -0,0 +1,45 @@
+#pragma once
+#include <chrono>
+
+namespace lsaa {
+
+    // Instant du tick en cours sur ce thread, en secondes (origine arbitraire), et son heure
+    // murale. Le moteur les fixe après la collecte : steady_clock et system_clock en direct,
+    // horodatage de la trace dans lsaa-replay, si bien que les conditions qui datent leurs
+    // échantillons (prévisions, créneaux saisonniers) suivent le temps de la trace quelle que
+    // soit la vitesse de rejeu. Hors d'un tick, les horloges du système.
+    class TickClock {
+    public:
+        using WallClock = std::chrono::system_clock;
+
+        struct Instant {
+            double seconds;
+            WallClock::time_point wall;
+        };
+
+        static double now() { return active_ ? active_->seconds : steadySeconds(); }
+
+        static WallClock::time_point wallNow() { return active_ ? active_->wall : WallClock::now(); }
+
+        static double steadySeconds() {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Durée de l'évaluation d'un tick : fixe l'instant vu par now() et wallNow() sur ce thread
+        class Scope {
+        public:
+            Scope(double seconds, WallClock::time_point wall) : instant_{seconds, wall}, previous_(active_) { active_ = &instant_; }
+            ~Scope() { active_ = previous_; }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Instant instant_;
+            const Instant* previous_;
+        };
+
+    private:
+        static inline thread_local const Instant* active_ = nullptr;
+    };
+
+}
@@ -0,0 +1,212 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace lsaa {
+
+    // Traceur d'activité (ticks, collectes, règles, actions, écritures du log) au format
+    // Chrome trace-event JSON, lisible dans chrome://tracing ou https://ui.perfetto.dev.
+    //
+    // Chaque thread écrit dans son propre tampon circulaire (un seul écrivain, aucun verrou) ;
+    // les plus anciens événements sont écrasés. Les noms doivent rester valides jusqu'au
+    // dump : littéraux, ou chaînes passées par intern().
+    //
+    // Les macros LSAA_TRACE_* ne génèrent du code que si LSAA_ENABLE_TRACING est défini
+    // (option CMake du même nom) ; sinon le coût est nul.
+    class Tracer {
+    public:
+        static constexpr size_t kEventsPerThread = size_t(1) << 16;
+
+        enum class Phase : char { BEGIN = 'B', END = 'E', INSTANT = 'i' };
+
+        static Tracer& instance() {
+            static Tracer instance;
+            return instance;
+        }
+
+        Tracer(const Tracer&) = delete;
+        void operator=(const Tracer&) = delete;
+
+        void start() { enabled_.store(true, std::memory_order_relaxed); }
+        void stop() { enabled_.store(false, std::memory_order_relaxed); }
+        bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+        // Copie stable d'un nom dynamique (règle, moniteur...). Hors du chemin chaud.
+        const char* intern(const std::string& name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return names_.insert(name).first->c_str();
+        }
+
+        // Nom affiché pour le thread appelant
+        void setThreadName(const char* name) {
+            buffer().name.store(name, std::memory_order_relaxed);
+        }
+
+        void emit(Phase phase, const char* category, const char* name) {
+            if (!enabled()) return;
+            ThreadBuffer& b = buffer();
+            uint64_t i = b.head.load(std::memory_order_relaxed);
+            Event& e = b.events[i & (kEventsPerThread - 1)];
+            e.timeNs.store(nowNs(), std::memory_order_relaxed);
+            e.category.store(category, std::memory_order_relaxed);
+            e.name.store(name, std::memory_order_relaxed);
+            e.phase.store(phase, std::memory_order_relaxed);
+            b.head.store(i + 1, std::memory_order_release);
+        }
+
+        // Ecrit les événements de tous les threads ; possible pendant que l'agent tourne
+        bool writeChromeJson(const std::string& path) {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+
+            std::vector<ThreadBuffer*> buffers;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& b : buffers_) buffers.push_back(b.get());
+            }
+
+            out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+            bool first = true;
+            char line[1024];
+            for (ThreadBuffer* b : buffers) {
+                if (const char* name = b->name.load(std::memory_order_relaxed)) {
+                    std::snprintf(line, sizeof(line),
+                        "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                        first ? "" : ",\n", b->tid, escaped(name).c_str());
+                    out << line;
+                    first = false;
+                }
+                for (const auto& e : collect(*b)) {
+                    std::snprintf(line, sizeof(line),
+                        "%s{\"ph\":\"%c\",\"cat\":\"%s\",\"name\":\"%s\",\"ts\":%llu.%03llu,\"pid\":1,\"tid\":%u%s}",
+                        first ? "" : ",\n", (char)e.phase, escaped(e.category).c_str(), escaped(e.name).c_str(),
+                        (unsigned long long)(e.timeNs / 1000), (unsigned long long)(e.timeNs % 1000), b->tid,
+                        e.phase == Phase::INSTANT ? ",\"s\":\"t\"" : "");
+                    out << line;
+                    first = false;
+                }
+            }
+            out << "\n]}\n";
+            return (bool)out;
+        }
+
+    private:
+        struct Event {
+            std::atomic<uint64_t> timeNs{0};
+            std::atomic<const char*> category{nullptr};
+            std::atomic<const char*> name{nullptr};
+            std::atomic<Phase> phase{Phase::INSTANT};
+        };
+
+        struct ThreadBuffer {
+            std::atomic<uint64_t> head{0};
+            std::atomic<const char*> name{nullptr};
+            uint32_t tid = 0;
+            std::array<Event, kEventsPerThread> events;
+        };
+
+        struct EventCopy {
+            uint64_t timeNs;
+            const char* category;
+            const char* name;
+            Phase phase;
+        };
+
+        Tracer() : epoch_(std::chrono::steady_clock::now()) {}
+
+        std::atomic<bool> enabled_{false};
+        std::chrono::steady_clock::time_point epoch_;
+        std::mutex mutex_;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers_; // Survivent à leur thread
+        std::set<std::string> names_;
+
+        uint64_t nowNs() const {
+            return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - epoch_).count();
+        }
+
+        ThreadBuffer& buffer() {
+            thread_local ThreadBuffer* local = nullptr;
+            if (!local) {
+                auto b = std::make_unique<ThreadBuffer>();
+                std::lock_guard<std::mutex> lock(mutex_);
+                b->tid = (uint32_t)buffers_.size() + 1;
+                local = b.get();
+                buffers_.push_back(std::move(b));
+            }
+            return *local;
+        }
+
+        // Lecture pendant l'écriture : les emplacements réécrits pendant la copie sont écartés
+        static std::vector<EventCopy> collect(const ThreadBuffer& b) {
+            uint64_t head = b.head.load(std::memory_order_acquire);
+            uint64_t first = head > kEventsPerThread ? head - kEventsPerThread : 0;
+            std::vector<EventCopy> copy;
+            copy.reserve((size_t)(head - first));
+            for (uint64_t i = first; i < head; ++i) {
+                const Event& e = b.events[i & (kEventsPerThread - 1)];
+                copy.push_back({e.timeNs.load(std::memory_order_relaxed), e.category.load(std::memory_order_relaxed),
+                                e.name.load(std::memory_order_relaxed), e.phase.load(std::memory_order_relaxed)});
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            uint64_t after = b.head.load(std::memory_order_relaxed);
+            // L'événement `after` peut déjà être en cours d'écriture (head pas encore publié) :
+            // son emplacement, celui de after - kEventsPerThread, est écarté aussi
+            uint64_t valid = after + 1 > kEventsPerThread ? after + 1 - kEventsPerThread : 0;
+            size_t skip = valid > first ? (size_t)std::min<uint64_t>(valid - first, copy.size()) : 0;
+            copy.erase(copy.begin(), copy.begin() + (std::ptrdiff_t)skip);
+            return copy;
+        }
+
+        static std::string escaped(const char* s) {
+            std::string out;
+            for (; s && *s; ++s) {
+                if (*s == '"' || *s == '\\') out += '\\';
+                if ((unsigned char)*s >= 0x20) out += *s;
+            }
+            return out.size() > 200 ? out.substr(0, 200) : out;
+        }
+    };
+
+    // Début/fin d'une tranche sur le thread courant
+    class TraceScope {
+    public:
+        TraceScope(const char* category, const char* name) : category_(category), name_(name) {
+            Tracer::instance().emit(Tracer::Phase::BEGIN, category_, name_);
+        }
+        ~TraceScope() { Tracer::instance().emit(Tracer::Phase::END, category_, name_); }
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        const char* category_;
+        const char* name_;
+    };
+
+}
+
+#define LSAA_TRACE_CONCAT_(a, b) a##b
+#define LSAA_TRACE_CONCAT(a, b) LSAA_TRACE_CONCAT_(a, b)
+
+#ifdef LSAA_ENABLE_TRACING
+#define LSAA_TRACE_SCOPE(category, name) lsaa::TraceScope LSAA_TRACE_CONCAT(lsaaTrace_, __LINE__)(category, name)
+#define LSAA_TRACE_INSTANT(category, name) lsaa::Tracer::instance().emit(lsaa::Tracer::Phase::INSTANT, category, name)
+#define LSAA_TRACE_INTERN(name) lsaa::Tracer::instance().intern(name)
+#define LSAA_TRACE_THREAD_NAME(name) lsaa::Tracer::instance().setThreadName(name)
+#else
+#define LSAA_TRACE_SCOPE(category, name) ((void)0)
+#define LSAA_TRACE_INSTANT(category, name) ((void)0)
+#define LSAA_TRACE_INTERN(name) ((const char*)nullptr)
+#define LSAA_TRACE_THREAD_NAME(name) ((void)0)
+#endif
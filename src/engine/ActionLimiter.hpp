@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include "Rule.hpp"
+
+namespace lsaa {
+
+    // Seau à jetons : `burst` exécutions d'affilée, puis `perMinute` par minute
+    class TokenBucket {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        TokenBucket(double perMinute = 0.0, double burst = 0.0)
+            : rate_(perMinute / 60.0), burst_(burst), tokens_(burst) {}
+
+        // Recharge jusqu'à `now` et indique si un jeton est disponible, sans le prendre
+        bool available(Clock::time_point now) {
+            if (last_ != Clock::time_point{}) {
+                tokens_ = std::min(burst_, tokens_ + std::chrono::duration<double>(now - last_).count() * rate_);
+            }
+            last_ = now;
+            return tokens_ >= 1.0;
+        }
+
+        // A appeler après available() == true
+        void take() { tokens_ -= 1.0; }
+
+    private:
+        double rate_;
+        double burst_;
+        double tokens_;
+        Clock::time_point last_{};
+    };
+
+    // Garde-fou commun à toutes les actions des règles, dans l'ordre :
+    //   1. déduplication : même (règle, action, paramètre) dans la fenêtre -> ignorée
+    //   2. seau par type d'action (NOTIFY, KILL...)
+    //   3. seau global
+    // Les deux seaux sont vérifiés avant d'en débiter un : une action refusée ne consomme rien.
+    // Une règle qui oscille autour de son seuil ne relance donc pas son action à chaque front.
+    // L'état survit aux rechargements des règles (clé = définition, pas l'instance).
+    class ActionLimiter {
+    public:
+        using Clock = TokenBucket::Clock;
+
+        struct Limits {
+            std::chrono::seconds dedupWindow{30};
+            double perTypePerMinute = 10.0;
+            double perTypeBurst = 5.0;
+            double globalPerMinute = 30.0;
+            double globalBurst = 15.0;
+        };
+
+        enum class Verdict { RUN, DUPLICATE, TYPE_LIMITED, GLOBAL_LIMITED };
+
+        static ActionLimiter& instance() {
+            static ActionLimiter limiter;
+            return limiter;
+        }
+
+        // A appeler avant le chargement des règles
+        void configure(const Limits& limits) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            limits_ = limits;
+            global_ = TokenBucket(limits.globalPerMinute, limits.globalBurst);
+            types_.clear();
+            lastRun_.clear();
+        }
+
+        Verdict admit(std::string_view type, std::string_view key, Clock::time_point now = Clock::now()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto last = lastRun_.find(key);
+            if (last != lastRun_.end() && now - last->second < limits_.dedupWindow) {
+                deduplicated_.fetch_add(1, std::memory_order_relaxed);
+                return Verdict::DUPLICATE;
+            }
+            auto bucket = types_.find(type);
+            if (bucket == types_.end()) {
+                bucket = types_.emplace(std::string(type), TokenBucket(limits_.perTypePerMinute, limits_.perTypeBurst)).first;
+            }
+            if (!bucket->second.available(now)) {
+                suppressed_.fetch_add(1, std::memory_order_relaxed);
+                return Verdict::TYPE_LIMITED;
+            }
+            if (!global_.available(now)) {
+                suppressed_.fetch_add(1, std::memory_order_relaxed);
+                return Verdict::GLOBAL_LIMITED;
+            }
+            bucket->second.take();
+            global_.take();
+            if (last != lastRun_.end()) last->second = now;
+            else lastRun_.emplace(std::string(key), now);
+            executed_.fetch_add(1, std::memory_order_relaxed);
+            return Verdict::RUN;
+        }
+
+        // Notifications fusionnées dans un résumé (voir NotificationBatcher)
+        void countMerged(uint64_t n) { merged_.fetch_add(n, std::memory_order_relaxed); }
+
+        uint64_t executed() const { return executed_.load(std::memory_order_relaxed); }
+        uint64_t deduplicated() const { return deduplicated_.load(std::memory_order_relaxed); }
+        uint64_t suppressed() const { return suppressed_.load(std::memory_order_relaxed); }
+        uint64_t merged() const { return merged_.load(std::memory_order_relaxed); }
+
+    private:
+        ActionLimiter() : global_(limits_.globalPerMinute, limits_.globalBurst) {}
+
+        std::mutex mutex_;
+        Limits limits_;
+        TokenBucket global_;
+        std::map<std::string, TokenBucket, std::less<>> types_;
+        std::map<std::string, Clock::time_point, std::less<>> lastRun_;
+
+        std::atomic<uint64_t> executed_{0};
+        std::atomic<uint64_t> deduplicated_{0};
+        std::atomic<uint64_t> suppressed_{0};
+        std::atomic<uint64_t> merged_{0};
+    };
+
+    // Enveloppe posée par RuleFactory autour de l'action de chaque règle
+    class ActionLimited : public IAction {
+    public:
+        ActionLimited(std::string type, std::string key, std::unique_ptr<IAction> inner)
+            : type_(std::move(type)), key_(std::move(key)), inner_(std::move(inner)) {}
+
+        void execute() override {
+            switch (ActionLimiter::instance().admit(type_, key_)) {
+                case ActionLimiter::Verdict::RUN: inner_->execute(); outcome_ = inner_->lastOutcome(); break;
+                case ActionLimiter::Verdict::DUPLICATE: LSAA_LOG_INFO("Action deduplicated: " + inner_->getName()); outcome_ = ActionOutcome::DUPLICATE; break;
+                case ActionLimiter::Verdict::TYPE_LIMITED: LSAA_LOG_WARN("Action rate limited (" + type_ + "): " + inner_->getName()); outcome_ = ActionOutcome::TYPE_LIMITED; break;
+                case ActionLimiter::Verdict::GLOBAL_LIMITED: LSAA_LOG_WARN("Action rate limited (global): " + inner_->getName()); outcome_ = ActionOutcome::GLOBAL_LIMITED; break;
+            }
+        }
+
+        std::string getName() const override { return inner_->getName(); }
+        ActionOutcome lastOutcome() const override { return outcome_; }
+
+    private:
+        std::string type_;
+        std::string key_;
+        std::unique_ptr<IAction> inner_;
+        ActionOutcome outcome_ = ActionOutcome::NONE;
+    };
+
+}
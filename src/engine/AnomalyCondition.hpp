@@ -0,0 +1,281 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "Rule.hpp"
+#include "../core/TickClock.hpp"
+
+namespace lsaa {
+
+    // --- STATISTIQUES EN LIGNE (mémoire fixe, coût borné par échantillon) ---
+
+    // Moyenne et variance à décroissance exponentielle (alpha = 2 / (N + 1))
+    struct EwmaStats {
+        double alpha;
+        double mean = 0.0;
+        double variance = 0.0;
+        long long count = 0;
+
+        explicit EwmaStats(int span) : alpha(2.0 / (span + 1.0)) {}
+
+        // Moyenne cumulative tant que count < N : pas de variance sous-estimée au démarrage
+        void add(double x) {
+            if (count++ == 0) { mean = x; return; }
+            double a = std::max(alpha, 1.0 / (double)count);
+            double diff = x - mean;
+            double incr = a * diff;
+            mean += incr;
+            variance = (1.0 - a) * (variance + diff * incr);
+        }
+    };
+
+    // Médiane et MAD exactes sur les W derniers échantillons (anneau + copie triée)
+    template <size_t W>
+    class RollingMedian {
+    public:
+        void add(double x) {
+            if (size_ == W) {
+                double old = ring_[head_];
+                double* pos = std::lower_bound(sorted_.data(), sorted_.data() + size_, old);
+                std::copy(pos + 1, sorted_.data() + size_, pos);
+                size_--;
+            }
+            ring_[head_] = x;
+            head_ = (head_ + 1) % W;
+            double* pos = std::upper_bound(sorted_.data(), sorted_.data() + size_, x);
+            std::copy_backward(pos, sorted_.data() + size_, sorted_.data() + size_ + 1);
+            *pos = x;
+            size_++;
+        }
+
+        size_t size() const { return size_; }
+
+        double median() const {
+            if (size_ == 0) return 0.0;
+            return size_ % 2 ? sorted_[size_ / 2] : (sorted_[size_ / 2 - 1] + sorted_[size_ / 2]) / 2.0;
+        }
+
+        // Ecart absolu médian autour de `center` : les écarts croissent de part et d'autre de
+        // center dans la copie triée, fusion des deux côtés jusqu'au rang médian.
+        double mad(double center) const {
+            if (size_ == 0) return 0.0;
+            const double* v = sorted_.data();
+            size_t right = (size_t)(std::lower_bound(v, v + size_, center) - v);
+            size_t left = right; // Prochain élément à gauche : left - 1
+            double deviation = 0.0;
+            for (size_t k = 0; k <= size_ / 2; ++k) {
+                bool takeLeft = right == size_ || (left > 0 && center - v[left - 1] <= v[right] - center);
+                deviation = takeLeft ? center - v[--left] : v[right++] - center;
+            }
+            return deviation;
+        }
+
+    private:
+        std::array<double, W> ring_{};
+        std::array<double, W> sorted_{};
+        size_t head_ = 0;
+        size_t size_ = 0;
+    };
+
+    // Moyenne/variance pondérées, fusionnables (Chan et al.)
+    struct WeightedStats {
+        double weight = 0.0;
+        double mean = 0.0;
+        double m2 = 0.0;
+
+        void add(double x) {
+            weight += 1.0;
+            double delta = x - mean;
+            mean += delta / weight;
+            m2 += delta * (x - mean);
+        }
+
+        void merge(const WeightedStats& other) {
+            if (other.weight <= 0.0) return;
+            double total = weight + other.weight;
+            double delta = other.mean - mean;
+            mean += delta * other.weight / total;
+            m2 += other.m2 + delta * delta * weight * other.weight / total;
+            weight = total;
+        }
+
+        void decay(double factor) {
+            weight *= factor;
+            m2 *= factor;
+        }
+
+        double variance() const { return weight > 1.0 ? m2 / weight : 0.0; }
+    };
+
+    // --- CONDITIONS ---
+
+    // Condition sur l'écart d'une métrique à sa propre référence, exprimé en écarts-types
+    // ("score"), comparé au seuil avec l'opérateur de la règle. Opérateurs de la config :
+    //   "zscore>"   : écart à la moyenne/variance EWMA (~5 min)
+    //   "mad>"      : score robuste (x - médiane) / (1.4826 * MAD) sur les 128 derniers échantillons
+    //   "seasonal>" : écart à la référence de la même heure de la semaine, apprise les semaines précédentes
+    // (">" peut être remplacé par n'importe quel opérateur : "zscore<" -3 détecte une chute).
+    //
+    // Le score d'un échantillon est calculé avant de l'intégrer à la référence. Tant que
+    // la référence n'a pas kWarmupSamples échantillons, la condition est fausse.
+    class ConditionAnomaly : public ICondition {
+    public:
+        enum class Kind { ZSCORE, MAD, SEASONAL };
+
+        static constexpr int kEwmaSpan = 300;
+        static constexpr size_t kMadWindow = 128;
+        static constexpr double kWarmupSamples = 30.0;
+        static constexpr double kWeekDecay = 0.5;      // Poids des semaines précédentes à chaque nouvelle semaine
+        static constexpr double kMinSigmaRatio = 0.01; // Ecart-type plancher : 1 % de la référence
+
+        ConditionAnomaly(const MetricHandle& handle, Kind kind, ConditionGeneric::Operator op, double threshold)
+            : ConditionAnomaly(handle.descriptor.name, kind, op, threshold) {
+            value_ = handle.value;
+        }
+
+        ConditionAnomaly(std::string metric, Kind kind, ConditionGeneric::Operator op, double threshold)
+            : metric_(std::move(metric)), kind_(kind), op_(op), threshold_(threshold) {
+            if (kind_ == Kind::MAD) window_ = std::make_unique<RollingMedian<kMadWindow>>();
+            if (kind_ == Kind::SEASONAL) seasons_ = std::make_unique<std::array<Season, 7 * 24>>();
+        }
+
+        // "zscore>", "mad<=", "seasonal>"... ; faux si ce n'est pas un opérateur d'anomalie
+        static bool parseOperator(std::string_view text, Kind& kind, ConditionGeneric::Operator& op) {
+            static constexpr std::pair<std::string_view, Kind> kinds[] = {
+                {"zscore", Kind::ZSCORE}, {"mad", Kind::MAD}, {"seasonal", Kind::SEASONAL}
+            };
+            for (const auto& [prefix, k] : kinds) {
+                if (text.substr(0, prefix.size()) != prefix) continue;
+                kind = k;
+                return ConditionGeneric::parseOperator(text.substr(prefix.size()), op);
+            }
+            return false;
+        }
+
+        bool observedValue(const MetricsMap& metrics, double& out) const override {
+            const MetricValue* v = value_;
+            if (!v) {
+                auto it = metrics.find(metric_);
+                if (it == metrics.end()) return false;
+                v = &it->second;
+            }
+            return metricAsDouble(*v, out);
+        }
+
+        bool evaluate(const MetricsMap& metrics) const override {
+            const MetricValue* v = value_;
+            if (!v) {
+                auto it = metrics.find(metric_);
+                if (it == metrics.end()) return false;
+                v = &it->second;
+            }
+            double x = 0.0;
+            if (!metricAsDouble(*v, x) || !std::isfinite(x)) return false;
+
+            double s = score(x);
+            update(x);
+            lastScore_ = s;
+            return std::isfinite(s) && ConditionGeneric::compare(op_, s, threshold_);
+        }
+
+        // Conserve la référence apprise lors d'un rechargement de la même règle
+        void adoptStateFrom(const ICondition& previous) override {
+            if (auto* p = dynamic_cast<const ConditionAnomaly*>(&previous); p && p->kind_ == kind_) {
+                ewma_ = p->ewma_;
+                if (window_) *window_ = *p->window_;
+                if (seasons_) *seasons_ = *p->seasons_;
+                slot_ = p->slot_;
+                slotEnd_ = p->slotEnd_;
+            }
+        }
+
+        double lastScore() const { return lastScore_; }
+        const std::string& getMetric() const { return metric_; }
+
+    private:
+        struct Season {
+            WeightedStats baseline; // Semaines précédentes
+            WeightedStats current;  // Semaine en cours
+        };
+
+        std::string metric_;
+        const MetricValue* value_ = nullptr;
+        Kind kind_;
+        ConditionGeneric::Operator op_;
+        double threshold_;
+
+        // evaluate() est const (ICondition) mais fait avancer les statistiques.
+        // Seule la structure du type de détection est allouée (3 Ko pour MAD, 8 Ko pour SEASONAL).
+        mutable EwmaStats ewma_{kEwmaSpan};
+        std::unique_ptr<RollingMedian<kMadWindow>> window_;
+        std::unique_ptr<std::array<Season, 7 * 24>> seasons_;
+        mutable int slot_ = -1;
+        mutable std::chrono::system_clock::time_point slotEnd_{};
+        mutable double lastScore_ = NAN;
+
+        static double sigmaFloor(double reference, double sigma) {
+            return std::max({sigma, std::abs(reference) * kMinSigmaRatio, 1e-9});
+        }
+
+        double score(double x) const {
+            switch (kind_) {
+                case Kind::ZSCORE:
+                    if (ewma_.count < kWarmupSamples) return NAN;
+                    return (x - ewma_.mean) / sigmaFloor(ewma_.mean, std::sqrt(ewma_.variance));
+                case Kind::MAD: {
+                    if (window_->size() < kWarmupSamples) return NAN;
+                    double median = window_->median();
+                    return (x - median) / sigmaFloor(median, 1.4826 * window_->mad(median));
+                }
+                case Kind::SEASONAL: {
+                    const WeightedStats& base = (*seasons_)[currentSlot()].baseline;
+                    if (base.weight < kWarmupSamples) return NAN;
+                    return (x - base.mean) / sigmaFloor(base.mean, std::sqrt(base.variance()));
+                }
+            }
+            return NAN;
+        }
+
+        void update(double x) const {
+            switch (kind_) {
+                case Kind::ZSCORE: ewma_.add(x); break;
+                case Kind::MAD: window_->add(x); break;
+                case Kind::SEASONAL: (*seasons_)[currentSlot()].current.add(x); break;
+            }
+        }
+
+        // Heure de la semaine (heure locale du tick, TickClock : heure de la trace en rejeu),
+        // recalculée seulement au changement d'heure. En entrant dans un créneau, la semaine
+        // écoulée rejoint sa référence.
+        int currentSlot() const {
+            auto now = TickClock::wallNow();
+            if (slot_ >= 0 && now < slotEnd_) return slot_;
+
+            std::time_t t = std::chrono::system_clock::to_time_t(now);
+            std::tm local{};
+#ifdef _WIN32
+            localtime_s(&local, &t);
+#else
+            localtime_r(&t, &local);
+#endif
+            int slot = local.tm_wday * 24 + local.tm_hour;
+            slotEnd_ = now + std::chrono::seconds(3600 - local.tm_min * 60 - local.tm_sec);
+
+            if (slot != slot_) {
+                Season& s = (*seasons_)[slot];
+                s.baseline.decay(kWeekDecay);
+                s.baseline.merge(s.current);
+                s.current = {};
+                slot_ = slot;
+            }
+            return slot_;
+        }
+    };
+
+}
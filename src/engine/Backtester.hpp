@@ -0,0 +1,176 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "Rule.hpp"
+#include "AnomalyCondition.hpp"
+#include "ForecastCondition.hpp"
+#include "../core/RuleConfig.hpp"
+#include "../core/MetricHistory.hpp"
+
+namespace lsaa {
+
+    // Bilan d'une règle candidate sur l'historique
+    struct BacktestResult {
+        std::string rule;
+        std::string metric;
+        std::string error;          // Non vide : règle non évaluée
+        size_t firings = 0;         // Fronts montants = exécutions de l'action (sémantique de Rule)
+        double activeSeconds = 0.0; // Temps total où la condition était vraie
+        double longestSeconds = 0.0;
+        size_t flaps = 0;           // Redéclenchements moins de flapWindow après la levée précédente
+    };
+
+    // Evalue des règles en masse sur un MetricHistory. Chaque règle est calculée sur sa colonne
+    // complète, par blocs, avec ConditionGeneric::compare comme oracle (opérateur figé à la
+    // compilation pour que la boucle soit vectorisée). Les règles sont réparties sur plusieurs threads.
+    class Backtester {
+    public:
+        struct Candidate {
+            std::string name;
+            std::string metric;
+            ConditionGeneric::Operator op;
+            double threshold;
+        };
+
+        explicit Backtester(const MetricHistory& history) : history_(history) {}
+
+        void setFlapWindow(double seconds) { flapWindowNs_ = (uint64_t)(std::max(0.0, seconds) * 1e9); }
+        void setThreads(unsigned threads) { threads_ = std::max(1u, threads); }
+
+        std::vector<BacktestResult> run(const std::vector<Candidate>& rules) const {
+            std::vector<BacktestResult> results(rules.size());
+            std::atomic<size_t> next{0};
+            auto worker = [&]() {
+                std::vector<uint8_t> block(kBlock);
+                for (size_t i = next++; i < rules.size(); i = next++) results[i] = evaluate(rules[i], block);
+            };
+
+            unsigned count = (unsigned)std::min<size_t>(threads_, rules.size());
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < count; ++t) pool.emplace_back(worker);
+            worker();
+            for (auto& th : pool) th.join();
+            return results;
+        }
+
+        // Convertit une définition de règle ; faux (avec message) si elle n'est pas évaluable
+        static bool candidateOf(const RuleView& cfg, Candidate& out, std::string& error) {
+            ConditionAnomaly::Kind anomaly{};
+            if (ConditionAnomaly::parseOperator(cfg.oper, anomaly, out.op) || ConditionForecast::parseOperator(cfg.oper, out.op)) {
+                error = "condition '" + std::string(cfg.oper) + "' is stateful: replay the trace instead";
+                return false;
+            }
+            if (!ConditionGeneric::parseOperator(cfg.oper, out.op)) {
+                error = "unknown operator '" + std::string(cfg.oper) + "'";
+                return false;
+            }
+            out.name = std::string(cfg.name);
+            out.metric = std::string(cfg.metric);
+            out.threshold = cfg.threshold;
+            return true;
+        }
+
+        // Référence scalaire : ConditionGeneric::evaluate tick par tick, pour valider le calcul en masse
+        size_t oracleFirings(const Candidate& rule) const {
+            const std::vector<double>* column = history_.column(rule.metric);
+            if (!column) return 0;
+            ConditionGeneric cond(rule.metric, rule.op, rule.threshold);
+            MetricsMap metrics;
+            MetricValue& slot = metrics[rule.metric];
+            bool last = false;
+            size_t firings = 0;
+            for (double v : *column) {
+                if (std::isnan(v)) slot = std::monostate{};
+                else slot = v;
+                bool now = cond.evaluate(metrics);
+                if (now && !last) firings++;
+                last = now;
+            }
+            return firings;
+        }
+
+    private:
+        static constexpr size_t kBlock = 4096;
+
+        const MetricHistory& history_;
+        uint64_t flapWindowNs_ = 60'000'000'000ull;
+        unsigned threads_ = std::max(1u, std::thread::hardware_concurrency());
+
+        template <ConditionGeneric::Operator Op>
+        static void evalBlock(const double* values, size_t n, double threshold, uint8_t* out) {
+            for (size_t i = 0; i < n; ++i) out[i] = ConditionGeneric::compare(Op, values[i], threshold);
+        }
+
+        static void evalBlock(ConditionGeneric::Operator op, const double* values, size_t n, double threshold, uint8_t* out) {
+            using O = ConditionGeneric::Operator;
+            switch (op) {
+                case O::GREATER:       evalBlock<O::GREATER>(values, n, threshold, out); break;
+                case O::GREATER_EQUAL: evalBlock<O::GREATER_EQUAL>(values, n, threshold, out); break;
+                case O::LESS:          evalBlock<O::LESS>(values, n, threshold, out); break;
+                case O::LESS_EQUAL:    evalBlock<O::LESS_EQUAL>(values, n, threshold, out); break;
+                case O::EQUAL:         evalBlock<O::EQUAL>(values, n, threshold, out); break;
+                case O::NOT_EQUAL:     evalBlock<O::NOT_EQUAL>(values, n, threshold, out); break;
+            }
+        }
+
+        BacktestResult evaluate(const Candidate& rule, std::vector<uint8_t>& block) const {
+            BacktestResult r;
+            r.rule = rule.name;
+            r.metric = rule.metric;
+            const std::vector<double>* column = history_.column(rule.metric);
+            if (!column) {
+                r.error = "metric '" + rule.metric + "' not in history";
+                return r;
+            }
+
+            const auto& times = history_.times();
+            const size_t total = times.size();
+            bool active = false;        // lastStatus_ de Rule : faux au démarrage
+            uint64_t since = 0;         // Début de l'épisode en cours
+            bool everCleared = false;
+            uint64_t clearedAt = 0;
+
+            for (size_t base = 0; base < total; base += kBlock) {
+                size_t n = std::min(kBlock, total - base);
+                evalBlock(rule.op, column->data() + base, n, rule.threshold, block.data());
+                for (size_t i = 0; i < n; ++i) {
+                    // Cas courant : aucun changement, on saute 8 ticks d'un coup
+                    const uint64_t same = active ? 0x0101010101010101ull : 0;
+                    while (i + 8 <= n) {
+                        uint64_t word;
+                        std::memcpy(&word, block.data() + i, sizeof(word));
+                        if (word != same) break;
+                        i += 8;
+                    }
+                    if (i >= n) break;
+                    if ((bool)block[i] == active) continue;
+                    uint64_t t = times[base + i];
+                    active = block[i] != 0;
+                    if (active) {
+                        r.firings++;
+                        if (everCleared && t - clearedAt < flapWindowNs_) r.flaps++;
+                        since = t;
+                    } else {
+                        closeEpisode(r, t - since);
+                        everCleared = true;
+                        clearedAt = t;
+                    }
+                }
+            }
+            if (active && total > 0) closeEpisode(r, times[total - 1] - since);
+            return r;
+        }
+
+        static void closeEpisode(BacktestResult& r, uint64_t durationNs) {
+            double s = (double)durationNs / 1e9;
+            r.activeSeconds += s;
+            r.longestSeconds = std::max(r.longestSeconds, s);
+        }
+    };
+
+}
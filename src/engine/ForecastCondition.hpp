@@ -0,0 +1,78 @@
+#pragma once
+#include <cmath>
+#include <string>
+#include <string_view>
+#include "Rule.hpp"
+#include "../core/LinearTrend.hpp"
+#include "../core/TickClock.hpp"
+
+namespace lsaa {
+
+    // Prévision de saturation d'une métrique en pourcentage : droite des moindres carrés sur
+    // les kWindow derniers ticks, extrapolée jusqu'à 100 %. Opérateur "ttf<" (time to full)
+    // avec l'horizon en secondes comme seuil : "ram_load_percent" "ttf<" 1800 se déclenche
+    // quand la RAM serait pleine dans moins de 30 min au rythme actuel.
+    // Pour la RAM et les disques, les métriques *_seconds_to_full s'utilisent avec "<".
+    // Les échantillons sont datés par l'instant du tick (TickClock), y compris en rejeu accéléré.
+    class ConditionForecast : public ICondition {
+    public:
+        static constexpr size_t kWindow = 300;
+        static constexpr size_t kMinSamples = 30;
+        static constexpr double kFull = 100.0;
+
+        ConditionForecast(const MetricHandle& handle, ConditionGeneric::Operator op, double horizonSeconds)
+            : ConditionForecast(handle.descriptor.name, op, horizonSeconds) {
+            value_ = handle.value;
+        }
+
+        ConditionForecast(std::string metric, ConditionGeneric::Operator op, double horizonSeconds)
+            : metric_(std::move(metric)), op_(op), horizon_(horizonSeconds) {}
+
+        // "ttf<", "ttf<="... ; faux si ce n'est pas un opérateur de prévision
+        static bool parseOperator(std::string_view text, ConditionGeneric::Operator& op) {
+            if (text.substr(0, 3) != "ttf") return false;
+            return ConditionGeneric::parseOperator(text.substr(3), op);
+        }
+
+        bool observedValue(const MetricsMap& metrics, double& out) const override {
+            const MetricValue* v = value_;
+            if (!v) {
+                auto it = metrics.find(metric_);
+                if (it == metrics.end()) return false;
+                v = &it->second;
+            }
+            return metricAsDouble(*v, out);
+        }
+
+        bool evaluate(const MetricsMap& metrics) const override {
+            const MetricValue* v = value_;
+            if (!v) {
+                auto it = metrics.find(metric_);
+                if (it == metrics.end()) return false;
+                v = &it->second;
+            }
+            double x = 0.0;
+            if (!metricAsDouble(*v, x) || !std::isfinite(x)) return false;
+
+            trend_.add(TickClock::now(), x);
+            if (trend_.size() < kMinSamples) return false;
+            secondsToFull_ = trend_.secondsUntil(kFull);
+            return ConditionGeneric::compare(op_, secondsToFull_, horizon_);
+        }
+
+        void adoptStateFrom(const ICondition& previous) override {
+            if (auto* p = dynamic_cast<const ConditionForecast*>(&previous)) trend_ = p->trend_;
+        }
+
+        double secondsToFull() const { return secondsToFull_; }
+
+    private:
+        std::string metric_;
+        const MetricValue* value_ = nullptr;
+        ConditionGeneric::Operator op_;
+        double horizon_;
+        mutable LinearTrend trend_{kWindow};
+        mutable double secondsToFull_ = INFINITY;
+    };
+
+}
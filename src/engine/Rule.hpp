@@ -5,8 +5,14 @@
 #include <utility>
 #include <memory>
 #include <cmath>
+#include <string_view>
+#include <chrono>
 #include "../core/IMonitor.hpp"
+#include "../core/MetricRegistry.hpp"
 #include "../core/Logger.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/Tracer.hpp"
+#include "../core/EventJournal.hpp"
 
 namespace lsaa {
 
@@ -16,6 +22,10 @@ namespace lsaa {
     public:
         virtual ~ICondition() = default;
         virtual bool evaluate(const MetricsMap& metrics) const = 0;
+        // Conditions à état (anomalies) : reprise de l'état d'une règle identique au rechargement
+        virtual void adoptStateFrom(const ICondition& previous) { (void)previous; }
+        // Valeur de la métrique observée, pour le journal d'événements
+        virtual bool observedValue(const MetricsMap& metrics, double& out) const { (void)metrics; (void)out; return false; }
     };
 
     // Generic Metric Condition (e.g. "cpu_usage_percent" > 90.0)
@@ -26,31 +36,64 @@ namespace lsaa {
         ConditionGeneric(std::string metric, Operator op, double threshold)
             : metric_(std::move(metric)), op_(op), threshold_(threshold) {}
 
+        // Variante pré-résolue : la valeur est lue via le handle, sans recherche par nom
+        ConditionGeneric(const MetricHandle& handle, Operator op, double threshold)
+            : metric_(handle.descriptor.name), op_(op), threshold_(threshold), value_(handle.value) {}
+
         bool evaluate(const MetricsMap& metrics) const override {
-            auto it = metrics.find(metric_);
-            if (it == metrics.end()) return false;
+            const MetricValue* v = value_;
+            if (!v) {
+                auto it = metrics.find(metric_);
+                if (it == metrics.end()) return false;
+                v = &it->second;
+            }
 
             double val = 0.0;
-            const auto& v = it->second;
-            
-            if (std::holds_alternative<double>(v)) val = std::get<double>(v);
-            else if (std::holds_alternative<long long>(v)) val = static_cast<double>(std::get<long long>(v));
-            else return false;
+            if (!metricAsDouble(*v, val)) return false;
+            return compare(op_, val, threshold_);
+        }
+
+        bool observedValue(const MetricsMap& metrics, double& out) const override {
+            const MetricValue* v = value_;
+            if (!v) {
+                auto it = metrics.find(metric_);
+                if (it == metrics.end()) return false;
+                v = &it->second;
+            }
+            return metricAsDouble(*v, out);
+        }
 
-            switch(op_) {
-                case Operator::GREATER:       return val > threshold_;
-                case Operator::GREATER_EQUAL: return val >= threshold_;
-                case Operator::LESS:          return val < threshold_;
-                case Operator::LESS_EQUAL:    return val <= threshold_;
-                case Operator::EQUAL:         return std::abs(val - threshold_) < 0.001;
-                case Operator::NOT_EQUAL:     return std::abs(val - threshold_) > 0.001;
+        static bool compare(Operator op, double val, double threshold) {
+            switch(op) {
+                case Operator::GREATER:       return val > threshold;
+                case Operator::GREATER_EQUAL: return val >= threshold;
+                case Operator::LESS:          return val < threshold;
+                case Operator::LESS_EQUAL:    return val <= threshold;
+                case Operator::EQUAL:         return std::abs(val - threshold) < 0.001;
+                case Operator::NOT_EQUAL:     return std::abs(val - threshold) > 0.001;
             }
             return false;
         }
+
+        // ">", ">=", "<", "<=", "==" (ou "="), "!="
+        static bool parseOperator(std::string_view text, Operator& out) {
+            if (text == ">")                      out = Operator::GREATER;
+            else if (text == ">=")                out = Operator::GREATER_EQUAL;
+            else if (text == "<")                 out = Operator::LESS;
+            else if (text == "<=")                out = Operator::LESS_EQUAL;
+            else if (text == "==" || text == "=") out = Operator::EQUAL;
+            else if (text == "!=")                out = Operator::NOT_EQUAL;
+            else return false;
+            return true;
+        }
+
+        const std::string& getMetric() const { return metric_; }
+
     private:
         std::string metric_;
         Operator op_;
         double threshold_;
+        const MetricValue* value_ = nullptr;
     };
 
     // Specific CPU Condition Helper
@@ -75,12 +118,27 @@ namespace lsaa {
         virtual ~IAction() = default;
         virtual void execute() = 0;
         virtual std::string getName() const = 0;
+        // Sort du dernier execute() (les enveloppes de limitation peuvent l'avoir écarté)
+        virtual ActionOutcome lastOutcome() const { return ActionOutcome::RUN; }
     };
 
     class ActionLog : public IAction {
     public:
         enum class Level { INFO, WARN, ERR };
         ActionLog(Level level, std::string msg) : level_(level), msg_(std::move(msg)) {}
+
+        // actionParam "INFO: msg", "WARN: msg" ou "ERROR: msg" ; sans préfixe, WARN
+        static std::unique_ptr<ActionLog> fromParam(std::string_view param) {
+            static constexpr std::pair<std::string_view, Level> kPrefixes[] = {
+                {"INFO:", Level::INFO}, {"WARN:", Level::WARN}, {"ERROR:", Level::ERR}};
+            for (const auto& [prefix, level] : kPrefixes) {
+                if (!param.starts_with(prefix)) continue;
+                std::string_view msg = param.substr(prefix.size());
+                while (!msg.empty() && msg.front() == ' ') msg.remove_prefix(1);
+                return std::make_unique<ActionLog>(level, std::string(msg));
+            }
+            return std::make_unique<ActionLog>(Level::WARN, std::string(param));
+        }
         void execute() override {
             if(level_ == Level::WARN) LSAA_LOG_WARN(msg_);
             else if(level_ == Level::ERR) LSAA_LOG_ERROR(msg_);
@@ -97,38 +155,83 @@ namespace lsaa {
 
     class Rule {
     public:
-        Rule(std::string name) : name_(std::move(name)) {}
+        Rule(std::string name) : name_(std::move(name)), traceName_(LSAA_TRACE_INTERN(name_)) {}
         
         // Legacy Constructor support (optional but helpful)
         Rule(std::string name, std::unique_ptr<ICondition> cond, std::unique_ptr<IAction> action)
-            : name_(std::move(name)), condition_(std::move(cond)), action_(std::move(action)) {}
+            : name_(std::move(name)), traceName_(LSAA_TRACE_INTERN(name_)), condition_(std::move(cond)) {
+            setAction(std::move(action));
+        }
 
         void setCondition(std::unique_ptr<ICondition> cond) { condition_ = std::move(cond); }
-        void setAction(std::unique_ptr<IAction> action) { action_ = std::move(action); }
+        void setAction(std::unique_ptr<IAction> action) {
+            action_ = std::move(action);
+            actionTraceName_ = action_ ? LSAA_TRACE_INTERN(action_->getName()) : nullptr;
+        }
+
+        const std::string& getName() const { return name_; }
 
-        void checkAndExecute(const MetricsMap& metrics) {
-            if (!condition_ || !action_) return;
+        // Empreinte de la définition (config source). Deux règles de même empreinte sont
+        // interchangeables : un rechargement conserve alors l'état de l'ancienne.
+        void setDefinitionKey(std::string key) { definitionKey_ = std::move(key); }
+        const std::string& getDefinitionKey() const { return definitionKey_; }
+
+        void adoptStateFrom(const Rule& previous) {
+            lastStatus_ = previous.lastStatus_;
+            if (condition_ && previous.condition_) condition_->adoptStateFrom(*previous.condition_);
+        }
+
+        enum class Transition { NONE, TRIGGERED, CLEARED };
+
+        Transition checkAndExecute(const MetricsMap& metrics) {
+            if (!condition_ || !action_) return Transition::NONE;
 
             bool currentStatus = condition_->evaluate(metrics);
+            Transition transition = Transition::NONE;
 
             if (currentStatus) {
                 if (!lastStatus_) {
+                    LSAA_TRACE_INSTANT("rule", traceName_);
                     LSAA_LOG_INFO("Rule Triggered: " + name_);
-                    action_->execute();
+                    auto started = std::chrono::steady_clock::now();
+                    {
+                        static LatencyHistogram& actionLatency = Profiler::instance().histogram("action");
+                        ScopedTimer timer(actionLatency);
+                        LSAA_TRACE_SCOPE("action", actionTraceName_);
+                        action_->execute();
+                    }
+                    transition = Transition::TRIGGERED;
+                    journal(metrics, EventTransition::TRIGGERED, action_->lastOutcome(),
+                            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started));
                 }
             } else {
                 if (lastStatus_) {
                     LSAA_LOG_INFO("Rule Cleared: " + name_);
+                    transition = Transition::CLEARED;
+                    journal(metrics, EventTransition::CLEARED, ActionOutcome::NONE, std::chrono::microseconds(0));
                 }
             }
             lastStatus_ = currentStatus;
+            return transition;
         }
 
     private:
         std::string name_;
+        const char* traceName_;
+        std::string definitionKey_;
         std::unique_ptr<ICondition> condition_;
         std::unique_ptr<IAction> action_;
+        const char* actionTraceName_ = nullptr;
         bool lastStatus_ = false;
+
+        // Front enregistré dans le journal binaire (s'il est ouvert)
+        void journal(const MetricsMap& metrics, EventTransition transition, ActionOutcome outcome, std::chrono::microseconds latency) {
+            EventJournal& journal = EventJournal::instance();
+            if (!journal.isOpen()) return;
+            double value = std::nan("");
+            condition_->observedValue(metrics, value);
+            journal.record(name_, action_->getName(), transition, value, outcome, latency);
+        }
     };
 
 }
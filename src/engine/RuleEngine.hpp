@@ -1,29 +1,95 @@
 #pragma once
 #include <vector>
 #include <memory>
+#include <atomic>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <utility>
+#include <unordered_map>
+#include <memory_resource>
+#include <string_view>
 #include "Rule.hpp"
+#include "../core/EngineSnapshot.hpp"
+#include "../core/TickArena.hpp"
 
 namespace lsaa {
 
+    using RuleSet = std::vector<std::unique_ptr<Rule>>;
+
     class RuleEngine {
     public:
-        void addRule(std::unique_ptr<Rule> rule) {
-            rules_.push_back(std::move(rule));
+        static constexpr size_t kMaxRecentEvents = 32;
+
+        // Publie un jeu de règles complet, construit hors du thread moteur (style RCU).
+        // Il devient actif au prochain evaluate() ; l'ancien est libéré par le thread moteur.
+        void publish(std::shared_ptr<RuleSet> rules) {
+            if (!rules) rules = std::make_shared<RuleSet>();
+            pending_.store(std::move(rules), std::memory_order_release);
         }
 
         // Évalue toutes les règles par rapport aux métriques globales fusionnées
         void evaluate(const MetricsMap& metrics) {
-            for (auto& rule : rules_) {
-                rule->checkAndExecute(metrics);
+            adoptPending();
+            if (!active_) return;
+            size_t transitions = 0;
+            for (auto& rule : *active_) {
+                auto transition = rule->checkAndExecute(metrics);
+                if (transition == Rule::Transition::NONE) continue;
+                // Seuls les kMaxRecentEvents derniers fronts du tick sont gardés (anneau sans allocation)
+                lastTransitions_[transitions++ % kMaxRecentEvents] = {rule.get(), transition == Rule::Transition::TRIGGERED};
             }
+            if (transitions) publishEvents(transitions);
         }
 
-        void clear() {
-            rules_.clear();
-        }
+        size_t size() const { return active_ ? active_->size() : 0; }
+
+        // Derniers fronts des règles (thread moteur ; liste immuable, partagée par les snapshots)
+        std::shared_ptr<const std::vector<RuleEvent>> recentEvents() const { return recentEvents_; }
 
     private:
-        std::vector<std::unique_ptr<Rule>> rules_;
+        // Ecrit uniquement par publish(), consommé par le thread moteur
+        std::atomic<std::shared_ptr<RuleSet>> pending_;
+        // Propriété exclusive du thread moteur : aucune synchronisation pendant l'évaluation
+        std::shared_ptr<RuleSet> active_;
+        std::shared_ptr<const std::vector<RuleEvent>> recentEvents_ = std::make_shared<const std::vector<RuleEvent>>();
+        std::array<std::pair<const Rule*, bool>, kMaxRecentEvents> lastTransitions_{};
+
+        // Nouvelle liste immuable : fin de la précédente + fronts de ce tick (rare en régime établi)
+        void publishEvents(size_t transitions) {
+            size_t fresh = std::min(transitions, kMaxRecentEvents);
+            size_t kept = std::min(recentEvents_->size(), kMaxRecentEvents - fresh);
+            auto events = std::make_shared<std::vector<RuleEvent>>(recentEvents_->end() - kept, recentEvents_->end());
+            events->reserve(kept + fresh);
+            auto now = std::chrono::system_clock::now();
+            for (size_t i = transitions - fresh; i < transitions; ++i) {
+                const auto& [rule, triggered] = lastTransitions_[i % kMaxRecentEvents];
+                events->push_back({now, rule->getName(), triggered});
+            }
+            recentEvents_ = std::move(events);
+        }
+
+        void adoptPending() {
+            if (!pending_.load(std::memory_order_relaxed)) return;
+            auto next = pending_.exchange(nullptr, std::memory_order_acq_rel);
+            if (!next) return;
+
+            // Reprise de l'état des règles dont la définition n'a pas changé (index dans l'arène du tick)
+            if (active_) {
+                std::pmr::unordered_multimap<std::string_view, const Rule*> previous(TickArena::current());
+                previous.reserve(active_->size());
+                for (const auto& rule : *active_) {
+                    if (!rule->getDefinitionKey().empty()) previous.emplace(rule->getDefinitionKey(), rule.get());
+                }
+                for (auto& rule : *next) {
+                    auto it = previous.find(rule->getDefinitionKey());
+                    if (it == previous.end()) continue;
+                    rule->adoptStateFrom(*it->second);
+                    previous.erase(it);
+                }
+            }
+            active_ = std::move(next);
+        }
     };
 
 }
@@ -0,0 +1,87 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
+#include <cmath>
+#include "RuleEngine.hpp"
+#include "AnomalyCondition.hpp"
+#include "ForecastCondition.hpp"
+#include "ActionLimiter.hpp"
+#include "../core/RuleConfig.hpp"
+#include "../core/MetricRegistry.hpp"
+
+namespace lsaa {
+
+    // Problème détecté sur une règle de la config (la règle est alors ignorée)
+    struct RuleIssue {
+        std::string rule;
+        std::string message;
+    };
+
+    // Construit les règles depuis leur définition : conditions résolues contre le registre
+    // des métriques, actions créées par les constructeurs enregistrés pour chaque actionType.
+    class RuleFactory {
+    public:
+        using ActionCtor = std::function<std::unique_ptr<IAction>(const RuleView&)>;
+
+        explicit RuleFactory(MetricRegistry& registry) : registry_(registry) {}
+
+        void registerAction(std::string type, ActionCtor ctor) {
+            actions_[std::move(type)] = std::move(ctor);
+        }
+
+        // Valide la définition et construit la règle en une seule passe. Les règles
+        // désactivées sont validées mais pas construites (nullptr, sans issue) ni abonnées
+        // à leur métrique.
+        std::unique_ptr<Rule> build(const RuleView& cfg, std::vector<RuleIssue>& issues) const {
+            size_t before = issues.size();
+            auto issue = [&](std::string msg) { issues.push_back({std::string(cfg.name), std::move(msg)}); };
+
+            if (cfg.name.empty()) issue("rule has no name");
+
+            ConditionGeneric::Operator op{};
+            ConditionAnomaly::Kind anomaly{};
+            bool isAnomaly = ConditionAnomaly::parseOperator(cfg.oper, anomaly, op);
+            bool isForecast = !isAnomaly && ConditionForecast::parseOperator(cfg.oper, op);
+            if (!isAnomaly && !isForecast && !ConditionGeneric::parseOperator(cfg.oper, op)) issue("unknown operator '" + std::string(cfg.oper) + "'");
+            if (!std::isfinite(cfg.threshold)) issue("threshold is not a finite number");
+
+            MetricHandle handle;
+            if (!registry_.resolve(std::string(cfg.metric), handle, cfg.enabled)) {
+                issue("unresolved metric '" + std::string(cfg.metric) + "'");
+            } else if (handle.descriptor.type == MetricType::TEXT) {
+                issue("metric '" + std::string(cfg.metric) + "' is text and cannot be compared to a threshold");
+            } else if (isForecast && handle.descriptor.unit != "percent") {
+                issue("'" + std::string(cfg.oper) + "' needs a percent metric, '" + std::string(cfg.metric) + "' is in " + handle.descriptor.unit);
+            }
+
+            auto ctor = actions_.find(cfg.actionType);
+            if (ctor == actions_.end()) issue("unknown action type '" + std::string(cfg.actionType) + "'");
+
+            if (issues.size() != before || !cfg.enabled) return nullptr;
+
+            auto action = ctor->second(cfg);
+            if (!action) {
+                issue("action '" + std::string(cfg.actionType) + "' rejected its parameter");
+                return nullptr;
+            }
+
+            auto rule = std::make_unique<Rule>(std::string(cfg.name));
+            if (isAnomaly) rule->setCondition(std::make_unique<ConditionAnomaly>(handle, anomaly, op, cfg.threshold));
+            else if (isForecast) rule->setCondition(std::make_unique<ConditionForecast>(handle, op, cfg.threshold));
+            else rule->setCondition(std::make_unique<ConditionGeneric>(handle, op, cfg.threshold));
+            // Déduplication et limitation de débit (ActionLimiter), clé (règle, action, paramètre)
+            std::string limiterKey = std::string(cfg.name) + '\x1f' + std::string(cfg.actionType) + '\x1f' + std::string(cfg.actionParam);
+            rule->setAction(std::make_unique<ActionLimited>(std::string(cfg.actionType), std::move(limiterKey), std::move(action)));
+            rule->setDefinitionKey(ruleDefinitionKey(cfg));
+            return rule;
+        }
+
+    private:
+        MetricRegistry& registry_;
+        std::map<std::string, ActionCtor, std::less<>> actions_;
+    };
+
+}
@@ -0,0 +1,147 @@
+// lsaa-events : interroge le journal binaire des fronts de règles (dossier events/ de lsaa-core).
+// Usage : lsaa-events [summary|top [N]|list] [--dir events] [--since 7d|24h|30m]
+//                     [--from "YYYY-MM-DD[ HH:MM[:SS]]"] [--to ...] [--rule NAME]
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <limits>
+#include <string>
+#include "core/EventJournal.hpp"
+
+namespace {
+
+    int usage() {
+        std::cerr << "Usage: lsaa-events [summary|top [N]|list] [--dir events] [--since 7d|24h|30m]" << std::endl
+                  << "                   [--from \"YYYY-MM-DD[ HH:MM[:SS]]\"] [--to ...] [--rule NAME]" << std::endl;
+        return 2;
+    }
+
+    // Heure locale ("2026-10-01", "2026-10-01 08:30", "2026-10-01 08:30:15") ou durée relative à maintenant
+    bool parseTime(const std::string& text, int64_t nowUs, int64_t& out) {
+        char unit = 0;
+        double amount = 0.0;
+        int consumed = 0;
+        if (std::sscanf(text.c_str(), "%lf%c%n", &amount, &unit, &consumed) == 2 && consumed == (int)text.size()) {
+            double seconds = unit == 'd' ? 86400.0 : unit == 'h' ? 3600.0 : unit == 'm' ? 60.0 : unit == 's' ? 1.0 : 0.0;
+            if (seconds == 0.0) return false;
+            out = nowUs - (int64_t)(amount * seconds * 1e6);
+            return true;
+        }
+        std::tm tm{};
+        int fields = std::sscanf(text.c_str(), "%d-%d-%d %d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+                                 &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+        if (fields != 3 && fields < 5) return false;
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+        tm.tm_isdst = -1;
+        std::time_t t = std::mktime(&tm);
+        if (t == (std::time_t)-1) return false;
+        out = (int64_t)t * 1000000;
+        return true;
+    }
+
+    std::string formatTime(int64_t us) {
+        std::time_t t = (std::time_t)(us / 1000000);
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &t);
+#else
+        localtime_r(&t, &local);
+#endif
+        char buf[32];
+        std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &local);
+        return buf;
+    }
+
+    std::string formatDuration(int64_t us) {
+        char buf[32];
+        double s = (double)us / 1e6;
+        if (s < 60.0) std::snprintf(buf, sizeof(buf), "%.1fs", s);
+        else if (s < 3600.0) std::snprintf(buf, sizeof(buf), "%.1fm", s / 60.0);
+        else std::snprintf(buf, sizeof(buf), "%.1fh", s / 3600.0);
+        return buf;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    std::string dir = "events";
+    std::string command = "summary";
+    std::string ruleName;
+    size_t top = 10;
+    const int64_t nowUs = lsaa::eventTimeNow();
+    int64_t from = std::numeric_limits<int64_t>::min();
+    int64_t to = std::numeric_limits<int64_t>::max();
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--dir" && i + 1 < argc) dir = argv[++i];
+        else if ((arg == "--since" || arg == "--from") && i + 1 < argc) {
+            if (!parseTime(argv[++i], nowUs, from)) return usage();
+        }
+        else if (arg == "--to" && i + 1 < argc) {
+            if (!parseTime(argv[++i], nowUs, to)) return usage();
+        }
+        else if (arg == "--rule" && i + 1 < argc) ruleName = argv[++i];
+        else if (arg == "summary" || arg == "list") command = arg;
+        else if (arg == "top") {
+            command = arg;
+            if (i + 1 < argc && argv[i + 1][0] >= '0' && argv[i + 1][0] <= '9') top = (size_t)std::max(1, std::atoi(argv[++i]));
+        }
+        else return usage();
+    }
+
+    lsaa::EventJournalReader reader;
+    if (!reader.open(dir)) {
+        std::cerr << "No event journal in " << dir << std::endl;
+        return 1;
+    }
+    uint32_t rule = lsaa::kNoEventName;
+    if (!ruleName.empty() && (rule = reader.find(ruleName)) == lsaa::kNoEventName) {
+        std::cerr << "Rule never recorded: " << ruleName << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (command == "list") {
+        size_t shown = 0;
+        size_t scanned = reader.forEach(from, to, [&](const lsaa::EventRecord& r) {
+            if (rule != lsaa::kNoEventName && r.rule != rule) return;
+            bool triggered = r.transition == (uint8_t)lsaa::EventTransition::TRIGGERED;
+            std::cout << formatTime(r.timeUs) << "  " << std::left << std::setw(28) << reader.name(r.rule)
+                      << std::setw(10) << (triggered ? "triggered" : "cleared") << std::right;
+            if (!std::isnan(r.value)) std::cout << " value=" << std::fixed << std::setprecision(2) << r.value;
+            if (triggered) {
+                std::cout << "  " << reader.name(r.action) << " -> " << lsaa::outcomeName((lsaa::ActionOutcome)r.outcome);
+                if (r.outcome == (uint8_t)lsaa::ActionOutcome::RUN) std::cout << " in " << r.latencyUs << " us";
+            }
+            std::cout << std::endl;
+            shown++;
+        });
+        std::cout << std::endl << shown << " events (" << scanned << "/" << reader.segmentCount() << " segments read)" << std::endl;
+        return 0;
+    }
+
+    auto stats = lsaa::summarizeEvents(reader, from, to, rule);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (command == "top" && stats.size() > top) stats.resize(top);
+
+    std::cout << std::left << std::setw(28) << "Rule" << std::right << std::setw(10) << "Triggers"
+              << std::setw(10) << "Active" << std::setw(10) << "Longest" << std::setw(10) << "Actions"
+              << std::setw(12) << "Suppressed" << std::setw(13) << "Latency(us)" << std::setw(12) << "Max value" << std::endl;
+    for (const auto& s : stats) {
+        std::cout << std::left << std::setw(28) << reader.name(s.rule) << std::right << std::setw(10) << s.triggers
+                  << std::setw(10) << formatDuration(s.activeUs) << std::setw(10) << formatDuration(s.longestUs)
+                  << std::setw(10) << s.actionsRun << std::setw(12) << s.actionsSuppressed
+                  << std::setw(13) << (s.actionsRun ? s.latencyUs / s.actionsRun : 0) << std::setw(12);
+        if (std::isnan(s.maxValue)) std::cout << "-";
+        else std::cout << std::fixed << std::setprecision(2) << s.maxValue;
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << stats.size() << " rules, queried in " << std::fixed << std::setprecision(1) << ms << " ms" << std::endl;
+    return 0;
+}
@@ -1,5 +1,10 @@
 #pragma once
 #include <GLFW/glfw3.h>
+#ifdef _WIN32
+#define GLFW_EXPOSE_NATIVE_WIN32
+#include <GLFW/glfw3native.h>
+#include <dwmapi.h>
+#endif
 #include <imgui.h>
 #include <backends/imgui_impl_glfw.h>
 #include <backends/imgui_impl_opengl3.h>
@@ -9,16 +14,28 @@
 #include <functional>
 #include <filesystem>
 #include <map>
+#include <set>
+#include <mutex>
 #include <algorithm>
 #include <memory> 
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <cstring>
+#include <string_view>
 
 #include "../core/Logger.hpp"
 #include "../core/ConfigManager.hpp"
 #include "../core/Lang.hpp"
+#include "../core/Tracer.hpp"
+#include "../core/EngineSnapshot.hpp"
+#include "../core/LogIndex.hpp"
 #include "../modules/Cleaner.hpp"
-#include "../modules/StartupManager.hpp"
-#include "../modules/ServiceManager.hpp"
+#include "../modules/StartupAnalyzer.hpp"
+#include "../modules/ServiceRefresher.hpp"
+#include "../modules/ServiceBatch.hpp"
 #include "../monitors/ProcessMonitor.hpp" // Required for ProcessInfo
+#include "ProcessTable.hpp"
 
 namespace lsaa {
 
@@ -42,6 +59,8 @@ namespace lsaa {
             
             glfwMakeContextCurrent(window_);
             glfwSwapInterval(1); 
+            // Avant ImGui_ImplGlfw : ImGui chaîne ses callbacks sur les nôtres
+            installWakeCallbacks();
 
             IMGUI_CHECKVERSION();
             ImGui::CreateContext();
@@ -56,13 +75,59 @@ namespace lsaa {
             ImGui_ImplOpenGL3_Init(glsl_version);
             
             cleaner_ = std::make_unique<Cleaner>();
+            initialized_ = true;
             return true;
         }
 
         bool shouldClose() { return glfwWindowShouldClose(window_); }
-        
+
+        // --- RENDU A LA DEMANDE ---
+        // Pas de boucle à 60 FPS : la boucle principale dort dans waitEvents() jusqu'à une
+        // entrée utilisateur, un tick du moteur (wake()) ou l'échéance. Une image n'est
+        // dessinée que si les données ont changé ou après une entrée (quelques images,
+        // le temps que survol et animations d'ImGui se stabilisent). Fenêtre réduite ou
+        // masquée : aucune image.
+        static constexpr int kFramesAfterInput = 3;
+        static constexpr double kIdleTimeout = 5.0;
+        static constexpr double kTextCursorTimeout = 0.5; // Clignotement du curseur de saisie
+
+        // Thread-safe : réveille waitEvents() (appelé par le moteur à chaque tick)
+        static void wake() {
+            if (instance().initialized_) glfwPostEmptyEvent();
+        }
+
+        // Fenêtre invisible : les images demandées sont abandonnées (sinon la boucle tourne à vide
+        // sans jamais les dessiner) ; la restauration en redemande via les callbacks.
+        void waitEvents() {
+            if (!visible()) {
+                pendingFrames_ = 0;
+                glfwWaitEvents();
+            }
+            else if (pendingFrames_ > 0) glfwPollEvents();
+            else glfwWaitEventsTimeout(ImGui::GetIO().WantTextInput ? kTextCursorTimeout : kIdleTimeout);
+        }
+
+        // Vrai si une image doit être dessinée après waitEvents()
+        bool frameNeeded(bool dataChanged) {
+            if (!visible()) {
+                pendingFrames_ = 0;
+                if (processMonitor_) processMonitor_->setDetailed(false);
+                return false;
+            }
+            if (ImGui::GetIO().WantTextInput) return true;
+            if (pendingFrames_ > 0) {
+                pendingFrames_--;
+                return true;
+            }
+            // Nouvelle liste publiée par le ServiceRefresher pendant que l'onglet est affiché
+            if (activeTab_ == 1 && serviceRefresher_ && serviceRefresher_->version() != servicesVersion_) return true;
+            if (activeTab_ == 1 && serviceBatchDone_.exchange(false)) return true;
+            // Lignes indexées ou résultats de recherche arrivés en arrière-plan
+            if (activeTab_ == 6 && logIndex_ && (logIndex_->version() != logIndexVersion_ || logSearch_.version() != logSearchVersion_)) return true;
+            return dataChanged;
+        }
+
         void beginFrame() { 
-            glfwPollEvents(); 
             ImGui_ImplOpenGL3_NewFrame(); 
             ImGui_ImplGlfw_NewFrame(); 
             ImGui::NewFrame(); 
@@ -81,6 +146,7 @@ namespace lsaa {
         }
 
         void cleanup() { 
+            initialized_ = false;
             ImGui_ImplOpenGL3_Shutdown(); 
             ImGui_ImplGlfw_Shutdown(); 
             ImGui::DestroyContext(); 
@@ -97,8 +163,6 @@ namespace lsaa {
                           std::function<void()> onSendNotification,
                           std::function<void()> onReloadEngine) 
         {
-             updateHistory(cpu, ramUsed, ramTotal);
-
              // Fullscreen Window
              const ImGuiViewport* viewport = ImGui::GetMainViewport();
              ImGui::SetNextWindowPos(viewport->WorkPos);
@@ -133,6 +197,8 @@ namespace lsaa {
              renderNavItem(Lang::instance().get("OPTIMIZER"), 2);
              renderNavItem(Lang::instance().get("RULES"), 3);
              renderNavItem(Lang::instance().get("STARTUP"), 4);
+             renderNavItem(Lang::instance().get("PROCESSES"), 5);
+             renderNavItem(Lang::instance().get("LOG_EXPLORER"), 6);
 
              // Bottom Sidebar info
              ImGui::SetCursorPosY(ImGui::GetWindowHeight() - 100);
@@ -141,8 +207,13 @@ namespace lsaa {
              ImGui::Dummy(ImVec2(0, 10));
              
              // Lang Toggle
-             if (ImGui::Button(Lang::instance().getLanguage() == Language::EN ? "EN / FR" : "FR / EN", ImVec2(80, 25))) {
-                 Lang::instance().toggle();
+             {
+                 Lang& lang = Lang::instance();
+                 size_t cur = lang.getLanguage();
+                 char label[64];
+                 snprintf(label, sizeof(label), "%s / %s###lang", lang.code(cur), lang.code((cur + 1) % lang.languageCount()));
+                 if (ImGui::Button(label, ImVec2(80, 25))) lang.toggle();
+                 if (ImGui::IsItemHovered()) ImGui::SetTooltip("%s", lang.name(cur));
              }
              ImGui::TextColored(ImVec4(1.0f, 1.0f, 1.0f, 0.2f), "v1.0.0-beta");
              ImGui::Unindent(20);
@@ -158,6 +229,9 @@ namespace lsaa {
 
              ImGui::Dummy(ImVec2(0, 10));
              
+             // CPU/E-S par processus : collectés seulement quand l'explorateur est affiché
+             if (processMonitor_) processMonitor_->setDetailed(activeTab_ == 5);
+
              // Switch content based on active tab
              switch (activeTab_) {
                  case 0:
@@ -175,6 +249,12 @@ namespace lsaa {
                  case 4:
                      renderStartupManager();
                      break;
+                 case 5:
+                     renderProcessExplorer(onKillProcess);
+                     break;
+                 case 6:
+                     renderLogExplorer();
+                     break;
              }
 
              ImGui::EndChild(); // End Content
@@ -182,7 +262,63 @@ namespace lsaa {
              ImGui::End(); // End Main Window
         }
 
+        // Un échantillon par tick du moteur, indépendamment du nombre d'images
+        void updateHistory(double cpu, long long ramUsed, long long ramTotal) {
+             if (historyCpu_.size() > 120) historyCpu_.erase(historyCpu_.begin());
+             historyCpu_.push_back((float)cpu);
+             float ramPercent = 0.0f;
+             if (ramTotal > 0) ramPercent = (float)((double)ramUsed / (double)ramTotal * 100.0);
+             if (historyRam_.size() > 120) historyRam_.erase(historyRam_.begin());
+             historyRam_.push_back(ramPercent);
+        }
+
+        // Source de l'explorateur de processus (mode détaillé actif seulement sur cet onglet)
+        void attachProcessMonitor(ProcessMonitor* monitor) { processMonitor_ = monitor; }
+
+        // Rapport "coût au démarrage" affiché dans l'onglet Démarrage
+        void attachStartupAnalyzer(std::shared_ptr<StartupAnalyzer> analyzer) { startupAnalyzer_ = std::move(analyzer); }
+
+        // Sources de l'onglet Services : énumération en arrière-plan et commandes groupées
+        void attachServices(std::shared_ptr<ServiceRefresher> refresher, std::shared_ptr<ServiceBatch> batch) {
+            serviceRefresher_ = std::move(refresher);
+            serviceBatch_ = std::move(batch);
+        }
+
+        // Journal parcouru par l'onglet Journal (indexé à la première ouverture)
+        void attachLogIndex(std::shared_ptr<LogIndex> index) {
+            logSearch_.clear();
+            logIndex_ = std::move(index);
+        }
+
+        // Liste partagée avec le snapshot du moteur (immuable, pas de copie)
+        void setRuleEvents(std::shared_ptr<const std::vector<RuleEvent>> events) { ruleEvents_ = std::move(events); }
+
+        // Panneau "coût de l'agent" : valeurs lsaa_* publiées par SelfMonitor
+        void updateAgentStats(const MetricsMap& metrics) {
+            agentStages_.clear();
+            auto number = [&](const std::string& key) {
+                double v = 0.0;
+                if (auto it = metrics.find(key); it != metrics.end()) metricAsDouble(it->second, v);
+                return v;
+            };
+            agentCpu_ = number("lsaa_cpu_percent");
+            agentRss_ = number("lsaa_rss_bytes");
+            for (const auto& [name, value] : metrics) {
+                auto p50 = name.find("_p50_us");
+                if (name.rfind("lsaa_", 0) != 0 || p50 == std::string::npos) continue;
+                std::string suffix = name.substr(p50 + 7);
+                agentStages_.push_back({name.substr(5, p50 - 5) + suffix, number(name),
+                                        number(name.substr(0, p50) + "_p99_us" + suffix)});
+            }
+        }
+
     private:
+        struct AgentStage {
+            std::string stage;
+            double p50us;
+            double p99us;
+        };
+
         int activeTab_ = 0;
         std::unique_ptr<Cleaner> cleaner_;
         Cleaner::ScanResult lastScan_ = {0, 0};
@@ -191,6 +327,47 @@ namespace lsaa {
         std::vector<float> historyCpu_;
         std::vector<float> historyRam_;
 
+        std::shared_ptr<const std::vector<RuleEvent>> ruleEvents_;
+
+        // Process explorer
+        ProcessMonitor* processMonitor_ = nullptr;
+        ProcessTable processTable_;
+        char processFilter_[128] = {};
+
+        std::shared_ptr<StartupAnalyzer> startupAnalyzer_;
+
+        // Services
+        std::shared_ptr<ServiceRefresher> serviceRefresher_;
+        std::shared_ptr<ServiceBatch> serviceBatch_;
+        std::set<std::string> serviceSelected_;
+        std::vector<ServiceRequest> pendingServiceRequests_;
+        std::mutex serviceBatchMutex_; // serviceBusy_ et serviceResults_ (écrits par le thread de ServiceBatch)
+        std::set<std::string> serviceBusy_;
+        std::vector<ServiceResult> serviceResults_;
+        std::atomic<bool> serviceBatchDone_{false};
+        uint64_t servicesVersion_ = 0;
+        char serviceSearch_[128] = {};
+        char serviceNeedle_[128] = {};
+        size_t serviceNeedleLength_ = 0;
+
+        // Log explorer
+        std::shared_ptr<LogIndex> logIndex_;
+        LogSearch logSearch_;
+        bool logSearchActive_ = false;
+        uint64_t logIndexVersion_ = 0;
+        uint64_t logSearchVersion_ = 0;
+        size_t logTop_ = 0;    // Première ligne affichée (index ou résultats)
+        bool logFollow_ = true; // Suit la fin du fichier
+        unsigned logLevels_ = LogQuery::kAllLevels;
+        char logText_[128] = {};
+        char logFrom_[32] = {};
+        char logTo_[32] = {};
+
+        // Agent self-profiling
+        double agentCpu_ = 0.0;
+        double agentRss_ = 0.0;
+        std::vector<AgentStage> agentStages_;
+
         // --- COMPONENTS & THEME ---
 
         void renderNavItem(const char* label, int index) {
@@ -359,6 +536,35 @@ namespace lsaa {
                  if (ImGui::Button(Lang::instance().get("TEST_NOTIF"), ImVec2(-1, 50))) if (onSendNotification) onSendNotification();
                  
                  ImGui::PopStyleColor(2);
+
+                 // Agent overhead (p50 / p99 par étape du tick)
+                 ImGui::Dummy(ImVec2(0, 20));
+                 ImGui::TextColored(ImVec4(1, 1, 1, 0.8f), Lang::instance().get("AGENT_OVERHEAD"));
+                 ImGui::TextColored(ImVec4(1, 1, 1, 0.4f), "CPU %.2f%%  |  RSS %.1f MB", agentCpu_, agentRss_ / 1024.0 / 1024.0);
+                 ImGui::Dummy(ImVec2(0, 5));
+                 if (ImGui::BeginTable("table_agent", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_NoBordersInBody)) {
+                     ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthStretch);
+                     ImGui::TableSetupColumn("p50", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                     ImGui::TableSetupColumn("p99", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                     ImGui::TableHeadersRow();
+                     for (const auto& st : agentStages_) {
+                         ImGui::TableNextRow();
+                         ImGui::TableNextColumn(); ImGui::TextDisabled("%s", st.stage.c_str());
+                         ImGui::TableNextColumn(); ImGui::Text("%.0f us", st.p50us);
+                         ImGui::TableNextColumn(); ImGui::Text("%.0f us", st.p99us);
+                     }
+                     ImGui::EndTable();
+                 }
+#ifdef LSAA_ENABLE_TRACING
+                 // Chronologie des dernières secondes, à ouvrir dans ui.perfetto.dev
+                 if (Tracer::instance().enabled()) {
+                     ImGui::Dummy(ImVec2(0, 5));
+                     if (ImGui::SmallButton(Lang::instance().get("SAVE_TRACE"))) {
+                         if (Tracer::instance().writeChromeJson("lsaa-trace.json")) LSAA_LOG_INFO("Trace saved to lsaa-trace.json");
+                         else LSAA_LOG_ERROR("Cannot write lsaa-trace.json");
+                     }
+                 }
+#endif
              }
              EndCard();
              ImGui::EndChild();
@@ -372,22 +578,64 @@ namespace lsaa {
              ImGui::Dummy(ImVec2(0, 20));
 
              BeginCard("ServicesList", 0.0f);
-             static std::vector<ServiceInfo> services = ServiceManager::getServices();
-             static std::string filter = "";
+             // Liste publiée par le ServiceRefresher : aucune énumération sur le thread GUI
+             std::shared_ptr<const ServiceList> list = serviceRefresher_ ? serviceRefresher_->snapshot() : nullptr;
+             if (list) servicesVersion_ = list->version;
 
              ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(1.0f, 1.0f, 1.0f, 0.1f));
-             if (ImGui::Button("Refresh", ImVec2(120, 35))) services = ServiceManager::getServices();
+             if (ImGui::Button("Refresh", ImVec2(120, 35)) && serviceRefresher_) serviceRefresher_->requestRefresh();
              ImGui::PopStyleColor();
 
              ImGui::SameLine();
-             static char searchBuf[128] = "";
              ImGui::SetNextItemWidth(300);
-             if (ImGui::InputTextWithHint("##search", "Search...", searchBuf, 128)) filter = std::string(searchBuf);
+             if (ImGui::InputTextWithHint("##search", "Search...", serviceSearch_, sizeof(serviceSearch_))) {
+                 // Minuscules une fois par saisie, comparées à l'index de la liste
+                 serviceNeedleLength_ = std::strlen(serviceSearch_);
+                 std::memcpy(serviceNeedle_, serviceSearch_, serviceNeedleLength_);
+                 ServiceList::toLowerAscii(serviceNeedle_, serviceNeedleLength_);
+             }
+             std::string_view needle(serviceNeedle_, serviceNeedleLength_);
+
+             // Actions groupées sur la sélection
+             if (!serviceSelected_.empty()) {
+                 ImGui::SameLine();
+                 ImGui::TextDisabled("%zu", serviceSelected_.size());
+                 auto bulk = [&](const char* label, ServiceCommand command) {
+                     ImGui::SameLine();
+                     if (!ImGui::Button(label)) return;
+                     std::vector<ServiceRequest> requests;
+                     for (const auto& name : serviceSelected_) requests.push_back({name, command});
+                     submitServices(std::move(requests));
+                     serviceSelected_.clear();
+                 };
+                 bulk(Lang::instance().get("START_SELECTED"), ServiceCommand::START);
+                 bulk(Lang::instance().get("STOP_SELECTED"), ServiceCommand::STOP);
+                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.4f, 0.4f, 1.0f));
+                 bulk(Lang::instance().get("DISABLE_SELECTED"), ServiceCommand::DISABLE);
+                 ImGui::PopStyleColor();
+             }
+
+             // Bilan du dernier lot : état réellement atteint et latence par service
+             {
+                 std::lock_guard<std::mutex> lock(serviceBatchMutex_);
+                 if (!serviceResults_.empty()) {
+                     size_t ok = 0;
+                     long long slowest = 0;
+                     for (const auto& r : serviceResults_) {
+                         ok += r.success;
+                         slowest = std::max<long long>(slowest, r.latency.count());
+                     }
+                     ImGui::TextDisabled(Lang::instance().get("LAST_BATCH"), ok, serviceResults_.size(), slowest);
+                     for (const auto& r : serviceResults_) {
+                         if (!r.success) ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s %s: %s", ServiceManager::commandName(r.command), r.name.c_str(), r.error.c_str());
+                     }
+                 }
+             }
 
              ImGui::Dummy(ImVec2(0, 20));
 
-             if (ImGui::BeginTable("ServicesTable", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_NoBordersInBody)) {
-                // ... (Same columns as before)
+             if (list && ImGui::BeginTable("ServicesTable", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_NoBordersInBody)) {
+                ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 30.0f);
                 ImGui::TableSetupColumn(Lang::instance().get("NAME"), ImGuiTableColumnFlags_WidthFixed, 200.0f);
                 ImGui::TableSetupColumn(Lang::instance().get("DISPLAY_NAME"), ImGuiTableColumnFlags_WidthStretch);
                 ImGui::TableSetupColumn(Lang::instance().get("PID"), ImGuiTableColumnFlags_WidthFixed, 60.0f);
@@ -395,21 +643,20 @@ namespace lsaa {
                 ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed, 100.0f);
                 ImGui::TableHeadersRow();
 
-                for (auto& svc : services) {
-                     if (!filter.empty()) { 
-                        std::string lowerName = svc.name;
-                        std::string lowerDisplay = svc.displayName;
-                        std::string lowerFilter = filter;
-                        // Manual tolower loop with cast to fix warnings
-                        for(auto& c : lowerName) c = (char)tolower(c);
-                        for(auto& c : lowerDisplay) c = (char)tolower(c);
-                        for(auto& c : lowerFilter) c = (char)tolower(c);
-
-                        if (lowerName.find(lowerFilter) == std::string::npos && lowerDisplay.find(lowerFilter) == std::string::npos) continue;
-                     }
+                std::lock_guard<std::mutex> lock(serviceBatchMutex_);
+                for (size_t i = 0; i < list->services.size(); ++i) {
+                    if (!list->matches(i, needle)) continue;
+                    const ServiceInfo& svc = list->services[i];
 
                     ImGui::PushID(svc.name.c_str());
                     ImGui::TableNextRow(ImGuiTableRowFlags_None, 40.0f);
+
+                    ImGui::TableNextColumn();
+                    bool selected = serviceSelected_.count(svc.name) > 0;
+                    if (ImGui::Checkbox("##sel", &selected)) {
+                        if (selected) serviceSelected_.insert(svc.name);
+                        else serviceSelected_.erase(svc.name);
+                    }
                     
                     ImGui::TableNextColumn(); ImGui::TextColored(ImVec4(1,1,1,0.9f), "%s", svc.name.c_str());
                     ImGui::TableNextColumn(); ImGui::TextDisabled("%s", svc.displayName.c_str());
@@ -428,19 +675,42 @@ namespace lsaa {
                     else ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.0f, 1.0f), "%s", svc.status.c_str());
 
                     ImGui::TableNextColumn();
-                    // Clean Text Buttons for actions
-                    if (svc.canStop) {
-                        if (ImGui::SmallButton("Stop")) { ServiceManager::stopService(svc.name); svc.status = "Stopping"; svc.canStop=false; }
+                    // Clean Text Buttons for actions (service suivi par ServiceBatch jusqu'à son nouvel état)
+                    if (serviceBusy_.count(svc.name)) {
+                        ImGui::TextDisabled("...");
+                    } else if (svc.canStop) {
+                        if (ImGui::SmallButton("Stop")) pendingServiceRequests_.push_back({svc.name, ServiceCommand::STOP});
                     } else if (svc.stateCode == SERVICE_STOPPED) {
-                        if (ImGui::SmallButton("Start")) { ServiceManager::startService(svc.name); svc.status = "Starting"; }
+                        if (ImGui::SmallButton("Start")) pendingServiceRequests_.push_back({svc.name, ServiceCommand::START});
                     }
                     ImGui::PopID();
                 }
                 ImGui::EndTable();
              }
+             if (!pendingServiceRequests_.empty()) submitServices(std::move(pendingServiceRequests_));
+             pendingServiceRequests_.clear();
              EndCard();
         }
 
+        // Lot exécuté par ServiceBatch sur son thread ; à la fin : bilan, liste rafraîchie, image
+        void submitServices(std::vector<ServiceRequest> requests) {
+             if (!serviceBatch_ || requests.empty()) return;
+             {
+                 std::lock_guard<std::mutex> lock(serviceBatchMutex_);
+                 for (const auto& r : requests) serviceBusy_.insert(r.name);
+             }
+             serviceBatch_->submit(std::move(requests), [this](std::vector<ServiceResult> results) {
+                 {
+                     std::lock_guard<std::mutex> lock(serviceBatchMutex_);
+                     for (const auto& r : results) serviceBusy_.erase(r.name);
+                     serviceResults_ = std::move(results);
+                 }
+                 serviceBatchDone_ = true;
+                 if (serviceRefresher_) serviceRefresher_->requestRefresh();
+                 wake();
+             });
+        }
+
         void renderOptimizer() {
             static CleanParams params; 
             ImGui::TextColored(ImVec4(1,1,1,0.5f), "CLEANER");
@@ -505,6 +775,53 @@ namespace lsaa {
                  ImGui::EndTable();
              }
              EndCard();
+
+             if (startupAnalyzer_) {
+                 ImGui::Dummy(ImVec2(0, 20));
+                 renderBootCost(*startupAnalyzer_->report());
+             }
+        }
+
+        // Classement des éléments de démarrage par coût mesuré après l'ouverture de session
+        void renderBootCost(const StartupReport& report) {
+             BeginCard("BootCostCard");
+             ImGui::TextDisabled("%s", Lang::instance().get("BOOT_COST"));
+             ImGui::Dummy(ImVec2(0, 10));
+             int minutes = (int)report.window.count();
+             if (report.items.empty() || (report.complete && report.items.front().processes == 0 && report.timeToIdleSeconds < 0.0)) {
+                 ImGui::TextDisabled(Lang::instance().get("BOOT_UNAVAILABLE"), minutes);
+                 EndCard();
+                 return;
+             }
+             if (!report.complete) ImGui::TextColored(ImVec4(0.9f, 0.7f, 0.0f, 1.0f), Lang::instance().get("BOOT_MEASURING"), minutes);
+             if (report.timeToIdleSeconds >= 0.0) ImGui::Text(Lang::instance().get("BOOT_IDLE"), report.timeToIdleSeconds);
+             else if (report.complete) ImGui::TextDisabled(Lang::instance().get("BOOT_NOT_IDLE"), minutes);
+
+             if (ImGui::BeginTable("BootCostTable", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_NoBordersInBody)) {
+                 ImGui::TableSetupColumn(Lang::instance().get("NAME"), ImGuiTableColumnFlags_WidthStretch);
+                 ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+                 ImGui::TableSetupColumn("Read", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+                 ImGui::TableSetupColumn("Peak MEM", ImGuiTableColumnFlags_WidthFixed, 90.0f);
+                 ImGui::TableSetupColumn("Procs", ImGuiTableColumnFlags_WidthFixed, 60.0f);
+                 ImGui::TableSetupColumn("Start", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+                 ImGui::TableHeadersRow();
+                 char read[32], mem[32];
+                 for (const auto& item : report.items) {
+                     ImGui::TableNextRow();
+                     ImGui::TableNextColumn(); ImGui::TextUnformatted(item.name.c_str());
+                     if (item.processes == 0) {
+                         ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+                         continue;
+                     }
+                     ImGui::TableNextColumn(); ImGui::Text("%.1f s", item.cpuSeconds);
+                     ImGui::TableNextColumn(); formatBytes(read, sizeof(read), (double)item.readBytes, ""); ImGui::TextUnformatted(read);
+                     ImGui::TableNextColumn(); formatBytes(mem, sizeof(mem), (double)item.peakMemoryBytes, ""); ImGui::TextUnformatted(mem);
+                     ImGui::TableNextColumn(); ImGui::Text("%zu", item.processes);
+                     ImGui::TableNextColumn(); ImGui::TextDisabled("+%.0f s", item.firstSeenSeconds);
+                 }
+                 ImGui::EndTable();
+             }
+             EndCard();
         }
 
         void renderRulesEditor(std::function<void()> onReloadEngine) {
@@ -520,15 +837,205 @@ namespace lsaa {
              ImGui::Dummy(ImVec2(0, 10));
              if(ImGui::Button(Lang::instance().get("SAVE_CONFIG"), ImVec2(150, 40))) { ConfigManager::instance().save(); if(onReloadEngine) onReloadEngine(); }
              EndCard();
+
+             ImGui::Dummy(ImVec2(0, 20));
+             BeginCard("RuleEventsCard");
+             ImGui::TextDisabled("%s", Lang::instance().get("RULE_EVENTS"));
+             ImGui::Dummy(ImVec2(0, 10));
+             if (!ruleEvents_ || ruleEvents_->empty()) {
+                 ImGui::TextDisabled("%s", Lang::instance().get("NO_RULE_EVENTS"));
+             } else {
+                 // Plus récent en premier
+                 for (auto it = ruleEvents_->rbegin(); it != ruleEvents_->rend(); ++it) {
+                     std::time_t t = std::chrono::system_clock::to_time_t(it->time);
+                     std::tm local{};
+                     localtime_s(&local, &t);
+                     char when[16];
+                     std::strftime(when, sizeof(when), "%H:%M:%S", &local);
+                     ImVec4 color = it->triggered ? ImVec4(1.0f, 0.45f, 0.35f, 1.0f) : ImVec4(0.4f, 0.85f, 0.5f, 1.0f);
+                     ImGui::TextDisabled("%s", when);
+                     ImGui::SameLine();
+                     ImGui::TextColored(color, "%s", it->triggered ? Lang::instance().get("RULE_TRIGGERED") : Lang::instance().get("RULE_CLEARED"));
+                     ImGui::SameLine();
+                     ImGui::TextUnformatted(it->rule.c_str());
+                 }
+             }
+             EndCard();
         }
 
-        void updateHistory(double cpu, long long ramUsed, long long ramTotal) {
-             if (historyCpu_.size() > 120) historyCpu_.erase(historyCpu_.begin());
-             historyCpu_.push_back((float)cpu);
-             float ramPercent = 0.0f;
-             if (ramTotal > 0) ramPercent = (float)((double)ramUsed / (double)ramTotal * 100.0);
-             if (historyRam_.size() > 120) historyRam_.erase(historyRam_.begin());
-             historyRam_.push_back(ramPercent);
+        static void formatBytes(char* out, size_t size, double bytes, const char* suffix) {
+            if (bytes >= 1024.0 * 1024.0 * 1024.0) snprintf(out, size, "%.1f GB%s", bytes / (1024.0 * 1024.0 * 1024.0), suffix);
+            else if (bytes >= 1024.0 * 1024.0) snprintf(out, size, "%.1f MB%s", bytes / (1024.0 * 1024.0), suffix);
+            else snprintf(out, size, "%.0f KB%s", bytes / 1024.0, suffix);
+        }
+
+        // Tous les processus : seules les lignes visibles sont construites (ImGuiListClipper),
+        // tri et filtre tenus par ProcessTable entre deux ticks
+        void renderProcessExplorer(std::function<void(DWORD)> onKillProcess) {
+             ImGui::TextColored(ImVec4(1,1,1,0.5f), "TRIAGE");
+             ImGui::SetWindowFontScale(1.5f);
+             ImGui::Text("Process Explorer");
+             ImGui::SetWindowFontScale(1.0f);
+             ImGui::Dummy(ImVec2(0, 20));
+
+             if (processMonitor_) processTable_.update(processMonitor_->getProcessTable());
+
+             ImGui::SetNextItemWidth(300.0f);
+             if (ImGui::InputTextWithHint("##process_filter", Lang::instance().get("FILTER_PROCESSES"), processFilter_, sizeof(processFilter_))) {
+                 processTable_.setFilter(processFilter_);
+             }
+             ImGui::SameLine();
+             ImGui::TextDisabled("%zu / %zu", processTable_.size(), processTable_.total());
+             ImGui::Dummy(ImVec2(0, 10));
+
+             BeginCard("ExplorerCard");
+             ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg
+                                   | ImGuiTableFlags_Resizable | ImGuiTableFlags_NoBordersInBody;
+             if (ImGui::BeginTable("table_explorer", 7, flags)) {
+                 using Column = ProcessTable::Column;
+                 ImGui::TableSetupScrollFreeze(0, 1);
+                 ImGui::TableSetupColumn("PID", ImGuiTableColumnFlags_WidthFixed, 70.0f, (ImGuiID)Column::PID);
+                 ImGui::TableSetupColumn(Lang::instance().get("NAME"), ImGuiTableColumnFlags_WidthStretch, 0.0f, (ImGuiID)Column::NAME);
+                 ImGui::TableSetupColumn("CPU", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending, 70.0f, (ImGuiID)Column::CPU);
+                 ImGui::TableSetupColumn("MEM", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 90.0f, (ImGuiID)Column::MEMORY);
+                 ImGui::TableSetupColumn("I/O", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 100.0f, (ImGuiID)Column::IO);
+                 ImGui::TableSetupColumn("Threads", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, 70.0f, (ImGuiID)Column::THREADS);
+                 ImGui::TableSetupColumn("", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoSort, 70.0f);
+                 ImGui::TableHeadersRow();
+
+                 if (ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs(); specs && specs->SpecsDirty) {
+                     if (specs->SpecsCount > 0) {
+                         processTable_.setSort((Column)specs->Specs[0].ColumnUserID,
+                                               specs->Specs[0].SortDirection == ImGuiSortDirection_Ascending);
+                     }
+                     specs->SpecsDirty = false;
+                 }
+
+                 char mem[32], io[32];
+                 ImGuiListClipper clipper;
+                 clipper.Begin((int)processTable_.size());
+                 while (clipper.Step()) {
+                     for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                         const ProcessInfo& p = processTable_.row((size_t)i);
+                         ImGui::TableNextRow();
+                         ImGui::TableNextColumn(); ImGui::TextDisabled("%u", (unsigned)p.pid);
+                         ImGui::TableNextColumn(); ImGui::TextUnformatted(p.name.c_str());
+                         ImGui::TableNextColumn(); ImGui::Text("%.1f%%", p.cpuPercent);
+                         ImGui::TableNextColumn(); formatBytes(mem, sizeof(mem), (double)p.memoryBytes, ""); ImGui::TextUnformatted(mem);
+                         ImGui::TableNextColumn(); formatBytes(io, sizeof(io), p.ioBytesPerSecond, "/s"); ImGui::TextUnformatted(io);
+                         ImGui::TableNextColumn(); ImGui::Text("%u", p.threads);
+                         ImGui::TableNextColumn();
+                         ImGui::PushID((int)p.pid);
+                         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.4f, 0.4f, 1.0f));
+                         if (ImGui::SmallButton("KILL") && onKillProcess) onKillProcess(p.pid);
+                         ImGui::PopStyleColor();
+                         ImGui::PopID();
+                     }
+                 }
+                 ImGui::EndTable();
+             }
+             EndCard();
+        }
+
+        // Vue virtualisée : seules les lignes visibles sont lues dans la projection du fichier.
+        // Défilement par numéro de ligne (entier 64 bits), sans limite de précision sur les gros journaux.
+        void renderLogExplorer() {
+             ImGui::TextColored(ImVec4(1,1,1,0.5f), "SYSTEM");
+             ImGui::SetWindowFontScale(1.5f);
+             ImGui::Text(Lang::instance().get("LOG_EXPLORER"));
+             ImGui::SetWindowFontScale(1.0f);
+             ImGui::Dummy(ImVec2(0, 20));
+             if (!logIndex_) return;
+
+             logIndex_->start();
+             logIndexVersion_ = logIndex_->version();
+             logSearchVersion_ = logSearch_.version();
+             LogIndex::View view = logIndex_->view();
+
+             bool changed = false;
+             ImGui::SetNextItemWidth(300.0f);
+             changed |= ImGui::InputTextWithHint("##log_search", Lang::instance().get("LOG_SEARCH_HINT"), logText_, sizeof(logText_));
+             static const char* kLevels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+             for (unsigned i = 0; i < 4; ++i) {
+                 ImGui::SameLine();
+                 changed |= ImGui::CheckboxFlags(kLevels[i], &logLevels_, 1u << i);
+             }
+             ImGui::SetNextItemWidth(190.0f);
+             ImGui::InputTextWithHint("##log_from", Lang::instance().get("LOG_FROM"), logFrom_, sizeof(logFrom_));
+             ImGui::SameLine();
+             ImGui::SetNextItemWidth(190.0f);
+             ImGui::InputTextWithHint("##log_to", Lang::instance().get("LOG_TO"), logTo_, sizeof(logTo_));
+             ImGui::SameLine();
+             bool jump = ImGui::Button(Lang::instance().get("LOG_GO"));
+
+             if (changed || jump) {
+                 LogQuery query{logText_, logLevels_, parseLogTime(logFrom_), parseLogTime(logTo_)};
+                 logTop_ = 0;
+                 logFollow_ = false;
+                 logSearchActive_ = query.filters();
+                 if (logSearchActive_) {
+                     logSearch_.start(logIndex_, std::move(query));
+                 } else {
+                     logSearch_.clear();
+                     // Sans filtre : saut direct à la première ligne de la plage
+                     if (query.from) logTop_ = logIndex_->lineAtTime(view, query.from);
+                     else logFollow_ = true;
+                 }
+             }
+
+             const double mb = 1024.0 * 1024.0;
+             if (view.bytes < view.fileBytes) {
+                 ImGui::TextDisabled(Lang::instance().get("LOG_INDEXING"), view.bytes / mb, view.fileBytes / mb);
+             } else {
+                 ImGui::TextDisabled(Lang::instance().get("LOG_LINES"), view.lines, view.bytes / mb);
+             }
+             LogSearch::Progress progress = logSearch_.progress();
+             if (logSearchActive_) {
+                 ImGui::SameLine();
+                 double scanned = progress.total ? 100.0 * (double)progress.scanned / (double)progress.total : 100.0;
+                 ImGui::TextDisabled(Lang::instance().get("LOG_HITS"), progress.hits, scanned, progress.ms);
+                 if (progress.truncated) {
+                     ImGui::SameLine();
+                     ImGui::TextColored(ImVec4(1.0f, 0.7f, 0.3f, 1.0f), "%s", Lang::instance().get("LOG_TRUNCATED"));
+                 }
+             }
+
+             BeginCard("LogLines");
+             const size_t rows = logSearchActive_ ? progress.hits : view.lines;
+             const float lineHeight = ImGui::GetTextLineHeightWithSpacing();
+             const ImVec2 avail = ImGui::GetContentRegionAvail();
+             const size_t visible = std::max<size_t>(1, (size_t)(avail.y / lineHeight));
+             const size_t maxTop = rows > visible ? rows - visible : 0;
+             if (logFollow_ && !logSearchActive_) logTop_ = maxTop;
+             logTop_ = std::min(logTop_, maxTop);
+
+             ImGui::BeginChild("log_rows", ImVec2(avail.x - 24.0f, avail.y), false,
+                               ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoScrollWithMouse);
+             if (ImGui::IsWindowHovered() && ImGui::GetIO().MouseWheel != 0.0f) {
+                 long long step = (long long)(-ImGui::GetIO().MouseWheel * 3.0f);
+                 logTop_ = (size_t)std::clamp<long long>((long long)logTop_ + step, 0, (long long)maxTop);
+             }
+             auto drawLine = [](std::string_view text) {
+                 int level = parseLogLevel(text);
+                 ImVec4 color = level == 3 ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f)
+                              : level == 2 ? ImVec4(1.0f, 0.75f, 0.3f, 1.0f)
+                              : level == 0 ? ImVec4(1.0f, 1.0f, 1.0f, 0.4f)
+                                           : ImVec4(1.0f, 1.0f, 1.0f, 0.85f);
+                 ImGui::PushStyleColor(ImGuiCol_Text, color);
+                 ImGui::TextUnformatted(text.data(), text.data() + std::min<size_t>(text.size(), 512));
+                 ImGui::PopStyleColor();
+             };
+             if (logSearchActive_) logSearch_.forEachResult(logTop_, visible, drawLine);
+             else logIndex_->forEachLine(view, logTop_, visible, [&](size_t, std::string_view text) { drawLine(text); });
+             ImGui::EndChild();
+
+             ImGui::SameLine();
+             uint64_t inverted = maxTop - logTop_, zero = 0, top = maxTop;
+             if (ImGui::VSliderScalar("##log_scroll", ImVec2(16.0f, avail.y), ImGuiDataType_U64, &inverted, &zero, &top, "")) {
+                 logTop_ = (size_t)(maxTop - inverted);
+             }
+             logFollow_ = logTop_ >= maxTop;
+             EndCard();
         }
 
         void applyElegantTheme() {
@@ -596,5 +1103,36 @@ namespace lsaa {
         ~GuiManager() = default;
 
         GLFWwindow* window_ = nullptr;
+        std::atomic<bool> initialized_{false};
+        int pendingFrames_ = kFramesAfterInput;
+
+        // Toute entrée (souris, clavier, redimensionnement, focus) demande quelques images
+        void installWakeCallbacks() {
+            glfwSetCursorPosCallback(window_, [](GLFWwindow*, double, double) { instance().requestFrames(); });
+            glfwSetMouseButtonCallback(window_, [](GLFWwindow*, int, int, int) { instance().requestFrames(); });
+            glfwSetScrollCallback(window_, [](GLFWwindow*, double, double) { instance().requestFrames(); });
+            glfwSetKeyCallback(window_, [](GLFWwindow*, int, int, int, int) { instance().requestFrames(); });
+            glfwSetCharCallback(window_, [](GLFWwindow*, unsigned int) { instance().requestFrames(); });
+            glfwSetWindowFocusCallback(window_, [](GLFWwindow*, int) { instance().requestFrames(); });
+            glfwSetCursorEnterCallback(window_, [](GLFWwindow*, int) { instance().requestFrames(); });
+            glfwSetFramebufferSizeCallback(window_, [](GLFWwindow*, int, int) { instance().requestFrames(); });
+            glfwSetWindowRefreshCallback(window_, [](GLFWwindow*) { instance().requestFrames(); });
+            glfwSetWindowIconifyCallback(window_, [](GLFWwindow*, int) { instance().requestFrames(); });
+        }
+
+        void requestFrames() { pendingFrames_ = kFramesAfterInput; }
+
+        // Réduite, cachée, de taille nulle ou masquée par DWM (autre bureau virtuel)
+        bool visible() const {
+            if (glfwGetWindowAttrib(window_, GLFW_ICONIFIED) || !glfwGetWindowAttrib(window_, GLFW_VISIBLE)) return false;
+            int w = 0, h = 0;
+            glfwGetFramebufferSize(window_, &w, &h);
+            if (w == 0 || h == 0) return false;
+#ifdef _WIN32
+            DWORD cloaked = 0;
+            if (SUCCEEDED(DwmGetWindowAttribute(glfwGetWin32Window(window_), DWMWA_CLOAKED, &cloaked, sizeof(cloaked))) && cloaked) return false;
+#endif
+            return true;
+        }
     };
 }
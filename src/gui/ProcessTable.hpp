@@ -0,0 +1,155 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "../core/EngineSnapshot.hpp"
+
+namespace lsaa {
+
+    // Modèle de l'explorateur de processus : ordre de tri et filtre sur la table publiée
+    // par ProcessMonitor (mode détaillé). La vue n'affiche que les lignes visibles.
+    //
+    // - Tri incrémental : l'ordre du tick précédent est repris (par PID), seules les lignes
+    //   qui ne sont plus à leur place sont retriées puis refusionnées.
+    // - Filtre : noms en minuscules calculés une fois par tick ; une saisie qui prolonge
+    //   le filtre précédent ne reparcourt que les lignes déjà retenues.
+    class ProcessTable {
+    public:
+        enum class Column { PID, NAME, CPU, MEMORY, IO, THREADS };
+
+        void update(std::shared_ptr<const std::vector<ProcessInfo>> data) {
+            if (!data || data == data_) return;
+            data_ = std::move(data);
+            const auto& rows = *data_;
+
+            lowerNames_.resize(rows.size());
+            for (size_t i = 0; i < rows.size(); ++i) lower(rows[i].name, lowerNames_[i]);
+
+            // Ordre précédent (par PID) puis nouveaux processus en fin de liste
+            rowOf_.clear();
+            rowOf_.reserve(rows.size());
+            for (size_t i = 0; i < rows.size(); ++i) rowOf_.emplace(rows[i].pid, (uint32_t)i);
+            std::vector<bool> placed(rows.size(), false);
+            std::vector<uint32_t> order;
+            order.reserve(rows.size());
+            for (DWORD pid : orderPids_) {
+                auto it = rowOf_.find(pid);
+                if (it == rowOf_.end()) continue;
+                order.push_back(it->second);
+                placed[it->second] = true;
+            }
+            for (size_t i = 0; i < rows.size(); ++i) {
+                if (!placed[i]) order.push_back((uint32_t)i);
+            }
+            order_.swap(order);
+            repairOrder();
+            refilter(false);
+        }
+
+        void setSort(Column column, bool ascending) {
+            if (column == column_ && ascending == ascending_) return;
+            column_ = column;
+            ascending_ = ascending;
+            if (!data_) return;
+            std::sort(order_.begin(), order_.end(), [this](uint32_t a, uint32_t b) { return less(a, b); });
+            rememberOrder();
+            refilter(false);
+        }
+
+        void setFilter(std::string_view text) {
+            std::string needle;
+            lower(text, needle);
+            if (needle == filter_) return;
+            bool narrowing = !filter_.empty() && needle.find(filter_) != std::string::npos;
+            filter_ = std::move(needle);
+            refilter(narrowing);
+        }
+
+        size_t size() const { return visible_.size(); }
+        size_t total() const { return data_ ? data_->size() : 0; }
+        const ProcessInfo& row(size_t visibleIndex) const { return (*data_)[visible_[visibleIndex]]; }
+
+    private:
+        std::shared_ptr<const std::vector<ProcessInfo>> data_;
+        std::vector<std::string> lowerNames_;
+        std::vector<uint32_t> order_;    // Indices dans data_, triés
+        std::vector<DWORD> orderPids_;   // Le même ordre, par PID, pour le tick suivant
+        std::vector<uint32_t> visible_;  // order_ filtré
+        std::vector<uint32_t> kept_, moved_;
+        std::unordered_map<DWORD, uint32_t> rowOf_;
+        std::string filter_;
+        Column column_ = Column::CPU;
+        bool ascending_ = false;
+
+        static void lower(std::string_view in, std::string& out) {
+            out.resize(in.size());
+            for (size_t i = 0; i < in.size(); ++i) {
+                char c = in[i];
+                out[i] = (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+            }
+        }
+
+        bool less(uint32_t a, uint32_t b) const {
+            const ProcessInfo& x = (*data_)[a];
+            const ProcessInfo& y = (*data_)[b];
+            auto cmp = [&](auto u, auto v) {
+                if (u != v) return ascending_ ? u < v : u > v;
+                return x.pid < y.pid; // Ordre total : pas de lignes qui s'échangent d'un tick à l'autre
+            };
+            switch (column_) {
+                case Column::PID: return ascending_ ? x.pid < y.pid : x.pid > y.pid;
+                case Column::NAME: {
+                    int c = lowerNames_[a].compare(lowerNames_[b]);
+                    if (c != 0) return ascending_ ? c < 0 : c > 0;
+                    return x.pid < y.pid;
+                }
+                case Column::CPU: return cmp(x.cpuPercent, y.cpuPercent);
+                case Column::MEMORY: return cmp(x.memoryBytes, y.memoryBytes);
+                case Column::IO: return cmp(x.ioBytesPerSecond, y.ioBytesPerSecond);
+                case Column::THREADS: return cmp(x.threads, y.threads);
+            }
+            return false;
+        }
+
+        // Les lignes restées en ordre forment une suite triée ; les autres (valeur qui a
+        // changé, nouveaux processus) sont triées à part puis fusionnées : O(n + m log m)
+        void repairOrder() {
+            auto cmp = [this](uint32_t a, uint32_t b) { return less(a, b); };
+            kept_.clear();
+            moved_.clear();
+            for (size_t i = 0; i < order_.size(); ++i) {
+                uint32_t v = order_[i];
+                bool outOfPlace = (!kept_.empty() && less(v, kept_.back())) ||
+                                  (i + 1 < order_.size() && less(order_[i + 1], v));
+                (outOfPlace ? moved_ : kept_).push_back(v);
+            }
+            std::sort(moved_.begin(), moved_.end(), cmp);
+            std::merge(kept_.begin(), kept_.end(), moved_.begin(), moved_.end(), order_.begin(), cmp);
+            rememberOrder();
+        }
+
+        void rememberOrder() {
+            orderPids_.resize(order_.size());
+            for (size_t i = 0; i < order_.size(); ++i) orderPids_[i] = (*data_)[order_[i]].pid;
+        }
+
+        void refilter(bool narrowing) {
+            if (filter_.empty()) {
+                visible_ = order_;
+                return;
+            }
+            const std::vector<uint32_t>& source = narrowing ? visible_ : order_;
+            std::vector<uint32_t> next;
+            next.reserve(source.size());
+            for (uint32_t i : source) {
+                if (lowerNames_[i].find(filter_) != std::string::npos) next.push_back(i);
+            }
+            visible_.swap(next);
+        }
+    };
+
+}
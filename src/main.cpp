@@ -1,22 +1,46 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <cstdlib>
 #include "core/Engine.hpp"
 #include "monitors/ProcessMonitor.hpp"
 #include "monitors/SystemMonitor.hpp"
+#include "monitors/SelfMonitor.hpp"
+#include "monitors/DiskMonitor.hpp"
+#include "monitors/ServiceMonitor.hpp"
+#ifdef __linux__
+#include "monitors/CgroupMonitor.hpp"
+#endif
 #include "core/Logger.hpp"
 #include "core/ConfigManager.hpp"
+#include "core/FileWatcher.hpp"
+#include "core/AllocationCounter.hpp"
+#include "core/Tracer.hpp"
+#include "core/PrometheusExporter.hpp"
+#include "core/Lang.hpp"
+#include "core/EventJournal.hpp"
 #include "engine/Rule.hpp"
+#include "engine/RuleFactory.hpp"
 #include "gui/GuiManager.hpp"
 
 // Actions Lib
 #include "actions/ActionProcess.hpp"
+#include "actions/ActionRemediate.hpp"
 #include "actions/ActionScript.hpp"
 #include "actions/ActionNotification.hpp"
 
-int main() {
+// lsaa_allocations_per_tick
+LSAA_COUNT_ALLOCATIONS();
+
+int main(int argc, char** argv) {
+    lsaa::Logger::instance().init("lsaa.log");
+    // Fronts des règles et sort des actions, interrogeables avec lsaa-events
+    if (!lsaa::EventJournal::instance().open("events")) LSAA_LOG_WARN("Event journal unavailable (events/)");
     lsaa::Logger::instance().log(lsaa::LogLevel::INFO, "LSAA Core System Starting (Phase 6)");
 
+    // Langues supplémentaires (lang/*.json), en plus de l'anglais et du français intégrés
+    lsaa::Lang::instance().loadDirectory("lang");
+
     // 1. Init Engine
     lsaa::Engine engine;
 
@@ -24,72 +48,185 @@ int main() {
     // Process Monitor (Top Apps)
     auto pm = std::make_unique<lsaa::ProcessMonitor>();
     auto* pmPtr = pm.get(); // Keep raw ptr for GUI access
+    auto processIndex = pm->getIndex(); // Résolution nom -> PID des actions
+    // Coût de chaque élément de démarrage pendant les 5 premières minutes de la session,
+    // mesuré sur la table du ProcessMonitor (rien à faire si l'agent démarre plus tard)
+    auto startupAnalyzer = std::make_shared<lsaa::StartupAnalyzer>(lsaa::StartupManager::getStartupItems());
+    if (startupAnalyzer->active()) {
+        pm->setTableObserver([startupAnalyzer](const lsaa::ProcessMonitor::Table& table, lsaa::ProcessMonitor::Clock::time_point now) {
+            startupAnalyzer->observe(table, now);
+        });
+    }
     engine.addMonitor(std::move(pm));
 
     // System Monitor (CPU/RAM Global)
     engine.addMonitor(std::make_unique<lsaa::SystemMonitor>());
 
+    // Disk Monitor (espace libre et prévision de saturation par lecteur)
+    engine.addMonitor(std::make_unique<lsaa::DiskMonitor>());
+
+    // Services : énumérés en arrière-plan (onglet Services + règles service_running.<nom>)
+    auto serviceBackend = lsaa::ServiceManager::makeBackend();
+    auto services = std::make_shared<lsaa::ServiceRefresher>(serviceBackend);
+    auto serviceBatch = std::make_shared<lsaa::ServiceBatch>(serviceBackend);
+    engine.addMonitor(std::make_unique<lsaa::ServiceMonitor>(services));
+
+    // Self Monitor (coût de l'agent : CPU, RSS, allocations, latences p50/p99)
+    engine.addMonitor(std::make_unique<lsaa::SelfMonitor>());
+
+#ifdef __linux__
+    // Cgroup Monitor (limites du conteneur), plus les cgroups de LSAA_CGROUPS
+    auto cgroups = std::make_unique<lsaa::CgroupMonitor>();
+    cgroups->addFromEnvironment();
+    engine.addMonitor(std::move(cgroups));
+#endif
+
+    // --record <fichier> : trace binaire des métriques, rejouable avec lsaa-replay
+    // --trace <fichier> : chronologie Chrome/Perfetto écrite à l'arrêt (build LSAA_ENABLE_TRACING)
+    std::string tracePath;
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (std::string(argv[i]) == "--record") engine.startRecording(argv[i + 1]);
+        if (std::string(argv[i]) == "--trace") tracePath = argv[i + 1];
+    }
+    if (!tracePath.empty()) {
+#ifdef LSAA_ENABLE_TRACING
+        LSAA_TRACE_THREAD_NAME("gui");
+        lsaa::Tracer::instance().start();
+        LSAA_LOG_INFO("Tracing engine activity to " + tracePath);
+#else
+        LSAA_LOG_WARN("--trace ignored: build configured without LSAA_ENABLE_TRACING");
+        tracePath.clear();
+#endif
+    }
+
     // 4. Init GUI
     auto& gui = lsaa::GuiManager::instance();
     if (!gui.init()) {
         LSAA_LOG_ERROR("Failed to init GUI. Exiting.");
         return 1;
     }
+    gui.attachProcessMonitor(pmPtr);
+    gui.attachServices(services, serviceBatch);
+    gui.attachStartupAnalyzer(startupAnalyzer);
+    gui.attachLogIndex(std::make_shared<lsaa::LogIndex>("lsaa.log"));
+    services->setChangeListener([]() { lsaa::GuiManager::wake(); });
+    services->start();
+
+    // Fabrique de règles : métriques annoncées par les moniteurs, actions par type
+    lsaa::RuleFactory ruleFactory(engine.getMetricRegistry());
+    ruleFactory.registerAction("LOG", [](const lsaa::RuleView& cfg) {
+        return lsaa::ActionLog::fromParam(cfg.actionParam);
+    });
+    ruleFactory.registerAction("NOTIFY", [](const lsaa::RuleView& cfg) {
+        return std::make_unique<lsaa::ActionNotification>("LSAA Alert", std::string(cfg.actionParam));
+    });
+    ruleFactory.registerAction("KILL", [processIndex](const lsaa::RuleView& cfg) -> std::unique_ptr<lsaa::IAction> {
+        auto action = std::make_unique<lsaa::ActionKillProcess>(cfg.actionParam, processIndex, cfg.metric);
+        if (!action->valid()) return nullptr;
+        return action;
+    });
+    // Remédiations : "<cible> <valeur>" (cible = PID, nom, motif, @top_mem ou @rule)
+    ruleFactory.registerAction("PRIORITY", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionSetPriority::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("AFFINITY", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionSetAffinity::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("MEMORY_LIMIT", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionLimitMemory::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("TRIM", [processIndex](const lsaa::RuleView& cfg) {
+        return lsaa::ActionTrimWorkingSet::create(cfg.actionParam, processIndex, cfg.metric);
+    });
+    ruleFactory.registerAction("SCRIPT", [](const lsaa::RuleView& cfg) -> std::unique_ptr<lsaa::IAction> {
+        if (cfg.actionParam.empty()) return nullptr;
+        return std::make_unique<lsaa::ActionScript>(std::string(cfg.actionParam));
+    });
 
-    // Helper to reload rules
-    auto reloadRulesFn = [&engine]() {
+    // Helper to reload rules : jeu complet validé et construit hors du thread moteur, puis publié
+    auto reloadRulesFn = [&engine, &ruleFactory]() {
         LSAA_LOG_INFO("Hot Reloading Rules...");
-        engine.clearRules();
-        auto& rules = lsaa::ConfigManager::instance().getRules();
-        for (const auto& cfg : rules) {
-            if (!cfg.enabled) continue;
-            std::unique_ptr<lsaa::ICondition> cond;
-            if (cfg.metric == "cpu_usage_percent") cond = std::make_unique<lsaa::ConditionCPU>(cfg.threshold);
-            else if (cfg.metric == "ram_load_percent") cond = std::make_unique<lsaa::ConditionRAM>(cfg.threshold);
-            else continue; 
-            
-            std::unique_ptr<lsaa::IAction> action;
-            if (cfg.actionType == "NOTIFY") action = std::make_unique<lsaa::ActionNotification>("LSAA Alert", cfg.actionParam);
-            else continue; 
-
-            auto rule = std::make_unique<lsaa::Rule>(cfg.name);
-            rule->setCondition(std::move(cond));
-            rule->setAction(std::move(action));
-            engine.addRule(std::move(rule));
+        auto ruleSet = std::make_shared<lsaa::RuleSet>();
+        std::vector<lsaa::RuleIssue> issues;
+        size_t attempted = 0;
+        lsaa::ConfigManager::instance().forEachRule([&](const lsaa::RuleView& cfg) {
+            attempted++;
+            if (auto rule = ruleFactory.build(cfg, issues)) ruleSet->push_back(std::move(rule));
+        });
+        for (const auto& issue : issues) {
+            LSAA_LOG_WARN("Rule '" + issue.rule + "' skipped: " + issue.message);
         }
-        LSAA_LOG_INFO("Rules Reloaded: " + std::to_string(rules.size()) + " attempted.");
+        size_t active = ruleSet->size();
+        engine.publishRules(std::move(ruleSet));
+        LSAA_LOG_INFO("Rules Reloaded: " + std::to_string(active) + " active / " + std::to_string(attempted) + " defined.");
     };
 
     // Initial Load
     lsaa::ConfigManager::instance().load();
     reloadRulesFn();
 
-    // 5. Start Engine in background thread
+    // Rechargement automatique quand rules.json change sur disque
+    lsaa::FileWatcher configWatcher(lsaa::ConfigManager::instance().getFilename(), [reloadRulesFn]() {
+        if (lsaa::ConfigManager::instance().reload()) reloadRulesFn();
+    });
+    configWatcher.start();
+
+    // Export Prometheus : --metrics-port <port> (HTTP sur 127.0.0.1) et/ou
+    // --metrics-textfile <fichier.prom> (textfile collector de node_exporter, réécrit toutes les 15 s)
+    lsaa::PrometheusExporter exporter(engine.getMetricRegistry());
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--metrics-port") exporter.serve(std::atoi(argv[i + 1]));
+        else if (arg == "--metrics-textfile") exporter.startTextfile(argv[i + 1], std::chrono::seconds(15));
+    }
+
+    // 5. Start Engine in background thread (chaque tick réveille la GUI)
+    engine.setTopProcessSource([pmPtr]() { return pmPtr->getTopProcessesShared(); });
+    engine.setTickListener([]() { lsaa::GuiManager::wake(); });
     std::thread engineThread([&engine]() {
         engine.run(); 
     });
 
-    // 6. Main GUI Loop
+    // 6. Main GUI Loop : rendu à la demande (entrée utilisateur ou nouveau tick du moteur)
+    double cpu = 0.0;
+    long long ramUsed = 0;
+    long long ramTotal = 1; // avoid div/0
+    auto snapshot = engine.getSnapshot();
+    std::vector<std::string> logs;
+    uint64_t seenLogVersion = 0;
+
     while (!gui.shouldClose()) {
-        gui.beginFrame();
+        gui.waitEvents();
+
+        // Nouveau snapshot seulement quand le moteur a produit un nouveau tick (aucune copie)
+        bool dataChanged = false;
+        if (engine.getVersion() != snapshot->version) {
+            snapshot = engine.getSnapshot();
+            dataChanged = true;
+            const auto& metrics = snapshot->metrics;
 
-        // Get Data from Engine
-        auto metrics = engine.getLastMetrics();
-        
-        // Extract basic metrics for Dashboard
-        double cpu = 0.0;
-        long long ramUsed = 0;
-        long long ramTotal = 1; // avoid div/0
+            // get_if : une métrique annoncée peut ne pas avoir encore de valeur (std::monostate)
+            if (auto it = metrics.find("cpu_usage_percent"); it != metrics.end())
+                if (auto v = std::get_if<double>(&it->second)) cpu = *v;
+            if (auto it = metrics.find("ram_used_bytes"); it != metrics.end())
+                if (auto v = std::get_if<long long>(&it->second)) ramUsed = *v;
+            if (auto it = metrics.find("ram_total_bytes"); it != metrics.end())
+                if (auto v = std::get_if<long long>(&it->second)) ramTotal = *v;
 
-        if (metrics.count("cpu_usage_percent")) cpu = std::get<double>(metrics.at("cpu_usage_percent"));
-        if (metrics.count("ram_used_bytes")) ramUsed = std::get<long long>(metrics.at("ram_used_bytes"));
-        if (metrics.count("ram_total_bytes")) ramTotal = std::get<long long>(metrics.at("ram_total_bytes"));
+            gui.updateHistory(cpu, ramUsed, ramTotal);
+            gui.updateAgentStats(metrics);
+            gui.setRuleEvents(snapshot->ruleEvents);
+        }
+        if (uint64_t version = lsaa::Logger::instance().getVersion(); version != seenLogVersion) {
+            seenLogVersion = version;
+            dataChanged = true;
+            logs = lsaa::Logger::instance().getHistory();
+        }
 
-        // Get extended data
-        auto topProcs = pmPtr->getTopProcesses();
-        auto logs = lsaa::Logger::instance().getHistory();
+        if (!gui.frameNeeded(dataChanged)) continue;
 
-        gui.drawUI(cpu, ramUsed, ramTotal, topProcs, logs, 
+        gui.beginFrame();
+        gui.drawUI(cpu, ramUsed, ramTotal, *snapshot->topProcesses, logs, 
             // On Kill
             [](DWORD pid) {
                 lsaa::ActionKillProcess action(pid);
@@ -108,16 +245,23 @@ int main() {
             // On Reload Engine (Hot Reload)
             reloadRulesFn
         );
-
         gui.endFrame();
-        
-        // Cap at ~60 FPS
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
     }
 
     // Shutdown
+    configWatcher.stop();
+    exporter.stop();
+    services->stop();
+    gui.attachServices(nullptr, nullptr);
+    gui.attachLogIndex(nullptr);
+    serviceBatch.reset(); // Abandonne les attentes de transition en cours
     engine.stop();
     if (engineThread.joinable()) engineThread.join();
+    lsaa::EventJournal::instance().close();
+
+    if (!tracePath.empty() && !lsaa::Tracer::instance().writeChromeJson(tracePath)) {
+        LSAA_LOG_ERROR("Cannot write trace file " + tracePath);
+    }
     
     gui.cleanup();
     LSAA_LOG_INFO("System stopped cleanly.");
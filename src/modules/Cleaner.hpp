@@ -2,6 +2,7 @@
 #include <filesystem>
 #include <windows.h>
 #include <ShlObj.h> 
+#include <shellapi.h>
 #include <iostream>
 #include "../core/Logger.hpp"
 
@@ -91,13 +92,8 @@ namespace lsaa {
 
          std::string getTempPath() const { return sysTempPath_; }
 
-    private:
-        std::string sysTempPath_;
-        std::string chromeCache_;
-        std::string edgeCache_;
-        std::string firefoxCache_;
-
-        void scanDir(const std::string& path, ScanResult& result) {
+         // Parcours récursif (public pour les benchmarks)
+         static void scanDir(const std::string& path, ScanResult& result) {
             if (path.empty() || !fs::exists(path)) return;
             try {
                 for (const auto& entry : fs::recursive_directory_iterator(path, fs::directory_options::skip_permission_denied)) {
@@ -109,6 +105,12 @@ namespace lsaa {
             } catch (...) {}
         }
 
+    private:
+        std::string sysTempPath_;
+        std::string chromeCache_;
+        std::string edgeCache_;
+        std::string firefoxCache_;
+
         void cleanDir(const std::string& path, int& deleted, int& failed) {
             if (path.empty() || !fs::exists(path)) return;
              for (const auto& entry : fs::directory_iterator(path)) {
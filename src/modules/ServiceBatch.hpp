@@ -0,0 +1,188 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ServiceManager.hpp"
+#include "../core/Logger.hpp"
+#include "../core/Tracer.hpp"
+
+namespace lsaa {
+
+    struct ServiceRequest {
+        std::string name;
+        ServiceCommand command;
+    };
+
+    struct ServiceResult {
+        std::string name;
+        ServiceCommand command;
+        bool success = false;
+        DWORD finalState = 0;
+        std::chrono::milliseconds latency{0}; // Commande -> état cible (ou échec)
+        std::string error;
+    };
+
+    // Démarrage / arrêt / désactivation de plusieurs services en parallèle. Chaque service
+    // est suivi jusqu'à son état cible (RUNNING ou STOPPED) ou jusqu'au délai maximal :
+    // le résultat reflète l'état réel, pas la simple acceptation de la commande.
+    //
+    // Interrogation de l'état avec un intervalle croissant (pollMin -> pollMax) : un service
+    // rapide est vu tout de suite, un service lent ne sature pas le SCM.
+    class ServiceBatch {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Callback = std::function<void(std::vector<ServiceResult>)>;
+
+        struct Options {
+            size_t parallelism = 8;
+            std::chrono::milliseconds timeout{30000};
+            std::chrono::milliseconds pollMin{20};
+            std::chrono::milliseconds pollMax{500};
+        };
+
+        explicit ServiceBatch(std::shared_ptr<IServiceBackend> backend) : ServiceBatch(std::move(backend), Options{}) {}
+        ServiceBatch(std::shared_ptr<IServiceBackend> backend, Options options)
+            : backend_(std::move(backend)), options_(options) {}
+
+        ~ServiceBatch() {
+            stopping_ = true;
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                running_ = false;
+            }
+            queueWake_.notify_all();
+            if (dispatcher_.joinable()) dispatcher_.join();
+        }
+
+        static DWORD targetState(ServiceCommand command) {
+            return command == ServiceCommand::START ? SERVICE_RUNNING : SERVICE_STOPPED;
+        }
+
+        // Synchrone : rend la main quand tous les services ont abouti ou expiré.
+        // Résultats dans l'ordre des requêtes.
+        std::vector<ServiceResult> run(const std::vector<ServiceRequest>& requests) const {
+            std::vector<ServiceResult> results(requests.size());
+            std::atomic<size_t> next{0};
+            auto worker = [&]() {
+                for (size_t i = next.fetch_add(1); i < requests.size(); i = next.fetch_add(1)) {
+                    results[i] = apply(requests[i]);
+                }
+            };
+            size_t threads = std::min(std::max<size_t>(1, options_.parallelism), requests.size());
+            std::vector<std::thread> pool;
+            for (size_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+            worker();
+            for (auto& t : pool) t.join();
+            return results;
+        }
+
+        // Asynchrone (GUI) : les lots sont exécutés l'un après l'autre sur un thread dédié,
+        // `done` est appelé sur ce thread
+        void submit(std::vector<ServiceRequest> requests, Callback done) {
+            {
+                std::lock_guard<std::mutex> lock(queueMutex_);
+                queue_.push_back({std::move(requests), std::move(done)});
+                if (!dispatcher_.joinable()) {
+                    running_ = true;
+                    dispatcher_ = std::thread([this]() { dispatch(); });
+                }
+            }
+            queueWake_.notify_all();
+        }
+
+    private:
+        struct Job {
+            std::vector<ServiceRequest> requests;
+            Callback done;
+        };
+
+        std::shared_ptr<IServiceBackend> backend_;
+        Options options_;
+
+        std::mutex queueMutex_;
+        std::condition_variable queueWake_;
+        std::deque<Job> queue_;
+        bool running_ = false;
+        std::thread dispatcher_;
+        std::atomic<bool> stopping_{false}; // Arrêt de l'agent : les attentes en cours sont abandonnées
+
+        ServiceResult apply(const ServiceRequest& request) const {
+            LSAA_TRACE_SCOPE("services", "ServiceBatch::apply");
+            ServiceResult result;
+            result.name = request.name;
+            result.command = request.command;
+            const DWORD target = targetState(request.command);
+            const auto start = Clock::now();
+            auto finish = [&](bool success, DWORD state) {
+                result.success = success;
+                result.finalState = state;
+                result.latency = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start);
+                return result;
+            };
+
+            // Déjà dans l'état voulu : rien à envoyer (DISABLE change aussi la configuration)
+            DWORD state = backend_->queryState(request.name);
+            if (state == 0) {
+                result.error = "service not found";
+                return finish(false, 0);
+            }
+            if (state == target && request.command != ServiceCommand::DISABLE) return finish(true, state);
+
+            if (!backend_->control(request.name, request.command, result.error)) return finish(false, state);
+
+            auto poll = options_.pollMin;
+            bool seenPending = false;
+            while (true) {
+                state = backend_->queryState(request.name);
+                if (state == target) return finish(true, state);
+                if (state == SERVICE_START_PENDING || state == SERVICE_STOP_PENDING) seenPending = true;
+                // Un démarrage qui échoue repasse à l'arrêt après la phase de démarrage
+                else if (seenPending && request.command == ServiceCommand::START && state == SERVICE_STOPPED) {
+                    result.error = "service stopped while starting";
+                    return finish(false, state);
+                }
+                if (stopping_) {
+                    result.error = "cancelled";
+                    return finish(false, state);
+                }
+                if (Clock::now() - start + poll > options_.timeout) {
+                    result.error = "timeout (" + ServiceManager::stateToString(state) + ")";
+                    return finish(false, state);
+                }
+                std::this_thread::sleep_for(poll);
+                poll = std::min(options_.pollMax, poll * 2);
+            }
+        }
+
+        void dispatch() {
+            LSAA_TRACE_THREAD_NAME("service-batch");
+            while (true) {
+                Job job;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex_);
+                    queueWake_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+                    if (!running_) return;
+                    job = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+                auto results = run(job.requests);
+                for (const auto& r : results) {
+                    std::string line = "ServiceBatch: " + std::string(ServiceManager::commandName(r.command)) + " " + r.name +
+                                       (r.success ? " ok" : " failed") + " in " + std::to_string(r.latency.count()) + " ms";
+                    if (r.success) LSAA_LOG_INFO(line);
+                    else LSAA_LOG_WARN(line + " (" + r.error + ")");
+                }
+                if (job.done) job.done(std::move(results));
+            }
+        }
+    };
+
+}
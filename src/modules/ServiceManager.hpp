@@ -1,10 +1,33 @@
 #pragma once
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
-#include <windows.h>
-#include <winsvc.h>
-#include <memory>
+#include "../core/Platform.hpp"
 #include "../core/Logger.hpp"
+#ifdef _WIN32
+#include <winsvc.h>
+#else
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cstdio>
+
+extern char** environ;
+
+// Mêmes codes d'état que le SCM : la GUI et les règles restent communes aux deux OS
+#define SERVICE_STOPPED          0x00000001
+#define SERVICE_START_PENDING    0x00000002
+#define SERVICE_STOP_PENDING     0x00000003
+#define SERVICE_RUNNING          0x00000004
+#define SERVICE_CONTINUE_PENDING 0x00000005
+#define SERVICE_PAUSE_PENDING    0x00000006
+#define SERVICE_PAUSED           0x00000007
+#endif
 
 namespace lsaa {
 
@@ -19,129 +42,397 @@ namespace lsaa {
         bool canPause;              // Si le service peut être mis en pause
     };
 
+    enum class ServiceCommand { START, STOP, DISABLE };
+
+    // Accès au gestionnaire de services de l'OS. Les méthodes peuvent être appelées en
+    // parallèle depuis plusieurs threads (ServiceBatch).
+    class IServiceBackend {
+    public:
+        virtual ~IServiceBackend() = default;
+
+        virtual std::string getName() const = 0;
+
+        // Remplace `services` par la liste complète. Faux si elle n'a pas pu être lue en entier
+        // (SCM ou systemctl en échec) : `services` est alors à ignorer.
+        virtual bool enumerate(std::vector<ServiceInfo>& services) = 0;
+
+        // Envoie la commande sans attendre la transition (DISABLE = désactiver puis arrêter).
+        // Faux si la commande est refusée, avec la raison dans `error`.
+        virtual bool control(const std::string& name, ServiceCommand command, std::string& error) = 0;
+
+        // Etat courant (SERVICE_RUNNING...), 0 si le service n'existe pas
+        virtual DWORD queryState(const std::string& name) = 0;
+    };
+
     class ServiceManager {
     public:
-        // Récupère la liste de tous les services installés sur le système
-        static std::vector<ServiceInfo> getServices() {
-            std::vector<ServiceInfo> services;
-            SC_HANDLE hSCManager = OpenSCManager(NULL, NULL, SC_MANAGER_ENUMERATE_SERVICE);
-            
-            if (!hSCManager) {
+        // Backend de l'OS courant : SCM sous Windows, systemd sous Linux
+        static std::shared_ptr<IServiceBackend> makeBackend();
+
+        static const char* commandName(ServiceCommand command) {
+            switch (command) {
+                case ServiceCommand::START: return "start";
+                case ServiceCommand::STOP: return "stop";
+                case ServiceCommand::DISABLE: return "disable";
+            }
+            return "?";
+        }
+
+        // Convertit le code d'état Windows en chaîne lisible
+        static std::string stateToString(DWORD state) {
+            switch (state) {
+                case SERVICE_STOPPED: return "Arrêté";
+                case SERVICE_START_PENDING: return "Démarrage...";
+                case SERVICE_STOP_PENDING: return "Arrêt...";
+                case SERVICE_RUNNING: return "En cours";
+                case SERVICE_CONTINUE_PENDING: return "Reprise...";
+                case SERVICE_PAUSE_PENDING: return "Mise en pause...";
+                case SERVICE_PAUSED: return "En pause";
+                case 0: return "Absent";
+                default: return "Inconnu";
+            }
+        }
+    };
+
+#ifdef _WIN32
+
+    // Windows : un seul handle SCM pour toute la durée de vie du backend (les handles SCM
+    // sont utilisables depuis plusieurs threads). Droits minimaux : énumération + connexion,
+    // les droits start/stop/config sont demandés service par service.
+    class ScmServiceBackend : public IServiceBackend {
+    public:
+        ScmServiceBackend() {
+            scm_ = OpenSCManagerA(NULL, NULL, SC_MANAGER_CONNECT | SC_MANAGER_ENUMERATE_SERVICE);
+            if (!scm_) {
                 LSAA_LOG_ERROR("ServiceManager: Impossible d'ouvrir le SCM (Service Control Manager). Erreur: " + std::to_string(GetLastError()));
-                return services;
             }
+        }
+
+        ~ScmServiceBackend() override {
+            if (scm_) CloseServiceHandle(scm_);
+        }
+
+        std::string getName() const override { return "SCM"; }
 
+        bool enumerate(std::vector<ServiceInfo>& services) override {
+            services.clear();
+            if (!scm_) return false;
+
+            // Buffer conservé d'un appel à l'autre : en régime établi, un seul appel suffit
+            std::lock_guard<std::mutex> lock(bufferMutex_);
             DWORD bytesNeeded = 0;
             DWORD servicesReturned = 0;
             DWORD resumeHandle = 0;
-            
-            // Premier appel pour déterminer la taille du buffer nécessaire
-            EnumServicesStatusEx(
-                hSCManager, 
-                SC_ENUM_PROCESS_INFO,
-                SERVICE_WIN32, // Services de type Win32 (Driver exclus)
-                SERVICE_STATE_ALL, // Tous les états (actifs et inactifs)
-                NULL, 
-                0, 
-                &bytesNeeded, 
-                &servicesReturned, 
-                &resumeHandle, 
-                NULL
-            );
-
-            // On alloue le buffer
-            std::vector<BYTE> buffer(bytesNeeded);
-            LPENUM_SERVICE_STATUS_PROCESS pServices = (LPENUM_SERVICE_STATUS_PROCESS)buffer.data();
-
-            // Second appel pour récupérer les données
-            if (EnumServicesStatusEx(
-                hSCManager, 
-                SC_ENUM_PROCESS_INFO,
-                SERVICE_WIN32,
-                SERVICE_STATE_ALL,
-                (LPBYTE)pServices, 
-                bytesNeeded, 
-                &bytesNeeded, 
-                &servicesReturned, 
-                &resumeHandle, 
-                NULL
-            )) {
+            while (true) {
+                BOOL ok = EnumServicesStatusExA(
+                    scm_,
+                    SC_ENUM_PROCESS_INFO,
+                    SERVICE_WIN32, // Services de type Win32 (Driver exclus)
+                    SERVICE_STATE_ALL, // Tous les états (actifs et inactifs)
+                    buffer_.empty() ? NULL : buffer_.data(),
+                    (DWORD)buffer_.size(),
+                    &bytesNeeded,
+                    &servicesReturned,
+                    &resumeHandle,
+                    NULL
+                );
+                if (!ok && GetLastError() != ERROR_MORE_DATA) {
+                    LSAA_LOG_ERROR("ServiceManager: Echec de l'énumération des services. Erreur: " + std::to_string(GetLastError()));
+                    return false; // Liste partielle : inutilisable
+                }
+                auto* entries = (LPENUM_SERVICE_STATUS_PROCESSA)buffer_.data();
                 for (DWORD i = 0; i < servicesReturned; i++) {
                     ServiceInfo info;
-                    info.name = pServices[i].lpServiceName;
-                    info.displayName = pServices[i].lpDisplayName;
-                    info.pid = pServices[i].ServiceStatusProcess.dwProcessId;
-                    info.stateCode = pServices[i].ServiceStatusProcess.dwCurrentState;
-                    info.status = stateToString(info.stateCode);
-                    
-                    // Vérification des capacités (on pourrait aller plus loin avec QueryServiceStatusEx pour les détails)
-                    // Pour simplifier ici, on considère que si ça tourne, on peut potentiellement l'arrêter
-                    info.canStop = (info.stateCode == SERVICE_RUNNING);
-                    
-                    services.push_back(info);
+                    info.name = entries[i].lpServiceName;
+                    info.displayName = entries[i].lpDisplayName;
+                    info.pid = entries[i].ServiceStatusProcess.dwProcessId;
+                    info.stateCode = entries[i].ServiceStatusProcess.dwCurrentState;
+                    info.status = ServiceManager::stateToString(info.stateCode);
+                    info.canStop = (info.stateCode == SERVICE_RUNNING) &&
+                                   (entries[i].ServiceStatusProcess.dwControlsAccepted & SERVICE_ACCEPT_STOP);
+                    info.canPause = (entries[i].ServiceStatusProcess.dwControlsAccepted & SERVICE_ACCEPT_PAUSE_CONTINUE) != 0;
+                    services.push_back(std::move(info));
+                }
+                if (ok) return true;
+                // ERROR_MORE_DATA : on agrandit et on reprend là où l'énumération s'est arrêtée
+                buffer_.resize(std::max<size_t>(bytesNeeded, buffer_.size() * 2));
+            }
+        }
+
+        bool control(const std::string& name, ServiceCommand command, std::string& error) override {
+            DWORD access = SERVICE_QUERY_STATUS;
+            if (command == ServiceCommand::START) access |= SERVICE_START;
+            else access |= SERVICE_STOP;
+            if (command == ServiceCommand::DISABLE) access |= SERVICE_CHANGE_CONFIG;
+
+            SC_HANDLE service = scm_ ? OpenServiceA(scm_, name.c_str(), access) : NULL;
+            if (!service) {
+                error = "OpenService: " + std::to_string(GetLastError());
+                return false;
+            }
+            bool ok = true;
+            if (command == ServiceCommand::START) {
+                if (!StartServiceA(service, 0, NULL) && GetLastError() != ERROR_SERVICE_ALREADY_RUNNING) {
+                    error = "StartService: " + std::to_string(GetLastError());
+                    ok = false;
                 }
             } else {
-                LSAA_LOG_ERROR("ServiceManager: Echec de l'énumération des services. Erreur: " + std::to_string(GetLastError()));
+                if (command == ServiceCommand::DISABLE &&
+                    !ChangeServiceConfigA(service, SERVICE_NO_CHANGE, SERVICE_DISABLED, SERVICE_NO_CHANGE,
+                                          NULL, NULL, NULL, NULL, NULL, NULL, NULL)) {
+                    error = "ChangeServiceConfig: " + std::to_string(GetLastError());
+                    ok = false;
+                }
+                SERVICE_STATUS status;
+                if (ok && !ControlService(service, SERVICE_CONTROL_STOP, &status) &&
+                    GetLastError() != ERROR_SERVICE_NOT_ACTIVE) {
+                    error = "ControlService: " + std::to_string(GetLastError());
+                    ok = false;
+                }
             }
+            CloseServiceHandle(service);
+            return ok;
+        }
 
-            CloseServiceHandle(hSCManager);
-            return services;
+        DWORD queryState(const std::string& name) override {
+            SC_HANDLE service = scm_ ? OpenServiceA(scm_, name.c_str(), SERVICE_QUERY_STATUS) : NULL;
+            if (!service) return 0;
+            SERVICE_STATUS_PROCESS status{};
+            DWORD needed = 0;
+            DWORD state = 0;
+            if (QueryServiceStatusEx(service, SC_STATUS_PROCESS_INFO, (LPBYTE)&status, sizeof(status), &needed)) {
+                state = status.dwCurrentState;
+            }
+            CloseServiceHandle(service);
+            return state;
         }
 
-        // Tente de démarrer un service par son nom
-        static bool startService(const std::string& serviceName) {
-            bool success = false;
-            SC_HANDLE hSCManager = OpenSCManager(NULL, NULL, SC_MANAGER_ALL_ACCESS); // Besoin de droits admin
-            if (!hSCManager) return false;
+    private:
+        SC_HANDLE scm_ = NULL;
+        std::mutex bufferMutex_;
+        std::vector<BYTE> buffer_;
+    };
+
+    inline std::shared_ptr<IServiceBackend> ServiceManager::makeBackend() { return std::make_shared<ScmServiceBackend>(); }
+
+#else
 
-            SC_HANDLE hService = OpenServiceA(hSCManager, serviceName.c_str(), SERVICE_START);
-            if (hService) {
-                if (StartServiceA(hService, 0, NULL)) {
-                    LSAA_LOG_INFO("ServiceManager: Service démarré avec succès -> " + serviceName);
-                    success = true;
-                } else {
-                    LSAA_LOG_ERROR("ServiceManager: Impossible de démarrer le service " + serviceName + ". Erreur: " + std::to_string(GetLastError()));
+    // Linux : unités systemd via systemctl (lancé sans shell, arguments passés tels quels).
+    // --no-block : la commande rend la main dès que le job est en file, comme le SCM.
+    class SystemdServiceBackend : public IServiceBackend {
+    public:
+        std::string getName() const override { return "systemd"; }
+
+        bool enumerate(std::vector<ServiceInfo>& services) override {
+            services.clear();
+            std::string out;
+            if (!systemctl({"list-units", "--type=service", "--all", "--no-legend", "--plain", "--no-pager"}, &out)) {
+                return false;
+            }
+            // UNIT LOAD ACTIVE SUB DESCRIPTION
+            size_t pos = 0;
+            while (pos < out.size()) {
+                size_t eol = out.find('\n', pos);
+                if (eol == std::string::npos) eol = out.size();
+                std::string line = out.substr(pos, eol - pos);
+                pos = eol + 1;
+
+                std::string fields[4];
+                size_t p = 0;
+                for (auto& f : fields) {
+                    p = line.find_first_not_of(' ', p);
+                    if (p == std::string::npos) break;
+                    size_t end = line.find(' ', p);
+                    f = line.substr(p, end == std::string::npos ? std::string::npos : end - p);
+                    p = end;
                 }
-                CloseServiceHandle(hService);
+                if (fields[0].size() < 9 || fields[0].compare(fields[0].size() - 8, 8, ".service") != 0) continue;
+
+                ServiceInfo info{};
+                info.name = fields[0].substr(0, fields[0].size() - 8);
+                p = (p == std::string::npos) ? std::string::npos : line.find_first_not_of(' ', p);
+                info.displayName = (p == std::string::npos) ? info.name : line.substr(p);
+                info.stateCode = toState(fields[2]);
+                info.status = ServiceManager::stateToString(info.stateCode);
+                info.canStop = info.stateCode == SERVICE_RUNNING;
+                services.push_back(std::move(info));
+            }
+            return true;
+        }
+
+        bool control(const std::string& name, ServiceCommand command, std::string& error) override {
+            std::string unit = name + ".service";
+            bool ok = false;
+            switch (command) {
+                case ServiceCommand::START: ok = systemctl({"start", "--no-block", unit}); break;
+                case ServiceCommand::STOP: ok = systemctl({"stop", "--no-block", unit}); break;
+                case ServiceCommand::DISABLE: ok = systemctl({"disable", "--now", "--no-block", unit}); break;
             }
-            CloseServiceHandle(hSCManager);
-            return success;
+            if (!ok) error = std::string("systemctl ") + ServiceManager::commandName(command) + " failed";
+            return ok;
         }
 
-        // Tente d'arrêter un service par son nom
-        static bool stopService(const std::string& serviceName) {
-            bool success = false;
-            SC_HANDLE hSCManager = OpenSCManager(NULL, NULL, SC_MANAGER_ALL_ACCESS);
-            if (!hSCManager) return false;
+        DWORD queryState(const std::string& name) override {
+            std::string out;
+            if (!systemctl({"show", "--property=ActiveState,LoadState", name + ".service"}, &out)) return 0;
+            if (out.find("LoadState=not-found") != std::string::npos) return 0;
+            auto p = out.find("ActiveState=");
+            if (p == std::string::npos) return 0;
+            p += 12;
+            return toState(out.substr(p, out.find('\n', p) - p));
+        }
 
-            SC_HANDLE hService = OpenServiceA(hSCManager, serviceName.c_str(), SERVICE_STOP);
-            if (hService) {
-                SERVICE_STATUS status;
-                if (ControlService(hService, SERVICE_CONTROL_STOP, &status)) {
-                    LSAA_LOG_INFO("ServiceManager: Service arrêté avec succès -> " + serviceName);
-                    success = true;
-                } else {
-                    LSAA_LOG_ERROR("ServiceManager: Impossible d'arrêter le service " + serviceName + ". Erreur: " + std::to_string(GetLastError()));
+    private:
+        static DWORD toState(const std::string& active) {
+            if (active == "active" || active == "reloading") return SERVICE_RUNNING;
+            if (active == "activating") return SERVICE_START_PENDING;
+            if (active == "deactivating") return SERVICE_STOP_PENDING;
+            return SERVICE_STOPPED; // inactive, failed
+        }
+
+        // Exécute systemctl ; sortie standard dans `out` si demandé. Vrai si code de sortie 0.
+        static bool systemctl(std::vector<std::string> args, std::string* out = nullptr) {
+            args.insert(args.begin(), "systemctl");
+            std::vector<char*> argv;
+            for (auto& a : args) argv.push_back(a.data());
+            argv.push_back(nullptr);
+
+            int fds[2];
+            if (pipe(fds) != 0) return false;
+            posix_spawn_file_actions_t actions;
+            posix_spawn_file_actions_init(&actions);
+            posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+            posix_spawn_file_actions_addclose(&actions, fds[0]);
+            posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+            pid_t pid = 0;
+            int rc = posix_spawnp(&pid, "systemctl", &actions, nullptr, argv.data(), environ);
+            posix_spawn_file_actions_destroy(&actions);
+            close(fds[1]);
+            if (rc != 0) {
+                close(fds[0]);
+                return false;
+            }
+            char buf[4096];
+            ssize_t n;
+            while ((n = read(fds[0], buf, sizeof(buf))) > 0) {
+                if (out) out->append(buf, (size_t)n);
+            }
+            close(fds[0]);
+            int status = 0;
+            if (waitpid(pid, &status, 0) != pid) return false;
+            return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+    };
+
+    inline std::shared_ptr<IServiceBackend> ServiceManager::makeBackend() { return std::make_shared<SystemdServiceBackend>(); }
+
+#endif
+
+    // Hôte de services en mémoire : chaque commande passe par l'état *_PENDING pendant
+    // `transition` avant d'atteindre l'état cible. Sert aux benchmarks et au rejeu.
+    class FakeServiceBackend : public IServiceBackend {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Behaviour {
+            std::chrono::milliseconds transition{0};
+            bool failStart = false;   // Repasse à l'arrêt au lieu de démarrer
+            bool refuse = false;      // control() échoue immédiatement
+            bool hang = false;        // Reste bloqué en *_PENDING
+        };
+
+        std::string getName() const override { return "fake"; }
+
+        void addService(const std::string& name, DWORD state) { addService(name, state, Behaviour()); }
+
+        void addService(const std::string& name, DWORD state, Behaviour behaviour) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            services_[name] = {state, state, Clock::time_point{}, behaviour, false};
+        }
+
+        // Simule une panne du gestionnaire de services : enumerate() échoue
+        void setUnavailable(bool unavailable) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            unavailable_ = unavailable;
+        }
+
+        bool enumerate(std::vector<ServiceInfo>& out) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            out.clear();
+            if (unavailable_) return false;
+            out.reserve(services_.size());
+            for (auto& [name, s] : services_) {
+                ServiceInfo info{};
+                info.name = name;
+                info.displayName = name;
+                info.stateCode = advance(s);
+                info.status = ServiceManager::stateToString(info.stateCode);
+                info.canStop = info.stateCode == SERVICE_RUNNING;
+                out.push_back(std::move(info));
+            }
+            return true;
+        }
+
+        bool control(const std::string& name, ServiceCommand command, std::string& error) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = services_.find(name);
+            if (it == services_.end()) {
+                error = "no such service";
+                return false;
+            }
+            Service& s = it->second;
+            if (s.behaviour.refuse) {
+                error = "access denied";
+                return false;
+            }
+            DWORD state = advance(s);
+            if (command == ServiceCommand::DISABLE) s.disabled = true;
+            if (command == ServiceCommand::START) {
+                if (s.disabled) {
+                    error = "service disabled";
+                    return false;
                 }
-                CloseServiceHandle(hService);
+                if (state == SERVICE_RUNNING) return true;
+                s.state = SERVICE_START_PENDING;
+                s.target = s.behaviour.failStart ? SERVICE_STOPPED : SERVICE_RUNNING;
+            } else {
+                if (state == SERVICE_STOPPED) return true;
+                s.state = SERVICE_STOP_PENDING;
+                s.target = SERVICE_STOPPED;
             }
-            CloseServiceHandle(hSCManager);
-            return success;
+            s.until = Clock::now() + s.behaviour.transition;
+            return true;
+        }
+
+        DWORD queryState(const std::string& name) override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = services_.find(name);
+            return it == services_.end() ? 0 : advance(it->second);
+        }
+
+        bool isDisabled(const std::string& name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = services_.find(name);
+            return it != services_.end() && it->second.disabled;
         }
 
     private:
-        // Convertit le code d'état Windows en chaîne lisible
-        static std::string stateToString(DWORD state) {
-            switch (state) {
-                case SERVICE_STOPPED: return "Arrêté";
-                case SERVICE_START_PENDING: return "Démarrage...";
-                case SERVICE_STOP_PENDING: return "Arrêt...";
-                case SERVICE_RUNNING: return "En cours";
-                case SERVICE_CONTINUE_PENDING: return "Reprise...";
-                case SERVICE_PAUSE_PENDING: return "Mise en pause...";
-                case SERVICE_PAUSED: return "En pause";
-                default: return "Inconnu";
-            }
+        struct Service {
+            DWORD state;
+            DWORD target;
+            Clock::time_point until;
+            Behaviour behaviour;
+            bool disabled;
+        };
+
+        std::mutex mutex_;
+        std::map<std::string, Service> services_;
+        bool unavailable_ = false;
+
+        static DWORD advance(Service& s) {
+            if (s.state != s.target && !s.behaviour.hang && Clock::now() >= s.until) s.state = s.target;
+            return s.state;
         }
     };
 }
@@ -0,0 +1,246 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "ServiceManager.hpp"
+#include "../core/Logger.hpp"
+#include "../core/Tracer.hpp"
+
+namespace lsaa {
+
+    // Liste des services publiée par ServiceRefresher. Immuable une fois publiée :
+    // la GUI et le ServiceMonitor la partagent sans copie.
+    struct ServiceList {
+        uint64_t version = 0;
+        std::vector<ServiceInfo> services; // Triés par nom
+
+        // Index de recherche construit une fois par rafraîchissement : "nom\nnom affiché"
+        // en minuscules, bout à bout. matches() ne fait aucune allocation.
+        std::string searchText;
+        std::vector<std::pair<uint32_t, uint32_t>> searchSpans; // (début, longueur) par service
+
+        // `lowerNeedle` doit déjà être en minuscules (voir toLowerAscii)
+        bool matches(size_t i, std::string_view lowerNeedle) const {
+            if (lowerNeedle.empty()) return true;
+            auto [begin, length] = searchSpans[i];
+            return std::string_view(searchText).substr(begin, length).find(lowerNeedle) != std::string_view::npos;
+        }
+
+        const ServiceInfo* find(std::string_view name) const {
+            auto it = std::lower_bound(services.begin(), services.end(), name,
+                [](const ServiceInfo& s, std::string_view n) { return s.name < n; });
+            return (it != services.end() && it->name == name) ? &*it : nullptr;
+        }
+
+        // Comme find(), sans tenir compte de la casse (ASCII) : les noms de services Windows n'y
+        // sont pas sensibles. Recherche exacte d'abord, puis parcours de la liste.
+        const ServiceInfo* findIgnoreCase(std::string_view name) const {
+            if (const ServiceInfo* s = find(name)) return s;
+            for (const auto& s : services) {
+                if (equalsIgnoreCase(s.name, name)) return &s;
+            }
+            return nullptr;
+        }
+
+        static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+                return (x >= 'A' && x <= 'Z' ? x + 32 : x) == (y >= 'A' && y <= 'Z' ? y + 32 : y);
+            });
+        }
+
+        void buildSearchIndex() {
+            searchText.clear();
+            searchSpans.clear();
+            searchSpans.reserve(services.size());
+            for (const auto& s : services) {
+                uint32_t begin = (uint32_t)searchText.size();
+                searchText += s.name;
+                searchText += '\n'; // Jamais saisi : une recherche ne chevauche pas les deux noms
+                searchText += s.displayName;
+                searchSpans.emplace_back(begin, (uint32_t)searchText.size() - begin);
+            }
+            toLowerAscii(searchText.data(), searchText.size());
+        }
+
+        static void toLowerAscii(char* s, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                if (s[i] >= 'A' && s[i] <= 'Z') s[i] = (char)(s[i] - 'A' + 'a');
+            }
+        }
+    };
+
+    // Changement d'état d'un service entre deux rafraîchissements.
+    // oldState = 0 : service apparu ; newState = 0 : service supprimé.
+    struct ServiceChange {
+        std::string name;
+        DWORD oldState;
+        DWORD newState;
+    };
+
+    // Enumération des services sur un thread dédié (EnumServicesStatusEx ou systemctl peuvent
+    // prendre des centaines de ms). Chaque liste est comparée à la précédente : une nouvelle version
+    // n'est publiée que si un service a changé d'état, de PID ou est apparu/disparu, et
+    // les changements sont mis en file pour le ServiceMonitor.
+    class ServiceRefresher {
+    public:
+        static constexpr std::chrono::seconds kInterval{5};
+        static constexpr std::chrono::seconds kPendingInterval{1}; // Service en cours de démarrage/arrêt
+        static constexpr size_t kMaxPendingChanges = 4096;
+
+        explicit ServiceRefresher(std::shared_ptr<IServiceBackend> backend)
+            : backend_(std::move(backend)), list_(std::make_shared<const ServiceList>()) {}
+
+        ~ServiceRefresher() { stop(); }
+
+        // Appelé sur le thread du rafraîchissement après chaque nouvelle version
+        void setChangeListener(std::function<void()> listener) { listener_ = std::move(listener); }
+
+        void start() {
+            if (thread_.joinable()) return;
+            running_ = true;
+            thread_ = std::thread([this]() { loop(); });
+        }
+
+        void stop() {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                running_ = false;
+            }
+            wake_.notify_all();
+            if (thread_.joinable()) thread_.join();
+        }
+
+        // Rafraîchissement immédiat (bouton Refresh, après un démarrage/arrêt)
+        void requestRefresh() {
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                requested_ = true;
+            }
+            wake_.notify_all();
+        }
+
+        // Rafraîchissement synchrone sur le thread appelant (thread dédié, tests)
+        void refresh() {
+            auto next = std::make_shared<ServiceList>();
+            // Échec (même partiel) : la version courante reste en place. Une liste tronquée
+            // passerait pour la disparition des services manquants (service_running.<nom> = 0).
+            if (!backend_->enumerate(next->services)) {
+                if (!enumerateFailed_) LSAA_LOG_WARN("ServiceRefresher: service list unavailable (" + backend_->getName() + "), keeping the previous one");
+                enumerateFailed_ = true;
+                return;
+            }
+            enumerateFailed_ = false;
+            std::sort(next->services.begin(), next->services.end(),
+                [](const ServiceInfo& a, const ServiceInfo& b) { return a.name < b.name; });
+
+            std::vector<ServiceChange> changes;
+            auto current = snapshot();
+            bool changed = diff(*current, *next, changes);
+            if (!changed) return;
+
+            next->version = current->version + 1;
+            next->buildSearchIndex();
+            if (current->version > 0) {
+                for (const auto& c : changes) {
+                    LSAA_LOG_INFO("Service " + c.name + ": " + ServiceManager::stateToString(c.oldState) +
+                                  " -> " + ServiceManager::stateToString(c.newState));
+                }
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                list_ = std::move(next);
+                // Premier passage : l'inventaire initial n'est pas une suite d'événements
+                if (current->version > 0) {
+                    size_t room = kMaxPendingChanges - std::min(kMaxPendingChanges, changes_.size());
+                    if (changes.size() > room) changes.resize(room);
+                    std::move(changes.begin(), changes.end(), std::back_inserter(changes_));
+                }
+            }
+            if (listener_) listener_();
+        }
+
+        std::shared_ptr<const ServiceList> snapshot() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return list_;
+        }
+
+        uint64_t version() const { return snapshot()->version; }
+
+        // Changements depuis le dernier appel (ServiceMonitor)
+        void drainChanges(std::vector<ServiceChange>& out) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            out.swap(changes_);
+            changes_.clear();
+        }
+
+        // Fusion des deux listes triées par nom. Vrai si quelque chose a changé
+        // (y compris un simple changement de PID, qui ne produit pas d'événement).
+        static bool diff(const ServiceList& before, const ServiceList& after, std::vector<ServiceChange>& changes) {
+            bool changed = before.services.size() != after.services.size();
+            auto a = before.services.begin();
+            auto b = after.services.begin();
+            while (a != before.services.end() || b != after.services.end()) {
+                if (b == after.services.end() || (a != before.services.end() && a->name < b->name)) {
+                    changes.push_back({a->name, a->stateCode, 0});
+                    changed = true;
+                    ++a;
+                } else if (a == before.services.end() || b->name < a->name) {
+                    changes.push_back({b->name, 0, b->stateCode});
+                    changed = true;
+                    ++b;
+                } else {
+                    if (a->stateCode != b->stateCode) changes.push_back({b->name, a->stateCode, b->stateCode});
+                    if (a->stateCode != b->stateCode || a->pid != b->pid || a->displayName != b->displayName) changed = true;
+                    ++a;
+                    ++b;
+                }
+            }
+            return changed;
+        }
+
+    private:
+        std::shared_ptr<IServiceBackend> backend_;
+        std::function<void()> listener_;
+
+        mutable std::mutex mutex_;
+        std::shared_ptr<const ServiceList> list_;
+        std::vector<ServiceChange> changes_;
+
+        std::mutex wakeMutex_;
+        std::condition_variable wake_;
+        bool running_ = false;
+        bool requested_ = false;
+        bool enumerateFailed_ = false; // Thread de rafraîchissement : un avertissement par panne
+        std::thread thread_;
+
+        static bool hasPending(const ServiceList& list) {
+            return std::any_of(list.services.begin(), list.services.end(), [](const ServiceInfo& s) {
+                return s.stateCode != SERVICE_RUNNING && s.stateCode != SERVICE_STOPPED && s.stateCode != SERVICE_PAUSED;
+            });
+        }
+
+        void loop() {
+            LSAA_TRACE_THREAD_NAME("services");
+            while (true) {
+                refresh();
+                auto wait = hasPending(*snapshot()) ? std::chrono::seconds(kPendingInterval) : std::chrono::seconds(kInterval);
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                wake_.wait_for(lock, wait, [this]() { return !running_ || requested_; });
+                if (!running_) return;
+                requested_ = false;
+            }
+        }
+    };
+
+}
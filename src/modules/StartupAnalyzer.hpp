@@ -0,0 +1,327 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "StartupManager.hpp"
+#include "../monitors/ProcessMonitor.hpp"
+#include "../core/Logger.hpp"
+#ifdef _WIN32
+#include <wtsapi32.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace lsaa {
+
+    // Coût d'un élément de démarrage pendant les premières minutes de la session
+    struct StartupImpact {
+        std::string name;
+        std::string command;
+        size_t processes = 0;              // Processus attribués, enfants compris
+        double cpuSeconds = 0.0;
+        unsigned long long readBytes = 0;
+        SIZE_T peakMemoryBytes = 0;        // Somme des processus vivants, au pire tick
+        double firstSeenSeconds = -1.0;    // Création du premier processus, depuis l'ouverture de session
+        double cost = 0.0;                 // Secondes de travail estimées : CPU + lectures
+    };
+
+    struct StartupReport {
+        std::chrono::system_clock::time_point sessionStart;
+        std::chrono::minutes window{0};
+        double timeToIdleSeconds = -1.0;   // -1 : pas (encore) au repos dans la fenêtre
+        bool complete = false;
+        std::vector<StartupImpact> items;  // Coût décroissant
+    };
+
+    // Mesure du coût de chaque élément de démarrage pendant les N premières minutes après
+    // l'ouverture de session, puis classement.
+    //
+    // Attribution : un processus appartient à un élément si son image est l'exécutable de
+    // l'élément, ou si son parent lui appartient déjà (lanceurs, processus enfants). Seuls
+    // les processus créés dans la fenêtre comptent.
+    //
+    // Branché sur ProcessMonitor::setTableObserver : la table incrémentale du moniteur est
+    // parcourue sans copie, seuls les processus attribués sont interrogés (CPU et lectures
+    // cumulés depuis leur création). Hors fenêtre, observe() ne fait plus rien.
+    class StartupAnalyzer {
+    public:
+        using Clock = ProcessMonitor::Clock;
+        using SystemClock = std::chrono::system_clock;
+
+        static constexpr double kDiskBytesPerSecond = 100e6; // Lectures converties en secondes de disque
+        static constexpr double kIdleCpuPercent = 15.0;
+        static constexpr std::chrono::seconds kIdleHold{10};  // Durée sous le seuil pour parler de repos
+        static constexpr std::chrono::seconds kCreationSlack{60}; // Processus lancés juste avant la session (horloge, lanceurs)
+
+        explicit StartupAnalyzer(std::vector<StartupItem> items, std::chrono::minutes window = std::chrono::minutes(5),
+                                 SystemClock::time_point sessionStart = sessionStartTime())
+            : sessionStart_(sessionStart), window_(window), windowEnd_(sessionStart + window) {
+            for (auto& item : items) {
+                Item entry;
+                entry.exe = StartupManager::executableName(item.path);
+                entry.impact.name = std::move(item.name);
+                entry.impact.command = std::move(item.path);
+                items_.push_back(std::move(entry));
+            }
+            auto initial = std::make_shared<StartupReport>();
+            initial->sessionStart = sessionStart_;
+            initial->window = window_;
+            initial->complete = !active();
+            report_ = std::move(initial);
+        }
+
+        // Faux si la session a commencé avant la fenêtre (agent lancé tard) : rien à mesurer
+        bool active() const { return !items_.empty() && SystemClock::now() < windowEnd_; }
+
+        std::shared_ptr<const StartupReport> report() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return report_;
+        }
+
+        // ProcessMonitor::TableObserver (thread moteur)
+        void observe(const ProcessMonitor::Table& table, Clock::time_point /*now*/) {
+            if (done_) return;
+            const auto wallNow = SystemClock::now();
+            const bool windowOver = wallNow >= windowEnd_;
+
+            if (!windowOver) {
+                classifyNewProcesses(table);
+                sampleTracked(table);
+            }
+            trackIdle(wallNow);
+            publish(windowOver);
+            if (windowOver) finish();
+        }
+
+        // Ouverture de la session courante (Windows : heure de logon WTS ; Linux : création
+        // du leader de session). Repli : démarrage du système.
+        static SystemClock::time_point sessionStartTime() {
+#ifdef _WIN32
+            WTSINFOA* info = nullptr;
+            DWORD bytes = 0;
+            if (WTSQuerySessionInformationA(WTS_CURRENT_SERVER_HANDLE, WTS_CURRENT_SESSION, WTSSessionInfo, (LPSTR*)&info, &bytes) && info) {
+                long long logon = info->LogonTime.QuadPart;
+                WTSFreeMemory(info);
+                if (logon > 0) {
+                    return SystemClock::time_point(std::chrono::duration_cast<SystemClock::duration>(
+                        std::chrono::nanoseconds((logon - 116444736000000000LL) * 100)));
+                }
+            }
+            return SystemClock::now() - std::chrono::milliseconds(GetTickCount64());
+#else
+            ProcessMonitor::Counters c;
+            if (ProcessMonitor::readCounters((DWORD)getsid(0), c) || ProcessMonitor::readCounters(1, c)) return c.created;
+            return SystemClock::now();
+#endif
+        }
+
+    private:
+        struct Item {
+            std::string exe; // Nom de l'exécutable en minuscules
+            StartupImpact impact;
+            // Processus déjà sortis : compteurs figés à leur dernier relevé
+            double exitedCpuSeconds = 0.0;
+            unsigned long long exitedReadBytes = 0;
+        };
+
+        struct Tracked {
+            int item;
+            ProcessMonitor::Counters last;
+        };
+
+        const SystemClock::time_point sessionStart_;
+        const std::chrono::minutes window_;
+        const SystemClock::time_point windowEnd_;
+        std::vector<Item> items_;
+        bool done_ = false;
+
+        std::unordered_map<DWORD, int> known_;       // PID attribué -> élément
+        std::unordered_set<DWORD> excluded_;         // Créés hors fenêtre (définitif)
+        std::unordered_map<DWORD, int> resolved_;    // Classement du tick en cours (-1 : sans rapport)
+        std::unordered_map<DWORD, Tracked> tracked_; // Processus attribués encore vivants
+        std::string lowerName_;
+
+        // Repos : CPU système sous kIdleCpuPercent pendant kIdleHold
+        double lastBusy_ = -1.0, lastTotal_ = -1.0;
+        SystemClock::time_point idleSince_{};
+        double timeToIdle_ = -1.0;
+
+        mutable std::mutex mutex_;
+        std::shared_ptr<const StartupReport> report_;
+
+        int matchByName(const std::string& name) {
+            lowerName_.assign(name);
+            for (auto& c : lowerName_) c = (char)tolower((unsigned char)c);
+            for (size_t i = 0; i < items_.size(); ++i) {
+                const std::string& exe = items_[i].exe;
+                // Linux : comm tronqué à 15 caractères
+                if (!exe.empty() && (lowerName_ == exe || (lowerName_.size() == 15 && exe.compare(0, 15, lowerName_) == 0))) return (int)i;
+            }
+            return -1;
+        }
+
+        void classifyNewProcesses(const ProcessMonitor::Table& table) {
+            // PID disparus : oubliés (un PID réutilisé sera reclassé)
+            for (auto it = known_.begin(); it != known_.end(); ) {
+                if (!table.count(it->first)) it = known_.erase(it);
+                else ++it;
+            }
+            for (auto it = excluded_.begin(); it != excluded_.end(); ) {
+                if (!table.count(*it)) it = excluded_.erase(it);
+                else ++it;
+            }
+            // Les processus sans rapport sont reclassés à chaque tick : un enfant vu avant son
+            // parent, ou dont les compteurs étaient illisibles, n'est pas écarté pour de bon
+            resolved_.clear();
+            for (const auto& [pid, info] : table) {
+                if (!known_.count(pid) && !excluded_.count(pid)) classify(pid, table);
+            }
+        }
+
+        // Élément du processus : celui de son parent (remonté dans la table, quel que soit
+        // l'ordre de parcours), sinon celui de son image. -1 si sans rapport ou hors fenêtre.
+        int classify(DWORD pid, const ProcessMonitor::Table& table) {
+            if (auto known = known_.find(pid); known != known_.end()) return known->second;
+            if (excluded_.count(pid)) return -1;
+            auto [slot, inserted] = resolved_.emplace(pid, -1); // -1 pendant la remontée : coupe les cycles
+            if (!inserted) return slot->second;
+            auto row = table.find(pid);
+            if (row == table.end()) return -1;
+
+            const ProcessInfo& info = row->second;
+            int item = info.parentPid != pid ? classify(info.parentPid, table) : -1;
+            if (item < 0) item = matchByName(info.name);
+            if (item < 0) return -1;
+
+            ProcessMonitor::Counters c;
+            if (!ProcessMonitor::readCounters(pid, c)) return -1; // Réessayé au tick suivant
+            if (c.created < sessionStart_ - kCreationSlack || c.created >= windowEnd_) {
+                excluded_.insert(pid);
+                return -1;
+            }
+            StartupImpact& impact = items_[item].impact;
+            impact.processes++;
+            double seen = std::max(0.0, std::chrono::duration<double>(c.created - sessionStart_).count());
+            if (impact.firstSeenSeconds < 0.0 || seen < impact.firstSeenSeconds) impact.firstSeenSeconds = seen;
+            tracked_.emplace(pid, Tracked{item, c});
+            known_.emplace(pid, item);
+            resolved_[pid] = item; // slot invalidé si la remontée a provoqué un rehash
+            return item;
+        }
+
+        void sampleTracked(const ProcessMonitor::Table& table) {
+            std::vector<SIZE_T> memory(items_.size(), 0);
+            for (auto it = tracked_.begin(); it != tracked_.end(); ) {
+                auto row = table.find(it->first);
+                ProcessMonitor::Counters c;
+                if (row == table.end() || !ProcessMonitor::readCounters(it->first, c) || c.created != it->second.last.created) {
+                    // Sorti (ou PID réutilisé) : on garde le dernier relevé
+                    Item& item = items_[it->second.item];
+                    item.exitedCpuSeconds += it->second.last.cpuSeconds;
+                    item.exitedReadBytes += it->second.last.readBytes;
+                    it = tracked_.erase(it);
+                    continue;
+                }
+                it->second.last = c;
+                memory[it->second.item] += row->second.memoryBytes;
+                ++it;
+            }
+            for (size_t i = 0; i < items_.size(); ++i) {
+                items_[i].impact.peakMemoryBytes = std::max(items_[i].impact.peakMemoryBytes, memory[i]);
+            }
+        }
+
+        void trackIdle(SystemClock::time_point wallNow) {
+            if (timeToIdle_ >= 0.0) return;
+            double busy = 0.0, total = 0.0;
+            if (!systemCpuTimes(busy, total)) return;
+            if (lastTotal_ >= 0.0 && total > lastTotal_) {
+                double percent = (busy - lastBusy_) * 100.0 / (total - lastTotal_);
+                if (percent < kIdleCpuPercent) {
+                    if (idleSince_ == SystemClock::time_point{}) idleSince_ = wallNow;
+                    if (wallNow - idleSince_ >= kIdleHold) {
+                        timeToIdle_ = std::max(0.0, std::chrono::duration<double>(idleSince_ - sessionStart_).count());
+                    }
+                } else {
+                    idleSince_ = {};
+                }
+            }
+            lastBusy_ = busy;
+            lastTotal_ = total;
+        }
+
+        void publish(bool complete) {
+            auto report = std::make_shared<StartupReport>();
+            report->sessionStart = sessionStart_;
+            report->window = window_;
+            report->timeToIdleSeconds = timeToIdle_;
+            report->complete = complete;
+            std::vector<double> cpu(items_.size(), 0.0);
+            std::vector<unsigned long long> read(items_.size(), 0);
+            for (const auto& [pid, t] : tracked_) {
+                cpu[t.item] += t.last.cpuSeconds;
+                read[t.item] += t.last.readBytes;
+            }
+            report->items.reserve(items_.size());
+            for (size_t i = 0; i < items_.size(); ++i) {
+                StartupImpact impact = items_[i].impact;
+                impact.cpuSeconds = items_[i].exitedCpuSeconds + cpu[i];
+                impact.readBytes = items_[i].exitedReadBytes + read[i];
+                impact.cost = impact.cpuSeconds + (double)impact.readBytes / kDiskBytesPerSecond;
+                report->items.push_back(std::move(impact));
+            }
+            std::stable_sort(report->items.begin(), report->items.end(),
+                [](const StartupImpact& a, const StartupImpact& b) { return a.cost > b.cost; });
+            std::lock_guard<std::mutex> lock(mutex_);
+            report_ = std::move(report);
+        }
+
+        void finish() {
+            done_ = true;
+            auto report = this->report();
+            std::string summary = "StartupAnalyzer: boot cost over " + std::to_string(window_.count()) + " min";
+            for (size_t i = 0; i < report->items.size() && i < 3; ++i) {
+                char buf[160];
+                snprintf(buf, sizeof(buf), "%s%s %.1f s CPU, %.1f MB read", i == 0 ? ": " : ", ",
+                         report->items[i].name.c_str(), report->items[i].cpuSeconds, report->items[i].readBytes / 1e6);
+                summary += buf;
+            }
+            summary += timeToIdle_ >= 0.0 ? "; idle after " + std::to_string((long long)timeToIdle_) + " s" : "; not idle within window";
+            LSAA_LOG_INFO(summary);
+            known_.clear();
+            excluded_.clear();
+            resolved_.clear();
+            tracked_.clear();
+        }
+
+        // Temps CPU cumulé de la machine : occupé et total (unités arbitraires)
+        static bool systemCpuTimes(double& busy, double& total) {
+#ifdef _WIN32
+            FILETIME idle, kernel, user;
+            if (!GetSystemTimes(&idle, &kernel, &user)) return false;
+            auto ticks = [](const FILETIME& ft) { return (double)(((unsigned long long)ft.dwHighDateTime << 32) | ft.dwLowDateTime); };
+            total = ticks(kernel) + ticks(user); // Le temps noyau inclut l'inactivité
+            busy = total - ticks(idle);
+            return true;
+#else
+            FILE* f = fopen("/proc/stat", "re");
+            if (!f) return false;
+            unsigned long long v[8] = {};
+            int n = fscanf(f, "cpu %llu %llu %llu %llu %llu %llu %llu %llu", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]);
+            fclose(f);
+            if (n < 4) return false;
+            total = 0.0;
+            for (auto x : v) total += (double)x;
+            busy = total - (double)(v[3] + v[4]); // idle + iowait
+            return true;
+#endif
+        }
+    };
+
+}
@@ -1,8 +1,14 @@
 #pragma once
+#include <cctype>
 #include <string>
 #include <vector>
-#include <windows.h>
+#include "../core/Platform.hpp"
 #include "../core/Logger.hpp"
+#ifndef _WIN32
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#endif
 
 namespace lsaa {
 
@@ -13,6 +19,29 @@ namespace lsaa {
 
     class StartupManager {
     public:
+        // Exécutable lancé par la commande d'un élément : chemin entre guillemets, ou jusqu'à
+        // ".exe", ou premier mot. Nom de fichier seul, en minuscules (comparé aux noms de processus).
+        static std::string executableName(const std::string& command) {
+            std::string exe;
+            size_t begin = command.find_first_not_of(" \t");
+            if (begin == std::string::npos) return exe;
+            if (command[begin] == '"') {
+                size_t end = command.find('"', begin + 1);
+                exe = command.substr(begin + 1, end == std::string::npos ? std::string::npos : end - begin - 1);
+            } else {
+                std::string lower = command;
+                for (auto& c : lower) c = (char)tolower((unsigned char)c);
+                size_t dotExe = lower.find(".exe", begin);
+                size_t end = dotExe != std::string::npos ? dotExe + 4 : command.find(' ', begin);
+                exe = command.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+            }
+            size_t slash = exe.find_last_of("\\/");
+            if (slash != std::string::npos) exe = exe.substr(slash + 1);
+            for (auto& c : exe) c = (char)tolower((unsigned char)c);
+            return exe;
+        }
+
+#ifdef _WIN32
         static std::vector<StartupItem> getStartupItems() {
             std::vector<StartupItem> items;
             HKEY hKey;
@@ -59,5 +88,31 @@ namespace lsaa {
             }
             return false;
         }
+#else
+        // Linux : entrées XDG (~/.config/autostart/*.desktop, ligne Exec=), en lecture seule
+        static std::vector<StartupItem> getStartupItems() {
+            std::vector<StartupItem> items;
+            std::filesystem::path dir;
+            if (const char* config = std::getenv("XDG_CONFIG_HOME")) dir = config;
+            else if (const char* home = std::getenv("HOME")) dir = std::filesystem::path(home) / ".config";
+            else return items;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(dir / "autostart", ec)) {
+                if (entry.path().extension() != ".desktop") continue;
+                std::ifstream in(entry.path());
+                std::string line;
+                while (std::getline(in, line)) {
+                    if (line.rfind("Exec=", 0) == 0) {
+                        items.push_back({entry.path().stem().string(), line.substr(5)});
+                        break;
+                    }
+                }
+            }
+            return items;
+        }
+
+        static bool addItem(const std::string&, const std::string&) { return false; }
+        static bool removeItem(const std::string&) { return false; }
+#endif
     };
 }
@@ -0,0 +1,356 @@
+#pragma once
+#include "../core/IMonitor.hpp"
+#include "../core/Logger.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+
+namespace lsaa {
+
+    // Ressources vues depuis les cgroups v2 (Linux). Dans un conteneur, /proc/meminfo et
+    // /proc/stat décrivent l'hôte : les limites effectives sont celles du cgroup.
+    // Les fichiers de contrôle sont ouverts une fois puis relus avec pread() à chaque tick.
+    //
+    // Toutes les métriques sont des familles suffixées par le libellé du cgroup :
+    // "self" pour le cgroup de l'agent, puis ceux ajoutés par addCgroup().
+    class CgroupMonitor : public IMonitor {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        std::string getName() const override { return "CgroupMonitor"; }
+
+        // Point de montage de la hiérarchie unifiée (champ 5 de mountinfo, type après " - ")
+        static std::string findCgroup2Mount() {
+            std::ifstream mounts("/proc/self/mountinfo");
+            std::string line;
+            while (std::getline(mounts, line)) {
+                size_t sep = line.find(" - ");
+                if (sep == std::string::npos || line.compare(sep + 3, 8, "cgroup2 ") != 0) continue;
+                std::istringstream ss(line.substr(0, sep));
+                std::string id, parent, dev, root, mountPoint;
+                if (ss >> id >> parent >> dev >> root >> mountPoint) return mountPoint;
+            }
+            return {};
+        }
+
+        // A appeler avant l'ajout au moteur. `path` est absolu ou relatif au point de montage cgroup2.
+        void addCgroup(const std::string& label, const std::string& path) {
+            requested_.push_back({label, path});
+        }
+
+        // LSAA_CGROUPS="label=chemin;label=chemin" : cgroups surveillés en plus de celui de l'agent
+        void addFromEnvironment() {
+            const char* list = std::getenv("LSAA_CGROUPS");
+            if (!list) return;
+            std::stringstream items(list);
+            std::string item;
+            while (std::getline(items, item, ';')) {
+                auto eq = item.find('=');
+                if (eq != std::string::npos) addCgroup(item.substr(0, eq), item.substr(eq + 1));
+            }
+        }
+
+        bool initialize() override {
+            std::string mount = findCgroup2Mount();
+            if (mount.empty()) {
+                LSAA_LOG_WARN("CgroupMonitor: no cgroup2 hierarchy mounted.");
+                return false;
+            }
+
+            std::string self = readSelfCgroup();
+            if (!self.empty()) open("self", self == "/" ? mount : mount + self);
+            for (const auto& [label, path] : requested_) {
+                open(label, !path.empty() && path[0] == '/' ? path : mount + "/" + path);
+            }
+            lastCollect_ = Clock::now();
+            return !groups_.empty();
+        }
+
+        bool collect() override {
+            auto now = Clock::now();
+            double elapsed = std::chrono::duration<double>(now - lastCollect_).count();
+            lastCollect_ = now;
+            for (auto& g : groups_) sample(g, elapsed);
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            return {
+                {"cgroup_cpu_usage_percent.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_cpu_limit_percent.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_cpu_throttled_percent.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_memory_current_bytes.", MetricType::INTEGER, "bytes", true, "cgroup"},
+                {"cgroup_memory_limit_bytes.", MetricType::INTEGER, "bytes", true, "cgroup"},
+                {"cgroup_memory_limit_percent.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_memory_max_events.", MetricType::INTEGER, "count", true, "cgroup"},
+                {"cgroup_oom_kill_events.", MetricType::INTEGER, "count", true, "cgroup"},
+                {"cgroup_oom_kills_total.", MetricType::INTEGER, "count", true, "cgroup", true},
+                {"cgroup_io_read_rate.", MetricType::REAL, "bytes_per_second", true, "cgroup"},
+                {"cgroup_io_write_rate.", MetricType::REAL, "bytes_per_second", true, "cgroup"},
+                {"cgroup_cpu_pressure.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_memory_pressure.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_memory_pressure_full.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_io_pressure.", MetricType::REAL, "percent", true, "cgroup"},
+                {"cgroup_io_pressure_full.", MetricType::REAL, "percent", true, "cgroup"}
+            };
+        }
+
+        // Les familles sont publiées pour chaque cgroup ouvert : seuls les libellés connus sont acceptés
+        bool subscribe(const std::string& metric) override {
+            auto dot = metric.find('.');
+            if (dot == std::string::npos) return false;
+            std::string_view label(metric.c_str() + dot + 1);
+            for (const auto& g : groups_) {
+                if (g.label == label) return true;
+            }
+            return false;
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            for (const auto& g : groups_) {
+                const std::string& l = g.label;
+                setMetric(store, "cgroup_cpu_usage_percent.", l, g.cpuUsage);
+                setMetric(store, "cgroup_cpu_limit_percent.", l, g.cpuLimitUsage);
+                setMetric(store, "cgroup_cpu_throttled_percent.", l, g.cpuThrottled);
+                setMetric(store, "cgroup_memory_current_bytes.", l, g.memCurrent);
+                setMetric(store, "cgroup_memory_limit_bytes.", l, g.memLimit);
+                setMetric(store, "cgroup_memory_limit_percent.", l, g.memLimitUsage);
+                setMetric(store, "cgroup_memory_max_events.", l, g.memMaxEvents);
+                setMetric(store, "cgroup_oom_kill_events.", l, g.oomKills);
+                setMetric(store, "cgroup_oom_kills_total.", l, g.prevOomKills);
+                setMetric(store, "cgroup_io_read_rate.", l, g.ioReadRate);
+                setMetric(store, "cgroup_io_write_rate.", l, g.ioWriteRate);
+                setMetric(store, "cgroup_cpu_pressure.", l, g.cpuPressure);
+                setMetric(store, "cgroup_memory_pressure.", l, g.memPressure);
+                setMetric(store, "cgroup_memory_pressure_full.", l, g.memPressureFull);
+                setMetric(store, "cgroup_io_pressure.", l, g.ioPressure);
+                setMetric(store, "cgroup_io_pressure_full.", l, g.ioPressureFull);
+            }
+        }
+
+    private:
+        // Fichier de contrôle gardé ouvert, relu depuis l'offset 0
+        class ControlFile {
+        public:
+            ControlFile() = default;
+            ControlFile(const ControlFile&) = delete;
+            ControlFile& operator=(const ControlFile&) = delete;
+            ControlFile(ControlFile&& o) noexcept : fd_(o.fd_) { o.fd_ = -1; }
+            ControlFile& operator=(ControlFile&& o) noexcept {
+                if (this != &o) { close(); fd_ = o.fd_; o.fd_ = -1; }
+                return *this;
+            }
+            ~ControlFile() { close(); }
+
+            bool open(int dirFd, const char* name) {
+                close();
+                fd_ = ::openat(dirFd, name, O_RDONLY | O_CLOEXEC);
+                return fd_ >= 0;
+            }
+            bool isOpen() const { return fd_ >= 0; }
+
+            // Contenu complet dans `buf` (réutilisé d'un tick à l'autre)
+            bool read(std::string& buf) const {
+                if (fd_ < 0) return false;
+                if (buf.size() < 4096) buf.resize(4096);
+                for (;;) {
+                    ssize_t n = ::pread(fd_, buf.data(), buf.size(), 0);
+                    if (n < 0) return false;
+                    if ((size_t)n < buf.size()) { buf.resize((size_t)n); return true; }
+                    buf.resize(buf.size() * 2); // io.stat peut lister beaucoup de périphériques
+                }
+            }
+
+        private:
+            int fd_ = -1;
+            void close() { if (fd_ >= 0) ::close(fd_); fd_ = -1; }
+        };
+
+        struct Group {
+            std::string label;
+            std::string path;
+            ControlFile cpuStatFile, cpuMaxFile, memCurrentFile, memMaxFile, memEventsFile, ioStatFile;
+            ControlFile cpuPressureFile, memPressureFile, ioPressureFile;
+
+            // Compteurs cumulés du tick précédent
+            bool primed = false;
+            unsigned long long prevUsageUsec = 0, prevPeriods = 0, prevThrottled = 0;
+            unsigned long long prevRead = 0, prevWrite = 0;
+            long long prevMaxEvents = 0, prevOomKills = 0;
+
+            double cpuUsage = 0.0, cpuLimitUsage = 0.0, cpuThrottled = 0.0;
+            long long memCurrent = 0, memLimit = 0, memMaxEvents = 0, oomKills = 0;
+            double memLimitUsage = 0.0;
+            double ioReadRate = 0.0, ioWriteRate = 0.0;
+            double cpuPressure = 0.0, memPressure = 0.0, memPressureFull = 0.0, ioPressure = 0.0, ioPressureFull = 0.0;
+        };
+
+        std::vector<std::pair<std::string, std::string>> requested_;
+        std::vector<Group> groups_;
+        std::string buf_;
+        Clock::time_point lastCollect_;
+
+        void open(const std::string& label, const std::string& path) {
+            int dirFd = ::open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (dirFd < 0) {
+                LSAA_LOG_WARN("CgroupMonitor: cannot open cgroup " + path);
+                return;
+            }
+            Group g;
+            g.label = label;
+            g.path = path;
+            // Un contrôleur non délégué n'expose pas ses fichiers : les métriques restent à 0
+            g.cpuStatFile.open(dirFd, "cpu.stat");
+            g.cpuMaxFile.open(dirFd, "cpu.max");
+            g.memCurrentFile.open(dirFd, "memory.current");
+            g.memMaxFile.open(dirFd, "memory.max");
+            g.memEventsFile.open(dirFd, "memory.events");
+            g.ioStatFile.open(dirFd, "io.stat");
+            g.cpuPressureFile.open(dirFd, "cpu.pressure");
+            g.memPressureFile.open(dirFd, "memory.pressure");
+            g.ioPressureFile.open(dirFd, "io.pressure");
+            ::close(dirFd);
+
+            LSAA_LOG_INFO("CgroupMonitor: watching " + path + " as '" + label + "'");
+            groups_.push_back(std::move(g));
+        }
+
+        void sample(Group& g, double elapsed) {
+            bool rates = g.primed && elapsed > 0.0;
+
+            // --- CPU ---
+            if (g.cpuStatFile.read(buf_)) {
+                unsigned long long usage = field(buf_, "usage_usec");
+                unsigned long long periods = field(buf_, "nr_periods");
+                unsigned long long throttled = field(buf_, "nr_throttled");
+                // Compteur en recul (cgroup recréé sous le même chemin) : on repart de ces valeurs
+                bool reset = usage < g.prevUsageUsec || periods < g.prevPeriods || throttled < g.prevThrottled;
+                if (rates && !reset) {
+                    g.cpuUsage = (double)(usage - g.prevUsageUsec) / (elapsed * 1e6) * 100.0;
+                    unsigned long long dp = periods - g.prevPeriods;
+                    g.cpuThrottled = dp > 0 ? (double)(throttled - g.prevThrottled) * 100.0 / (double)dp : 0.0;
+                }
+                g.prevUsageUsec = usage;
+                g.prevPeriods = periods;
+                g.prevThrottled = throttled;
+            }
+            // cpu.max : "<quota> <period>" ou "max <period>"
+            g.cpuLimitUsage = 0.0;
+            if (g.cpuMaxFile.read(buf_) && buf_.compare(0, 3, "max") != 0) {
+                char* end = nullptr;
+                double quota = std::strtod(buf_.c_str(), &end);
+                double period = std::strtod(end, nullptr);
+                if (quota > 0.0 && period > 0.0) g.cpuLimitUsage = g.cpuUsage / (quota / period);
+            }
+
+            // --- Mémoire ---
+            if (g.memCurrentFile.read(buf_)) g.memCurrent = (long long)std::strtoull(buf_.c_str(), nullptr, 10);
+            g.memLimit = 0;
+            if (g.memMaxFile.read(buf_) && buf_.compare(0, 3, "max") != 0) {
+                g.memLimit = (long long)std::strtoull(buf_.c_str(), nullptr, 10);
+            }
+            g.memLimitUsage = g.memLimit > 0 ? (double)g.memCurrent * 100.0 / (double)g.memLimit : 0.0;
+
+            if (g.memEventsFile.read(buf_)) {
+                long long maxEvents = (long long)field(buf_, "max");
+                long long oomKills = (long long)field(buf_, "oom_kill");
+                bool reset = maxEvents < g.prevMaxEvents || oomKills < g.prevOomKills;
+                g.memMaxEvents = g.primed && !reset ? maxEvents - g.prevMaxEvents : 0;
+                g.oomKills = g.primed && !reset ? oomKills - g.prevOomKills : 0;
+                g.prevMaxEvents = maxEvents;
+                g.prevOomKills = oomKills;
+            }
+
+            // --- IO : "maj:min rbytes=.. wbytes=.. rios=.." par périphérique ---
+            if (g.ioStatFile.read(buf_)) {
+                unsigned long long rbytes = sumField(buf_, "rbytes="), wbytes = sumField(buf_, "wbytes=");
+                // Recul aussi quand un périphérique disparaît de io.stat
+                bool reset = rbytes < g.prevRead || wbytes < g.prevWrite;
+                if (rates && !reset) {
+                    g.ioReadRate = (double)(rbytes - g.prevRead) / elapsed;
+                    g.ioWriteRate = (double)(wbytes - g.prevWrite) / elapsed;
+                }
+                g.prevRead = rbytes;
+                g.prevWrite = wbytes;
+            }
+
+            // --- PSI (avg10) ---
+            if (g.cpuPressureFile.read(buf_)) g.cpuPressure = pressure(buf_, "some");
+            if (g.memPressureFile.read(buf_)) {
+                g.memPressure = pressure(buf_, "some");
+                g.memPressureFull = pressure(buf_, "full");
+            }
+            if (g.ioPressureFile.read(buf_)) {
+                g.ioPressure = pressure(buf_, "some");
+                g.ioPressureFull = pressure(buf_, "full");
+            }
+
+            g.primed = true;
+        }
+
+        // Valeur de "<key> <value>" dans un fichier flat-keyed (cpu.stat, memory.events)
+        static unsigned long long field(const std::string& text, std::string_view key) {
+            size_t pos = 0;
+            while (pos < text.size()) {
+                size_t eol = text.find('\n', pos);
+                if (eol == std::string::npos) eol = text.size();
+                if (eol - pos > key.size() && text.compare(pos, key.size(), key) == 0 && text[pos + key.size()] == ' ') {
+                    return std::strtoull(text.c_str() + pos + key.size() + 1, nullptr, 10);
+                }
+                pos = eol + 1;
+            }
+            return 0;
+        }
+
+        // Somme de "<key><value>" sur toutes les lignes (io.stat, nested-keyed)
+        static unsigned long long sumField(const std::string& text, std::string_view key) {
+            unsigned long long total = 0;
+            for (size_t pos = text.find(key); pos != std::string::npos; pos = text.find(key, pos + key.size())) {
+                if (pos > 0 && text[pos - 1] != ' ') continue;
+                total += std::strtoull(text.c_str() + pos + key.size(), nullptr, 10);
+            }
+            return total;
+        }
+
+        // "some avg10=1.23 avg60=... total=..." -> 1.23
+        static double pressure(const std::string& text, std::string_view kind) {
+            size_t pos = 0;
+            while (pos < text.size()) {
+                size_t eol = text.find('\n', pos);
+                if (eol == std::string::npos) eol = text.size();
+                if (text.compare(pos, kind.size(), kind) == 0) {
+                    size_t avg = text.find("avg10=", pos);
+                    if (avg != std::string::npos && avg < eol) return std::strtod(text.c_str() + avg + 6, nullptr);
+                }
+                pos = eol + 1;
+            }
+            return 0.0;
+        }
+
+        // "0::/chemin" dans /proc/self/cgroup ("/" si l'agent a son propre namespace cgroup)
+        static std::string readSelfCgroup() {
+            std::ifstream file("/proc/self/cgroup");
+            std::string line;
+            while (std::getline(file, line)) {
+                if (line.compare(0, 3, "0::") == 0) {
+                    std::string path = line.substr(3);
+                    return path == "/" ? std::string("/") : path;
+                }
+            }
+            return {};
+        }
+    };
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "../core/IMonitor.hpp"
+#include "../core/Logger.hpp"
+#include "../core/LinearTrend.hpp"
+#include "../core/Platform.hpp"
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lsaa {
+
+    // Espace disque par volume et prévision de saturation. Familles suffixées par le libellé
+    // du volume : lettre du lecteur sous Windows ("disk_used_percent.C"), "root" pour / ailleurs.
+    //
+    // disk_seconds_to_full.<volume> extrapole la droite des moindres carrés de l'espace
+    // occupé sur les 15 dernières minutes : +inf si le disque ne se remplit pas.
+    class DiskMonitor : public IMonitor {
+    public:
+        static constexpr size_t kTrendWindow = 900;
+        static constexpr size_t kMinTrendSamples = 30;
+
+        std::string getName() const override { return "DiskMonitor"; }
+
+        // A appeler avant l'ajout au moteur
+        void addVolume(const std::string& label, const std::string& path) {
+            volumes_.push_back({label, path});
+        }
+
+        bool initialize() override {
+            if (volumes_.empty()) addDefaultVolumes();
+            for (const auto& v : volumes_) LSAA_LOG_INFO("DiskMonitor: watching " + v.label + " (" + v.path + ")");
+            return !volumes_.empty();
+        }
+
+        bool collect() override {
+            double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& v : volumes_) {
+                std::error_code ec;
+                auto info = std::filesystem::space(v.path, ec);
+                v.valid = !ec && info.capacity > 0;
+                if (!v.valid) continue;
+                v.capacity = (double)info.capacity;
+                v.available = (double)info.available;
+                // Occupé du point de vue de l'utilisateur : la réserve root compte comme pleine
+                v.trend.add(now, v.capacity - v.available);
+            }
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            return {
+                {"disk_free_bytes.", MetricType::INTEGER, "bytes", true, "volume"},
+                {"disk_used_percent.", MetricType::REAL, "percent", true, "volume"},
+                {"disk_fill_rate.", MetricType::REAL, "bytes_per_second", true, "volume"},
+                {"disk_seconds_to_full.", MetricType::REAL, "seconds", true, "volume"}
+            };
+        }
+
+        bool subscribe(const std::string& metric) override {
+            auto dot = metric.rfind('.');
+            if (dot == std::string::npos) return false;
+            std::string label = metric.substr(dot + 1);
+            for (const auto& v : volumes_) if (v.label == label) return true;
+            return false;
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& v : volumes_) {
+                if (!v.valid) continue;
+                setMetric(store, "disk_free_bytes.", v.label, (long long)v.available);
+                setMetric(store, "disk_used_percent.", v.label, (v.capacity - v.available) * 100.0 / v.capacity);
+                // Sans valeur avant kMinTrendSamples ticks (entrées présentes dès le départ)
+                bool trend = v.trend.size() >= kMinTrendSamples;
+                setMetric(store, "disk_fill_rate.", v.label, trend ? MetricValue(v.trend.slope()) : MetricValue());
+                setMetric(store, "disk_seconds_to_full.", v.label, trend ? MetricValue(v.trend.secondsUntil(v.capacity)) : MetricValue());
+            }
+        }
+
+    private:
+        struct Volume {
+            std::string label;
+            std::string path;
+            LinearTrend trend{kTrendWindow};
+            bool valid = false;
+            double capacity = 0.0;
+            double available = 0.0;
+        };
+
+        mutable std::mutex mutex_;
+        std::vector<Volume> volumes_;
+
+        // Windows : disques fixes ("C", "D"...) ; ailleurs : la racine
+        void addDefaultVolumes() {
+#ifdef _WIN32
+            char drives[256];
+            DWORD len = GetLogicalDriveStringsA(sizeof(drives), drives);
+            for (const char* d = drives; len > 0 && len < sizeof(drives) && *d; d += std::strlen(d) + 1) {
+                if (GetDriveTypeA(d) == DRIVE_FIXED) addVolume(std::string(1, d[0]), d);
+            }
+#else
+            addVolume("root", "/");
+#endif
+        }
+    };
+
+}
@@ -0,0 +1,346 @@
+#pragma once
+#include "../core/Platform.hpp"
+#include "../core/Logger.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#ifdef _WIN32
+#include <evntrace.h>
+#include <evntcons.h>
+#elif defined(__linux__)
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstring>
+#include <cerrno>
+#endif
+
+namespace lsaa {
+
+    // Evénement de cycle de vie d'un processus (temps réel, sans snapshot)
+    struct ProcessEvent {
+        enum class Type { FORK, EXEC, EXIT };
+        Type type;
+        DWORD pid;
+        DWORD parentPid;
+        int exitCode;       // Valide pour EXIT (0 = sortie normale)
+        std::string name;   // Image pour EXEC (peut être vide si le processus a déjà disparu)
+        std::chrono::steady_clock::time_point when;
+    };
+
+    // Source d'événements processus. Tourne sur son propre thread et bufferise
+    // les événements jusqu'au prochain drain() du ProcessMonitor.
+    class IProcessEventSource {
+    public:
+        virtual ~IProcessEventSource() = default;
+
+        virtual bool start() = 0;
+        virtual void stop() = 0;
+        virtual std::string getName() const = 0;
+
+        // Faux si la source a échoué en cours de route (socket fermée, session ETW perdue)
+        bool healthy() const { return healthy_; }
+
+        // Récupère les événements en attente. Retourne faux si des événements ont été perdus
+        // depuis le dernier appel (file pleine ou ENOBUFS) : l'appelant doit resynchroniser.
+        bool drain(std::vector<ProcessEvent>& out) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            out.swap(pending_);
+            pending_.clear();
+            bool complete = !overflow_;
+            overflow_ = false;
+            return complete;
+        }
+
+    protected:
+        static constexpr size_t kMaxPending = 65536;
+
+        void push(ProcessEvent ev) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_.size() >= kMaxPending) { overflow_ = true; return; }
+            pending_.push_back(std::move(ev));
+        }
+
+        void markOverflow() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            overflow_ = true;
+        }
+
+        std::atomic<bool> healthy_{false};
+
+    private:
+        std::mutex mutex_;
+        std::vector<ProcessEvent> pending_;
+        bool overflow_ = false;
+    };
+
+#if defined(__linux__)
+
+    // Linux : proc connector (netlink). Nécessite CAP_NET_ADMIN.
+    class NetlinkProcEventSource : public IProcessEventSource {
+    public:
+        ~NetlinkProcEventSource() override { stop(); }
+
+        std::string getName() const override { return "netlink proc connector"; }
+
+        bool start() override {
+            sock_ = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+            if (sock_ < 0) return false;
+
+            sockaddr_nl addr{};
+            addr.nl_family = AF_NETLINK;
+            addr.nl_groups = CN_IDX_PROC;
+            addr.nl_pid = 0; // Attribué par le noyau
+            if (bind(sock_, (sockaddr*)&addr, sizeof(addr)) < 0 || !setListening(true)) {
+                close(sock_);
+                sock_ = -1;
+                return false;
+            }
+
+            healthy_ = true;
+            running_ = true;
+            thread_ = std::thread([this]() { readLoop(); });
+            return true;
+        }
+
+        void stop() override {
+            running_ = false;
+            if (thread_.joinable()) thread_.join();
+            if (sock_ >= 0) {
+                setListening(false);
+                close(sock_);
+                sock_ = -1;
+            }
+            healthy_ = false;
+        }
+
+    private:
+        int sock_ = -1;
+        std::atomic<bool> running_{false};
+        std::thread thread_;
+
+        bool setListening(bool enable) {
+            alignas(nlmsghdr) char buf[NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))] = {};
+            auto* nlh = (nlmsghdr*)buf;
+            nlh->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+            nlh->nlmsg_type = NLMSG_DONE;
+
+            auto* msg = (cn_msg*)NLMSG_DATA(nlh);
+            msg->id.idx = CN_IDX_PROC;
+            msg->id.val = CN_VAL_PROC;
+            msg->len = sizeof(proc_cn_mcast_op);
+            proc_cn_mcast_op op = enable ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+            std::memcpy(msg->data, &op, sizeof(op));
+
+            return send(sock_, buf, nlh->nlmsg_len, 0) == (ssize_t)nlh->nlmsg_len;
+        }
+
+        void readLoop() {
+            alignas(nlmsghdr) char buffer[8192];
+            pollfd pfd{sock_, POLLIN, 0};
+
+            while (running_) {
+                int ready = poll(&pfd, 1, 200); // Timeout court pour pouvoir s'arrêter
+                if (ready <= 0) continue;
+
+                ssize_t len = recv(sock_, buffer, sizeof(buffer), 0);
+                if (len < 0) {
+                    if (errno == ENOBUFS) { markOverflow(); continue; } // Evénements perdus
+                    if (errno == EINTR || errno == EAGAIN) continue;
+                    LSAA_LOG_ERROR("ProcessEventSource: netlink recv failed, errno " + std::to_string(errno));
+                    healthy_ = false;
+                    return;
+                }
+
+                for (auto* nlh = (nlmsghdr*)buffer; NLMSG_OK(nlh, (unsigned)len); nlh = NLMSG_NEXT(nlh, len)) {
+                    if (nlh->nlmsg_type == NLMSG_ERROR || nlh->nlmsg_type == NLMSG_NOOP) continue;
+                    auto* msg = (cn_msg*)NLMSG_DATA(nlh);
+                    handle(*(const proc_event*)msg->data);
+                }
+            }
+        }
+
+        // Valeurs ABI de proc_event::what (l'enum a changé de portée selon les versions des headers)
+        static constexpr uint32_t kEventFork = 0x00000001;
+        static constexpr uint32_t kEventExec = 0x00000002;
+        static constexpr uint32_t kEventExit = 0x80000000;
+
+        void handle(const proc_event& ev) {
+            auto now = std::chrono::steady_clock::now();
+            switch ((uint32_t)ev.what) {
+                case kEventFork:
+                    // Ignore la création de threads : seul un nouveau tgid est un processus
+                    if (ev.event_data.fork.child_pid != ev.event_data.fork.child_tgid) return;
+                    push({ProcessEvent::Type::FORK, (DWORD)ev.event_data.fork.child_tgid,
+                          (DWORD)ev.event_data.fork.parent_tgid, 0, {}, now});
+                    break;
+                case kEventExec:
+                    push({ProcessEvent::Type::EXEC, (DWORD)ev.event_data.exec.process_tgid, 0, 0,
+                          readComm(ev.event_data.exec.process_tgid), now});
+                    break;
+                case kEventExit:
+                    if (ev.event_data.exit.process_pid != ev.event_data.exit.process_tgid) return;
+                    push({ProcessEvent::Type::EXIT, (DWORD)ev.event_data.exit.process_tgid,
+                          (DWORD)ev.event_data.exit.parent_tgid, (int)ev.event_data.exit.exit_code, {}, now});
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        static std::string readComm(pid_t pid) {
+            char path[64];
+            snprintf(path, sizeof(path), "/proc/%d/comm", (int)pid);
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return {};
+            char buf[64];
+            ssize_t n = read(fd, buf, sizeof(buf) - 1);
+            close(fd);
+            if (n <= 0) return {};
+            if (buf[n - 1] == '\n') --n;
+            return std::string(buf, (size_t)n);
+        }
+    };
+
+#elif defined(_WIN32)
+
+    // Windows : session ETW temps réel sur le provider Microsoft-Windows-Kernel-Process.
+    // Nécessite les droits admin (ou le groupe "Performance Log Users").
+    class EtwProcEventSource : public IProcessEventSource {
+    public:
+        ~EtwProcEventSource() override { stop(); }
+
+        std::string getName() const override { return "ETW Kernel-Process"; }
+
+        bool start() override {
+            // Une session orpheline (crash précédent) bloquerait StartTrace
+            stopSession();
+
+            props_.assign(sizeof(EVENT_TRACE_PROPERTIES) + sizeof(kSessionName), 0);
+            auto* props = (EVENT_TRACE_PROPERTIES*)props_.data();
+            props->Wnode.BufferSize = (ULONG)props_.size();
+            props->Wnode.Flags = WNODE_FLAG_TRACED_GUID;
+            props->Wnode.ClientContext = 1; // QPC
+            props->LogFileMode = EVENT_TRACE_REAL_TIME_MODE;
+            props->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+
+            if (StartTraceW(&session_, kSessionName, props) != ERROR_SUCCESS) return false;
+
+            if (EnableTraceEx2(session_, &kKernelProcessProvider, EVENT_CONTROL_CODE_ENABLE_PROVIDER,
+                               TRACE_LEVEL_INFORMATION, kKeywordProcess, 0, 0, NULL) != ERROR_SUCCESS) {
+                stopSession();
+                return false;
+            }
+
+            EVENT_TRACE_LOGFILEW log{};
+            log.LoggerName = (LPWSTR)kSessionName;
+            log.ProcessTraceMode = PROCESS_TRACE_MODE_REAL_TIME | PROCESS_TRACE_MODE_EVENT_RECORD;
+            log.EventRecordCallback = &EtwProcEventSource::onEvent;
+            log.Context = this;
+
+            trace_ = OpenTraceW(&log);
+            if (trace_ == INVALID_PROCESSTRACE_HANDLE) {
+                stopSession();
+                return false;
+            }
+
+            healthy_ = true;
+            // ProcessTrace bloque jusqu'à CloseTrace / arrêt de la session
+            thread_ = std::thread([this]() {
+                ProcessTrace(&trace_, 1, NULL, NULL);
+                healthy_ = false;
+            });
+            return true;
+        }
+
+        void stop() override {
+            if (trace_ != INVALID_PROCESSTRACE_HANDLE) {
+                CloseTrace(trace_);
+                trace_ = INVALID_PROCESSTRACE_HANDLE;
+            }
+            stopSession();
+            if (thread_.joinable()) thread_.join();
+            healthy_ = false;
+        }
+
+    private:
+        static constexpr wchar_t kSessionName[] = L"LSAA-ProcessEvents";
+        static constexpr GUID kKernelProcessProvider =
+            {0x22fb2cd6, 0x0e7b, 0x422b, {0xa0, 0xc7, 0x2f, 0xad, 0x1f, 0xd0, 0xe7, 0x16}};
+        static constexpr ULONGLONG kKeywordProcess = 0x10; // WINEVENT_KEYWORD_PROCESS
+
+        std::vector<BYTE> props_;
+        TRACEHANDLE session_ = 0;
+        TRACEHANDLE trace_ = INVALID_PROCESSTRACE_HANDLE;
+        std::thread thread_;
+
+        void stopSession() {
+            std::vector<BYTE> buf(sizeof(EVENT_TRACE_PROPERTIES) + sizeof(kSessionName), 0);
+            auto* props = (EVENT_TRACE_PROPERTIES*)buf.data();
+            props->Wnode.BufferSize = (ULONG)buf.size();
+            props->LoggerNameOffset = sizeof(EVENT_TRACE_PROPERTIES);
+            ControlTraceW(0, kSessionName, props, EVENT_TRACE_CONTROL_STOP);
+            session_ = 0;
+        }
+
+        static void WINAPI onEvent(PEVENT_RECORD rec) {
+            auto* self = (EtwProcEventSource*)rec->UserContext;
+            const BYTE* data = (const BYTE*)rec->UserData;
+            const USHORT len = rec->UserDataLength;
+            auto now = std::chrono::steady_clock::now();
+
+            // ProcessStart (id 1) : ProcessID, CreateTime, ParentProcessID, SessionID, [Flags v1+], ImageName
+            if (rec->EventHeader.EventDescriptor.Id == 1 && len >= 20) {
+                DWORD pid = *(const DWORD*)(data + 0);
+                DWORD ppid = *(const DWORD*)(data + 12);
+                size_t nameOffset = rec->EventHeader.EventDescriptor.Version >= 1 ? 24 : 20;
+                std::string name;
+                if (nameOffset < len) name = baseName((const wchar_t*)(data + nameOffset), (len - nameOffset) / sizeof(wchar_t));
+                // Pas de fork/exec séparés sous Windows : un démarrage vaut les deux
+                self->push({ProcessEvent::Type::FORK, pid, ppid, 0, {}, now});
+                self->push({ProcessEvent::Type::EXEC, pid, ppid, 0, std::move(name), now});
+            }
+            // ProcessStop (id 2) : ProcessID, CreateTime, ExitTime, ExitCode, ...
+            else if (rec->EventHeader.EventDescriptor.Id == 2 && len >= 24) {
+                DWORD pid = *(const DWORD*)(data + 0);
+                int exitCode = *(const int*)(data + 20);
+                self->push({ProcessEvent::Type::EXIT, pid, 0, exitCode, {}, now});
+            }
+        }
+
+        // "\Device\HarddiskVolume3\Windows\notepad.exe" -> "notepad.exe" (même forme que szExeFile)
+        static std::string baseName(const wchar_t* path, size_t maxChars) {
+            size_t n = 0;
+            while (n < maxChars && path[n] != L'\0') ++n;
+            size_t start = n;
+            while (start > 0 && path[start - 1] != L'\\') --start;
+            int bytes = WideCharToMultiByte(CP_ACP, 0, path + start, (int)(n - start), NULL, 0, NULL, NULL);
+            std::string out((size_t)bytes, '\0');
+            WideCharToMultiByte(CP_ACP, 0, path + start, (int)(n - start), out.data(), bytes, NULL, NULL);
+            return out;
+        }
+    };
+
+#endif
+
+    // Source native de la plateforme, ou nullptr si aucune n'est disponible
+    inline std::unique_ptr<IProcessEventSource> createProcessEventSource() {
+#if defined(__linux__)
+        return std::make_unique<NetlinkProcEventSource>();
+#elif defined(_WIN32)
+        return std::make_unique<EtwProcEventSource>();
+#else
+        return nullptr;
+#endif
+    }
+
+}
@@ -0,0 +1,114 @@
+#pragma once
+#include "../core/Platform.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace lsaa {
+
+    // Index nom -> PID des processus, tenu à jour par ProcessMonitor au fil des changements
+    // de la table (apparition, sortie, exec) : le coût suit le nombre de changements, pas le
+    // nombre de processus, et un tick sans changement ne touche pas l'index. Les actions y
+    // résolvent leurs cibles sans snapshot système (lecture sous verrou, rare).
+    // Les noms sont comparés sans casse sous Windows.
+    class ProcessIndex {
+    public:
+        // Reconstruction complète (démarrage du moniteur)
+        template <typename Table>
+        void rebuild(const Table& table) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            byName_.clear();
+            byName_.reserve(table.size());
+            for (const auto& [pid, info] : table) addLocked(pid, info.name);
+            ready_.store(true, std::memory_order_release);
+        }
+
+        // Processus apparu, ou renommé (avec remove() de l'ancien nom)
+        void add(DWORD pid, std::string_view name) {
+            if (name.empty()) return;
+            std::lock_guard<std::mutex> lock(mutex_);
+            addLocked(pid, name);
+        }
+
+        void remove(DWORD pid, std::string_view name) {
+            if (name.empty()) return;
+            std::lock_guard<std::mutex> lock(mutex_);
+            keyInto(scratch_, name);
+            auto it = byName_.find(scratch_);
+            if (it == byName_.end()) return;
+            auto& pids = it->second;
+            pids.erase(std::remove(pids.begin(), pids.end(), pid), pids.end());
+            if (pids.empty()) byName_.erase(it);
+        }
+
+        void setTopMemoryPid(DWORD pid) { topMemoryPid_.store(pid, std::memory_order_relaxed); }
+        DWORD topMemoryPid() const { return topMemoryPid_.load(std::memory_order_relaxed); }
+
+        bool ready() const { return ready_.load(std::memory_order_acquire); }
+
+        std::vector<DWORD> find(std::string_view name) const {
+            std::string k = key(name);
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = byName_.find(k);
+            return it != byName_.end() ? it->second : std::vector<DWORD>{};
+        }
+
+        // Motif avec * et ?
+        std::vector<DWORD> match(std::string_view pattern) const {
+            std::vector<DWORD> out;
+            std::string p = key(pattern);
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [name, pids] : byName_) {
+                if (glob(p, name)) out.insert(out.end(), pids.begin(), pids.end());
+            }
+            return out;
+        }
+
+        static std::string key(std::string_view name) {
+            std::string k;
+            keyInto(k, name);
+            return k;
+        }
+
+        // Comme key(), dans un tampon réutilisé (pas d'allocation une fois la capacité atteinte)
+        static void keyInto(std::string& out, std::string_view name) {
+            out.assign(name);
+#ifdef _WIN32
+            std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+#endif
+        }
+
+        static bool glob(std::string_view pattern, std::string_view text) {
+            size_t p = 0, t = 0, star = std::string_view::npos, resume = 0;
+            while (t < text.size()) {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) { ++p; ++t; }
+                else if (p < pattern.size() && pattern[p] == '*') { star = p++; resume = t; }
+                else if (star != std::string_view::npos) { p = star + 1; t = ++resume; }
+                else return false;
+            }
+            while (p < pattern.size() && pattern[p] == '*') ++p;
+            return p == pattern.size();
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::unordered_map<std::string, std::vector<DWORD>> byName_;
+        std::string scratch_; // Clé de add()/remove() (thread moteur)
+        std::atomic<bool> ready_{false};
+        std::atomic<DWORD> topMemoryPid_{0};
+
+        void addLocked(DWORD pid, std::string_view name) {
+            if (name.empty()) return;
+            keyInto(scratch_, name);
+            auto it = byName_.find(scratch_);
+            if (it == byName_.end()) it = byName_.emplace(scratch_, std::vector<DWORD>()).first;
+            it->second.push_back(pid);
+        }
+    };
+
+}
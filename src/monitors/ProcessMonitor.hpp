@@ -1,30 +1,496 @@
 #pragma once
 #include "../core/IMonitor.hpp"
-#include <windows.h>
+#include "../core/Platform.hpp"
+#include "../core/Logger.hpp"
+#include "../core/EngineSnapshot.hpp"
+#include "../core/TickArena.hpp"
+#include "ProcessEventSource.hpp"
+#include "ProcessIndex.hpp"
+#ifdef _WIN32
 #include <tlhelp32.h>
 #include <psapi.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#endif
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <deque>
 #include <algorithm>
 #include <sstream>
 #include <mutex>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include <functional>
+#include <memory_resource>
 
 namespace lsaa {
 
-    struct ProcessInfo {
-        DWORD pid;
-        std::string name;
-        SIZE_T memoryBytes;
-    };
-
+    // Table des processus. Alimentée en temps réel par une IProcessEventSource quand la
+    // plateforme le permet (fork/exec/exit, y compris les processus très courts), sinon
+    // par diff de snapshots complets à chaque tick.
+    //
+    // En mode événements, la mémoire n'est relue à chaque tick que pour le top précédent ;
+    // l'ensemble de la table l'est tous les kMemoryRefreshTicks (ou à chaque tick en mode détaillé).
+    // La détection de crash-loop s'appuie sur les codes de sortie des événements EXIT : en
+    // polling, process_crash_loop_count reste à 0 (les codes de sortie ne sont pas visibles).
     class ProcessMonitor : public IMonitor {
     public:
+        using Clock = std::chrono::steady_clock;
+        using Table = std::unordered_map<DWORD, ProcessInfo>;
+        using TableObserver = std::function<void(const Table&, Clock::time_point)>;
+        using SnapshotSource = std::function<bool(std::vector<ProcessInfo>&)>;
+
+        // Compteurs cumulés d'un processus depuis sa création (voir queryCounters)
+        struct Counters {
+            double cpuSeconds = 0.0;
+            unsigned long long ioBytes = 0;   // Lectures + écritures
+            unsigned long long readBytes = 0;
+            unsigned threads = 0;
+            std::chrono::system_clock::time_point created{};
+        };
+
+        explicit ProcessMonitor(bool useEvents = true) : useEvents_(useEvents) {}
+
         std::string getName() const override { return "ProcessMonitor"; }
 
         bool initialize() override {
+            if (useEvents_) {
+                events_ = createProcessEventSource();
+                if (events_ && events_->start()) {
+                    LSAA_LOG_INFO("ProcessMonitor: event-driven tracking via " + events_->getName());
+                } else {
+                    LSAA_LOG_WARN("ProcessMonitor: process events unavailable, falling back to polling.");
+                    events_.reset();
+                }
+            }
+            lastCollect_ = Clock::now();
+            if (!resync()) return false;
+            index_->rebuild(table_);
             return true;
         }
 
         bool collect() override {
+            auto now = Clock::now();
+            spawnsThisTick_ = 0;
+            exitsThisTick_ = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                for (auto& [name, count] : watched_) count = 0;
+            }
+
+            if (events_ && !events_->healthy()) {
+                LSAA_LOG_WARN("ProcessMonitor: event source lost, falling back to polling.");
+                events_.reset();
+            }
+
+            if (events_) {
+                bool complete = events_->drain(eventBuffer_);
+                for (const auto& ev : eventBuffer_) applyEvent(ev);
+                // Filet de sécurité périodique (ou immédiat si des événements ont été perdus)
+                if (!complete || ++ticksSinceResync_ >= kResyncTicks) {
+                    if (!resync()) return false;
+                    ticksSinceMemoryRefresh_ = 0;
+                } else {
+                    refreshMemory();
+                }
+            } else {
+                if (!pollAndDiff()) return false;
+            }
+
+            double elapsed = std::chrono::duration<double>(now - lastCollect_).count();
+            lastCollect_ = now;
+            spawnRate_ = elapsed > 0.0 ? spawnsThisTick_ / elapsed : 0.0;
+            exitRate_ = elapsed > 0.0 ? exitsThisTick_ / elapsed : 0.0;
+
+            updateCrashLoops(now);
+            if (detailed_.load(std::memory_order_relaxed)) publishDetails(elapsed);
+            else if (!cpuSamples_.empty()) dropDetails();
+            publishTop();
+            if (tableObserver_) tableObserver_(table_, now);
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            return {
+                {"process_count", MetricType::INTEGER, "count"},
+                {"top_mem_process_name", MetricType::TEXT, ""},
+                {"top_mem_bytes", MetricType::INTEGER, "bytes"},
+                {"process_spawns", MetricType::INTEGER, "count"},
+                {"process_spawn_rate", MetricType::REAL, "per_second"},
+                {"process_exit_rate", MetricType::REAL, "per_second"},
+                {"process_crash_loop_count", MetricType::INTEGER, "count"},
+                {"process_crash_loop_name", MetricType::TEXT, ""},
+                {"process_events_active", MetricType::INTEGER, "bool"},
+                {"process_started.", MetricType::INTEGER, "count", true, "process"}
+            };
+        }
+
+        bool subscribe(const std::string& metric) override {
+            static const std::string prefix = "process_started.";
+            if (metric.compare(0, prefix.size(), prefix) != 0) return false;
+            watchProcess(metric.substr(prefix.size()));
+            return true;
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            setMetric(store, "process_count", (long long)processCount_);
+            setMetric(store, "top_mem_process_name", topProcessName_);
+            setMetric(store, "top_mem_bytes", (long long)topProcessMem_);
+            setMetric(store, "process_spawns", spawnsThisTick_);
+            setMetric(store, "process_spawn_rate", spawnRate_);
+            setMetric(store, "process_exit_rate", exitRate_);
+            setMetric(store, "process_crash_loop_count", (long long)crashLoopCount_);
+            setMetric(store, "process_crash_loop_name", crashLoopName_);
+            setMetric(store, "process_events_active", (long long)(events_ ? 1 : 0));
+            for (const auto& [name, count] : watched_) setMetric(store, "process_started.", name, count);
+        }
+
+        std::vector<ProcessInfo> getTopProcesses() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return *topProcesses_;
+        }
+
+        // Liste immuable, remplacée (pas modifiée) à chaque tick : partageable sans copie
+        std::shared_ptr<const std::vector<ProcessInfo>> getTopProcessesShared() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return topProcesses_;
+        }
+
+        // Mode détaillé (explorateur de processus) : CPU, E/S et threads de chaque processus,
+        // publiés dans getProcessTable(). Une requête système par processus et par tick :
+        // à n'activer que pendant l'affichage.
+        void setDetailed(bool detailed) { detailed_.store(detailed, std::memory_order_relaxed); }
+
+        // Tous les processus au dernier tick en mode détaillé (vide sinon). Liste immuable.
+        std::shared_ptr<const std::vector<ProcessInfo>> getProcessTable() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return allProcesses_;
+        }
+
+        // Compteurs d'un seul processus (CPU, E/S, date de création). Faux si inaccessible.
+        static bool readCounters(DWORD pid, Counters& c) { return queryCounters(pid, c); }
+
+        // Snapshot complet (secours des actions quand aucun ProcessMonitor ne tourne).
+        // Remplace le contenu de `processes` en réutilisant ses éléments.
+        static bool snapshot(std::vector<ProcessInfo>& processes) { return enumerate(processes); }
+
+        // Nom (et PID parent sous Linux) d'un seul processus. Faux si inaccessible.
+        static bool readIdentity(DWORD pid, ProcessInfo& info) {
+            info.pid = pid;
+            info.parentPid = 0;
+#ifdef _WIN32
+            HANDLE h = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!h) return false;
+            char path[MAX_PATH];
+            DWORD size = MAX_PATH;
+            bool ok = QueryFullProcessImageNameA(h, 0, path, &size) != 0;
+            CloseHandle(h);
+            if (!ok) return false;
+            std::string_view full(path, size);
+            info.name.assign(full.substr(full.find_last_of("\\/") + 1));
+            return true;
+#else
+            return readStat(info);
+#endif
+        }
+
+        // Index nom -> PID tenu à jour au fil des changements de la table, pour les actions qui ciblent des processus
+        std::shared_ptr<ProcessIndex> getIndex() const { return index_; }
+
+        // Publie "process_started.<name>" (nombre de lancements de <name> pendant le tick)
+        void watchProcess(const std::string& name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            watched_.try_emplace(name, 0);
+        }
+
+        // Appelé à la fin de chaque collecte, sur le thread moteur, avec la table incrémentale
+        // (sans copie). A installer avant le démarrage du moteur.
+        void setTableObserver(TableObserver observer) { tableObserver_ = std::move(observer); }
+
+        // Source des snapshots complets (défaut : enumerate). Les benchmarks y branchent une
+        // table figée pour mesurer un ensemble de processus stable. A installer avant initialize().
+        void setSnapshotSource(SnapshotSource source) { snapshotSource_ = std::move(source); }
+
+        // Un processus est en crash-loop s'il sort en erreur au moins `exits` fois dans `window`
+        void setCrashLoopPolicy(size_t exits, std::chrono::seconds window) {
+            crashLoopExits_ = exits;
+            crashLoopWindow_ = window;
+        }
+
+    private:
+        static constexpr int kResyncTicks = 600;
+        static constexpr int kMemoryRefreshTicks = 10;
+        static constexpr size_t kTopPoolSize = 4;
+
+        bool useEvents_;
+        std::unique_ptr<IProcessEventSource> events_;
+        std::vector<ProcessEvent> eventBuffer_;
+        Table table_;
+        std::vector<ProcessInfo> polled_; // Dernier snapshot complet, réutilisé d'un tick à l'autre
+        std::shared_ptr<ProcessIndex> index_ = std::make_shared<ProcessIndex>();
+        TableObserver tableObserver_;
+        SnapshotSource snapshotSource_;
+        int ticksSinceResync_ = 0;
+        int ticksSinceMemoryRefresh_ = 0;
+        Clock::time_point lastCollect_;
+
+        long long spawnsThisTick_ = 0;
+        long long exitsThisTick_ = 0;
+        double spawnRate_ = 0.0;
+        double exitRate_ = 0.0;
+
+        size_t crashLoopExits_ = 3;
+        std::chrono::seconds crashLoopWindow_{60};
+        std::unordered_map<std::string, std::deque<Clock::time_point>> abnormalExits_;
+
+        size_t processCount_ = 0;
+        std::string topProcessName_;
+        SIZE_T topProcessMem_ = 0;
+        std::shared_ptr<const std::vector<ProcessInfo>> topProcesses_ = std::make_shared<const std::vector<ProcessInfo>>();
+        // Listes top déjà publiées, recyclées dès que plus aucun lecteur (snapshot, GUI) ne les tient
+        std::vector<std::shared_ptr<std::vector<ProcessInfo>>> topPool_;
+        std::shared_ptr<const std::vector<ProcessInfo>> allProcesses_ = std::make_shared<const std::vector<ProcessInfo>>();
+
+        std::atomic<bool> detailed_{false};
+        std::unordered_map<DWORD, Counters> cpuSamples_;
+        const double cpuCount_ = (double)std::max(1u, std::thread::hardware_concurrency());
+        size_t crashLoopCount_ = 0;
+        std::string crashLoopName_;
+        std::map<std::string, long long> watched_;
+        mutable std::mutex mutex_;
+
+        // Les changements de la table sont reportés un à un dans l'index nom -> PID
+        void applyEvent(const ProcessEvent& ev) {
+            switch (ev.type) {
+                case ProcessEvent::Type::FORK: {
+                    // L'enfant hérite de l'image du parent jusqu'à son exec
+                    auto parent = table_.find(ev.parentPid);
+                    auto& info = table_[ev.pid];
+                    index_->remove(ev.pid, info.name); // PID réutilisé sans EXIT vu
+                    info = {ev.pid, parent != table_.end() ? parent->second.name : std::string(), 0, ev.parentPid};
+                    index_->add(ev.pid, info.name);
+                    spawnsThisTick_++;
+                    break;
+                }
+                case ProcessEvent::Type::EXEC: {
+                    auto& info = table_[ev.pid];
+                    info.pid = ev.pid;
+                    if (!ev.name.empty() && ev.name != info.name) {
+                        index_->remove(ev.pid, info.name);
+                        info.name = ev.name;
+                        index_->add(ev.pid, info.name);
+                    }
+                    noteStarted(info.name);
+                    break;
+                }
+                case ProcessEvent::Type::EXIT: {
+                    auto it = table_.find(ev.pid);
+                    std::string name = it != table_.end() ? std::move(it->second.name) : std::string();
+                    if (it != table_.end()) table_.erase(it);
+                    index_->remove(ev.pid, name);
+                    exitsThisTick_++;
+                    if (ev.exitCode != 0 && !name.empty()) abnormalExits_[name].push_back(ev.when);
+                    break;
+                }
+            }
+        }
+
+        // Mode événements : une requête par processus seulement tous les kMemoryRefreshTicks.
+        // Entre-temps, seuls les processus du top précédent sont relus (thread moteur : seul
+        // écrivain de topProcesses_, lecture sans verrou).
+        void refreshMemory() {
+            if (detailed_.load(std::memory_order_relaxed) || ++ticksSinceMemoryRefresh_ >= kMemoryRefreshTicks) {
+                for (auto& [pid, info] : table_) info.memoryBytes = queryMemory(pid);
+                ticksSinceMemoryRefresh_ = 0;
+                return;
+            }
+            for (const auto& top : *topProcesses_) {
+                auto it = table_.find(top.pid);
+                if (it != table_.end()) it->second.memoryBytes = queryMemory(top.pid);
+            }
+        }
+
+        void noteStarted(const std::string& name) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = watched_.find(name);
+            if (it != watched_.end()) it->second++;
+        }
+
+        // Mode polling : un snapshot complet, les PID apparus/disparus depuis le tick précédent
+        // comptent comme lancements/sorties (les processus plus courts qu'un tick sont invisibles).
+        bool pollAndDiff() { return syncTable(true); }
+
+        bool resync() {
+            if (!syncTable(false)) return false;
+            ticksSinceResync_ = 0;
+            return true;
+        }
+
+        // Met la table à jour en place depuis un snapshot complet : seuls les processus apparus
+        // allouent (noeud et nom). Avec countChanges, apparitions et disparitions sont comptées.
+        bool syncTable(bool countChanges) {
+            if (!(snapshotSource_ ? snapshotSource_(polled_) : enumerate(polled_))) return false;
+
+            std::pmr::vector<DWORD> alive(TickArena::current());
+            alive.reserve(polled_.size());
+            for (const auto& p : polled_) {
+                alive.push_back(p.pid);
+                auto [it, inserted] = table_.try_emplace(p.pid);
+                ProcessInfo& info = it->second;
+                if (inserted && countChanges) {
+                    spawnsThisTick_++;
+                    noteStarted(p.name);
+                }
+                if (inserted || info.name != p.name) {
+                    index_->remove(p.pid, info.name);
+                    info.name = p.name;
+                    index_->add(p.pid, info.name);
+                }
+                info.pid = p.pid;
+                info.memoryBytes = p.memoryBytes;
+                info.parentPid = p.parentPid;
+            }
+
+            // La table contient tous les PID vivants : même taille, aucune sortie
+            if (table_.size() != alive.size()) {
+                std::sort(alive.begin(), alive.end());
+                for (auto it = table_.begin(); it != table_.end(); ) {
+                    if (std::binary_search(alive.begin(), alive.end(), it->first)) { ++it; continue; }
+                    index_->remove(it->first, it->second.name);
+                    it = table_.erase(it);
+                    if (countChanges) exitsThisTick_++;
+                }
+            }
+            return true;
+        }
+
+        void updateCrashLoops(Clock::time_point now) {
+            size_t loops = 0;
+            const std::string* firstName = nullptr;
+            for (auto it = abnormalExits_.begin(); it != abnormalExits_.end(); ) {
+                auto& exits = it->second;
+                while (!exits.empty() && now - exits.front() > crashLoopWindow_) exits.pop_front();
+                if (exits.empty()) { it = abnormalExits_.erase(it); continue; }
+                if (exits.size() >= crashLoopExits_) {
+                    if (loops == 0) firstName = &it->first;
+                    loops++;
+                }
+                ++it;
+            }
+            if (loops > 0 && crashLoopCount_ == 0) LSAA_LOG_WARN("ProcessMonitor: crash-loop detected for " + *firstName);
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            crashLoopCount_ = loops;
+            crashLoopName_ = loops > 0 ? std::string_view(*firstName) : std::string_view("None");
+        }
+
+        void publishDetails(double elapsed) {
+            auto all = std::make_shared<std::vector<ProcessInfo>>();
+            all->reserve(table_.size());
+            std::unordered_map<DWORD, Counters> samples;
+            samples.reserve(table_.size());
+#ifdef _WIN32
+            std::unordered_map<DWORD, unsigned> threads = threadCounts();
+#endif
+            for (const auto& [pid, info] : table_) {
+                ProcessInfo p = info;
+                Counters c;
+                if (queryCounters(pid, c)) {
+#ifdef _WIN32
+                    if (auto t = threads.find(pid); t != threads.end()) c.threads = t->second;
+#endif
+                    p.threads = c.threads;
+                    auto previous = cpuSamples_.find(pid);
+                    if (previous != cpuSamples_.end() && elapsed > 0.0) {
+                        p.cpuPercent = std::max(0.0, c.cpuSeconds - previous->second.cpuSeconds) * 100.0 / (elapsed * cpuCount_);
+                        if (c.ioBytes >= previous->second.ioBytes) p.ioBytesPerSecond = (double)(c.ioBytes - previous->second.ioBytes) / elapsed;
+                    }
+                    samples.emplace(pid, c);
+                }
+                all->push_back(std::move(p));
+            }
+            cpuSamples_.swap(samples);
+            std::lock_guard<std::mutex> lock(mutex_);
+            allProcesses_ = std::move(all);
+        }
+
+        void dropDetails() {
+            cpuSamples_.clear();
+            std::lock_guard<std::mutex> lock(mutex_);
+            allProcesses_ = std::make_shared<const std::vector<ProcessInfo>>();
+        }
+
+        void publishTop() {
+            // Tri des pointeurs dans l'arène du tick, copie des 5 premiers dans une liste recyclée
+            std::pmr::vector<const ProcessInfo*> processes(TickArena::current());
+            processes.reserve(table_.size());
+            for (const auto& [pid, info] : table_) processes.push_back(&info);
+
+            // FIX: use (std::min) to avoid macro conflict
+            size_t limit = (std::min)((size_t)5, processes.size());
+            std::partial_sort(processes.begin(), processes.begin() + limit, processes.end(),
+                [](const ProcessInfo* a, const ProcessInfo* b) {
+                    return a->memoryBytes > b->memoryBytes; // Descending
+                });
+
+            auto top = recycledTop();
+            top->resize(limit);
+            for (size_t i = 0; i < limit; ++i) (*top)[i] = *processes[i];
+
+            index_->setTopMemoryPid(top->empty() ? 0 : top->front().pid);
+            std::lock_guard<std::mutex> lock(mutex_);
+            processCount_ = table_.size();
+            if (!top->empty()) {
+                topProcessName_ = top->front().name;
+                topProcessMem_ = top->front().memoryBytes;
+            } else {
+                topProcessName_ = "None";
+                topProcessMem_ = 0;
+            }
+            topProcesses_ = std::move(top);
+        }
+
+        // Une liste du pool tenue par lui seul n'est plus atteignable par les lecteurs (elle n'est
+        // plus topProcesses_) : use_count() == 1 est définitif, elle peut être réécrite après une
+        // barrière acquire (use_count() est relaxed, voir Engine::publishSnapshot).
+        std::shared_ptr<std::vector<ProcessInfo>> recycledTop() {
+            for (const auto& list : topPool_) {
+                if (list.use_count() == 1) {
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    return list;
+                }
+            }
+            auto list = std::make_shared<std::vector<ProcessInfo>>();
+            if (topPool_.size() < kTopPoolSize) topPool_.push_back(list);
+            return list;
+        }
+
+        // Elément suivant d'un snapshot réécrit en place : les noms gardent leur capacité
+        static ProcessInfo& nextSlot(std::vector<ProcessInfo>& processes, size_t& count) {
+            if (count == processes.size()) processes.emplace_back();
+            ProcessInfo& info = processes[count++];
+            info.cpuPercent = 0.0;
+            info.ioBytesPerSecond = 0.0;
+            info.threads = 0;
+            return info;
+        }
+
+#ifdef _WIN32
+        static bool enumerate(std::vector<ProcessInfo>& processes) {
             HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
             if (hSnapshot == INVALID_HANDLE_VALUE) return false;
 
@@ -36,77 +502,182 @@ namespace lsaa {
                 return false;
             }
 
-            std::vector<ProcessInfo> processes;
+            size_t count = 0;
             do {
-                SIZE_T memUsage = 0;
-                // Get memory usage
-                HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pe32.th32ProcessID);
-                if (hProcess) {
-                    PROCESS_MEMORY_COUNTERS pmc;
-                    if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
-                        memUsage = pmc.WorkingSetSize;
-                    }
-                    CloseHandle(hProcess);
-                }
-
-                processes.push_back({
-                    pe32.th32ProcessID,
-                    pe32.szExeFile,
-                    memUsage
-                });
-
+                ProcessInfo& info = nextSlot(processes, count);
+                info.pid = pe32.th32ProcessID;
+                info.name.assign(pe32.szExeFile);
+                info.memoryBytes = queryMemory(pe32.th32ProcessID);
+                info.parentPid = pe32.th32ParentProcessID;
             } while (Process32Next(hSnapshot, &pe32));
 
             CloseHandle(hSnapshot);
+            processes.resize(count);
+            return true;
+        }
 
-             processCount_ = processes.size();
-
-            // Sort by Memory Descending
-            if (!processes.empty()) {
-                std::sort(processes.begin(), processes.end(), 
-                    [](const ProcessInfo& a, const ProcessInfo& b) {
-                        return a.memoryBytes > b.memoryBytes; // Descending
-                    });
-                
-                std::lock_guard<std::mutex> lock(mutex_);
-                topProcesses_.clear();
-                // FIX: use (std::min) to avoid macro conflict
-                size_t limit = (std::min)((size_t)5, processes.size());
-                for(size_t i=0; i<limit; ++i) {
-                    topProcesses_.push_back(processes[i]);
+        static bool queryCounters(DWORD pid, Counters& c) {
+            HANDLE hProcess = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, pid);
+            if (!hProcess) return false;
+            FILETIME creation, exit, kernel, user;
+            IO_COUNTERS io;
+            bool ok = GetProcessTimes(hProcess, &creation, &exit, &kernel, &user) != 0;
+            if (ok) {
+                auto ticks = [](const FILETIME& ft) { return ((unsigned long long)ft.dwHighDateTime << 32) | ft.dwLowDateTime; };
+                c.cpuSeconds = (double)(ticks(kernel) + ticks(user)) / 1e7; // Unités de 100 ns
+                // FILETIME : 100 ns depuis 1601, l'epoch Unix est 11644473600 s plus loin
+                c.created = std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                    std::chrono::nanoseconds((long long)(ticks(creation) - 116444736000000000ULL) * 100)));
+                if (GetProcessIoCounters(hProcess, &io)) {
+                    c.ioBytes = io.ReadTransferCount + io.WriteTransferCount;
+                    c.readBytes = io.ReadTransferCount;
                 }
+            }
+            CloseHandle(hProcess);
+            return ok;
+        }
 
-                topProcessName_ = processes[0].name;
-                topProcessMem_ = processes[0].memoryBytes;
-            } else {
-                std::lock_guard<std::mutex> lock(mutex_);
-                topProcessName_ = "None";
-                topProcessMem_ = 0;
-                topProcesses_.clear();
+        // Un seul snapshot Toolhelp pour le nombre de threads de tous les processus
+        static std::unordered_map<DWORD, unsigned> threadCounts() {
+            std::unordered_map<DWORD, unsigned> out;
+            HANDLE hSnapshot = CreateToolhelp32Snapshot(TH32CS_SNAPPROCESS, 0);
+            if (hSnapshot == INVALID_HANDLE_VALUE) return out;
+            PROCESSENTRY32 pe32;
+            pe32.dwSize = sizeof(PROCESSENTRY32);
+            if (Process32First(hSnapshot, &pe32)) {
+                do out[pe32.th32ProcessID] = pe32.cntThreads;
+                while (Process32Next(hSnapshot, &pe32));
             }
-            
+            CloseHandle(hSnapshot);
+            return out;
+        }
+
+        static SIZE_T queryMemory(DWORD pid) {
+            SIZE_T memUsage = 0;
+            HANDLE hProcess = OpenProcess(PROCESS_QUERY_INFORMATION | PROCESS_VM_READ, FALSE, pid);
+            if (hProcess) {
+                PROCESS_MEMORY_COUNTERS pmc;
+                if (GetProcessMemoryInfo(hProcess, &pmc, sizeof(pmc))) {
+                    memUsage = pmc.WorkingSetSize;
+                }
+                CloseHandle(hProcess);
+            }
+            return memUsage;
+        }
+#else
+        static bool enumerate(std::vector<ProcessInfo>& processes) {
+            DIR* dir = opendir("/proc");
+            if (!dir) return false;
+            size_t count = 0;
+            while (dirent* entry = readdir(dir)) {
+                char* end = nullptr;
+                unsigned long pid = strtoul(entry->d_name, &end, 10);
+                if (*end != '\0' || pid == 0) continue;
+                ProcessInfo& info = nextSlot(processes, count);
+                info.pid = (DWORD)pid;
+                info.parentPid = 0;
+                if (!readStat(info)) { count--; continue; }
+                info.memoryBytes = queryMemory((DWORD)pid);
+            }
+            closedir(dir);
+            processes.resize(count);
             return true;
         }
 
-        MetricsMap getMetrics() const override {
-            std::lock_guard<std::mutex> lock(mutex_);
-            return {
-                {"process_count", (long long)processCount_},
-                {"top_mem_process_name", topProcessName_},
-                {"top_mem_bytes", (long long)topProcessMem_}
-            };
+        // Nom et PID parent depuis /proc/<pid>/stat : "pid (comm) state ppid ..."
+        static bool readStat(ProcessInfo& info) {
+            char path[64];
+            snprintf(path, sizeof(path), "/proc/%u/stat", info.pid);
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            char buf[512];
+            ssize_t n = read(fd, buf, sizeof(buf) - 1);
+            close(fd);
+            if (n <= 0) return false;
+            buf[n] = '\0';
+            const char* lparen = strchr(buf, '(');
+            const char* rparen = strrchr(buf, ')');
+            if (!lparen || !rparen || rparen < lparen) return false;
+            info.name.assign(lparen + 1, rparen);
+            unsigned ppid = 0;
+            if (sscanf(rparen + 2, "%*c %u", &ppid) == 1) info.parentPid = ppid;
+            return true;
         }
 
-        std::vector<ProcessInfo> getTopProcesses() const {
-            std::lock_guard<std::mutex> lock(mutex_);
-            return topProcesses_;
+        // /proc/<pid>/stat (utime, stime, num_threads, starttime) et /proc/<pid>/io (rchar + wchar,
+        // comme les compteurs de transfert de Windows ; illisible pour les processus d'autres utilisateurs)
+        static bool queryCounters(DWORD pid, Counters& c) {
+            char path[64];
+            snprintf(path, sizeof(path), "/proc/%u/stat", pid);
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            char buf[1024];
+            ssize_t n = read(fd, buf, sizeof(buf) - 1);
+            close(fd);
+            if (n <= 0) return false;
+            buf[n] = '\0';
+            // Le nom (2e champ) peut contenir espaces et parenthèses : on repart de la dernière ')'
+            const char* rest = strrchr(buf, ')');
+            if (!rest) return false;
+            unsigned long long utime = 0, stime = 0, starttime = 0;
+            long threads = 0;
+            if (sscanf(rest + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %*d %*d %*d %*d %ld %*d %llu",
+                       &utime, &stime, &threads, &starttime) != 4) return false;
+            static const double ticksPerSecond = (double)sysconf(_SC_CLK_TCK);
+            c.cpuSeconds = (double)(utime + stime) / ticksPerSecond;
+            c.threads = (unsigned)threads;
+            c.created = bootTime() + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::duration<double>((double)starttime / ticksPerSecond));
+
+            snprintf(path, sizeof(path), "/proc/%u/io", pid);
+            fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd >= 0) {
+                n = read(fd, buf, sizeof(buf) - 1);
+                close(fd);
+                unsigned long long rchar = 0, wchar = 0;
+                if (n > 0) {
+                    buf[n] = '\0';
+                    if (sscanf(buf, "rchar: %llu wchar: %llu", &rchar, &wchar) == 2) {
+                        c.ioBytes = rchar + wchar;
+                        c.readBytes = rchar;
+                    }
+                }
+            }
+            return true;
         }
 
-    private:
-        size_t processCount_ = 0;
-        std::string topProcessName_;
-        SIZE_T topProcessMem_ = 0;
-        std::vector<ProcessInfo> topProcesses_;
-        mutable std::mutex mutex_;
+        // Démarrage du système (btime de /proc/stat), origine des starttime de /proc/<pid>/stat
+        static std::chrono::system_clock::time_point bootTime() {
+            static const std::chrono::system_clock::time_point boot = []() {
+                long long btime = 0;
+                if (FILE* f = fopen("/proc/stat", "re")) {
+                    char line[256];
+                    while (fgets(line, sizeof(line), f)) {
+                        if (sscanf(line, "btime %lld", &btime) == 1) break;
+                    }
+                    fclose(f);
+                }
+                return std::chrono::system_clock::time_point(std::chrono::seconds(btime));
+            }();
+            return boot;
+        }
+
+        // Resident set (équivalent du WorkingSetSize)
+        static SIZE_T queryMemory(DWORD pid) {
+            char path[64];
+            snprintf(path, sizeof(path), "/proc/%u/statm", pid);
+            int fd = open(path, O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return 0;
+            char buf[128];
+            ssize_t n = read(fd, buf, sizeof(buf) - 1);
+            close(fd);
+            if (n <= 0) return 0;
+            buf[n] = '\0';
+            unsigned long long size = 0, resident = 0;
+            if (sscanf(buf, "%llu %llu", &size, &resident) != 2) return 0;
+            static const long pageSize = sysconf(_SC_PAGESIZE);
+            return (SIZE_T)(resident * (unsigned long long)pageSize);
+        }
+#endif
     };
 }
@@ -0,0 +1,122 @@
+#pragma once
+#include "../core/IMonitor.hpp"
+#include "../core/MetricTrace.hpp"
+#include "../core/Logger.hpp"
+#include <thread>
+#include <chrono>
+
+namespace lsaa {
+
+    // Rejoue une trace enregistrée (Engine::startRecording) à la place des moniteurs réels.
+    // Indépendant de l'OS : sert à reproduire un comportement de règles et de générateur
+    // de charge déterministe pour mesurer le moteur.
+    class ReplayMonitor : public IMonitor {
+    public:
+        using Clock = std::chrono::steady_clock;
+        enum class Speed { REALTIME, MAX };
+
+        explicit ReplayMonitor(std::string path, Speed speed = Speed::MAX)
+            : path_(std::move(path)), speed_(speed) {}
+
+        std::string getName() const override { return "ReplayMonitor"; }
+
+        bool initialize() override {
+            if (!reader_.open(path_)) {
+                LSAA_LOG_ERROR("ReplayMonitor: cannot open trace " + path_);
+                return false;
+            }
+            values_.assign(reader_.metrics().size(), MetricValue{});
+            dirty_.clear();
+            slots_.assign(reader_.metrics().size(), nullptr);
+            start_ = Clock::now();
+            // Trace version 1 sans heure de début : les heures partent du début du rejeu
+            traceStart_ = reader_.startUnixNs() != 0
+                ? std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                      std::chrono::nanoseconds(reader_.startUnixNs())))
+                : std::chrono::system_clock::now();
+            return true;
+        }
+
+        // Applique le tick suivant. En temps réel, attend son horodatage d'origine.
+        bool collect() override {
+            uint64_t time = 0;
+            bool more = reader_.next(time, [this](uint32_t id, MetricValue&& value) {
+                values_[id] = std::move(value);
+                dirty_.push_back(id);
+            });
+            if (!more) {
+                finished_ = true;
+                return true; // Les dernières valeurs restent publiées
+            }
+            traceTimeNs_ = time;
+            ticks_++;
+            if (speed_ == Speed::REALTIME) std::this_thread::sleep_until(start_ + std::chrono::nanoseconds(time));
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            std::vector<MetricDescriptor> out;
+            out.reserve(reader_.metrics().size());
+            // La trace ne garde pas les unités : "_percent" dans le nom suffit aux prévisions (ttf<)
+            for (const auto& m : reader_.metrics()) {
+                out.push_back({m.name, m.type, m.name.find("_percent") != std::string::npos ? "percent" : ""});
+            }
+            return out;
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            for (size_t i = 0; i < values_.size(); ++i) m.emplace(reader_.metrics()[i].name, values_[i]);
+            return m;
+        }
+
+        // Seules les valeurs modifiées sont écrites, directement dans leur entrée du magasin
+        void publishMetrics(MetricsMap& store) const override {
+            for (uint32_t id : dirty_) {
+                MetricValue*& slot = slots_[id];
+                if (!slot) slot = &store[reader_.metrics()[id].name];
+                *slot = values_[id];
+            }
+            dirty_.clear();
+        }
+
+        // Reprend la trace au début (boucles de charge) ; les valeurs courantes sont conservées
+        void rewind() {
+            loopOffsetNs_ += traceTimeNs_ + kLoopGapNs;
+            reader_.rewind();
+            finished_ = false;
+            start_ = Clock::now();
+        }
+
+        bool finished() const { return finished_; }
+        size_t ticks() const { return ticks_; }
+        size_t tickCount() const { return reader_.tickCount(); }
+        // Horodatage d'origine du tick courant (depuis le début de l'enregistrement)
+        double traceTimeSeconds() const { return (double)traceTimeNs_ / 1e9; }
+        // Comme traceTimeSeconds(), mais croissant d'une boucle à l'autre : horloge des ticks du moteur
+        double elapsedTraceSeconds() const { return (double)(loopOffsetNs_ + traceTimeNs_) / 1e9; }
+        // Heure murale du tick courant à l'enregistrement (créneaux saisonniers), même progression
+        std::chrono::system_clock::time_point traceWallTime() const {
+            return traceStart_ + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                                     std::chrono::nanoseconds(loopOffsetNs_ + traceTimeNs_));
+        }
+
+    private:
+        static constexpr uint64_t kLoopGapNs = 1'000'000'000; // Un tick entre la fin et la reprise
+
+        std::string path_;
+        Speed speed_;
+        MetricTraceReader reader_;
+        std::vector<MetricValue> values_;
+        // Publication incrémentale : le magasin du moteur ne supprime jamais ses entrées
+        mutable std::vector<uint32_t> dirty_;
+        mutable std::vector<MetricValue*> slots_;
+        Clock::time_point start_;
+        std::chrono::system_clock::time_point traceStart_;
+        uint64_t traceTimeNs_ = 0;
+        uint64_t loopOffsetNs_ = 0;
+        size_t ticks_ = 0;
+        bool finished_ = false;
+    };
+
+}
@@ -0,0 +1,189 @@
+#pragma once
+#include "../core/IMonitor.hpp"
+#include "../core/Platform.hpp"
+#include "../core/Profiler.hpp"
+#include "../core/AllocationCounter.hpp"
+#include "../engine/ActionLimiter.hpp"
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <ctime>
+#endif
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace lsaa {
+
+    // Coût de l'agent lui-même : CPU, mémoire résidente, allocations du thread moteur par tick,
+    // octets servis par l'arène au tick précédent (lsaa_tick_arena_bytes), p50/p99 des histogrammes du Profiler
+    // ("lsaa_<étape>_p50_us", "lsaa_collect_p99_us.<Moniteur>"...).
+    // Les quantiles portent sur une fenêtre glissante de kWindowTicks à 2 x kWindowTicks ticks.
+    // Compteurs cumulés de l'ActionLimiter : lsaa_actions_executed_total, _deduplicated_total,
+    // _rate_limited_total et lsaa_notifications_merged_total.
+    class SelfMonitor : public IMonitor {
+    public:
+        using Clock = std::chrono::steady_clock;
+        static constexpr int kWindowTicks = 30;
+
+        std::string getName() const override { return "SelfMonitor"; }
+
+        bool initialize() override {
+            lastWall_ = Clock::now();
+            lastCpuSeconds_ = processCpuSeconds();
+            return true;
+        }
+
+        bool collect() override {
+            auto now = Clock::now();
+            double wall = std::chrono::duration<double>(now - lastWall_).count();
+            double cpu = processCpuSeconds();
+            uint64_t allocations = allocationCount();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            cpuPercent_ = wall > 0.0 ? (cpu - lastCpuSeconds_) * 100.0 / wall : 0.0;
+            rssBytes_ = residentBytes();
+            // Compteur du thread moteur : la référence est prise au premier tick, sur ce thread
+            allocationsPerTick_ = allocationBaseline_ ? (long long)(allocations - lastAllocations_) : 0;
+            allocationBaseline_ = true;
+            lastWall_ = now;
+            lastCpuSeconds_ = cpu;
+            lastAllocations_ = allocations;
+
+            if (const TickArena* arena = TickArena::active()) tickArenaBytes_ = (long long)arena->lastTickBytes();
+
+            Profiler::instance().forEach([this](const std::string& name, const LatencyHistogram& histogram) {
+                auto& w = windows_[name];
+                if (w.p50Key.empty()) {
+                    // Clés calculées une fois : "collect.X" -> "lsaa_collect_p50_us.X"
+                    std::string stage = name, suffix;
+                    if (auto dot = name.find('.'); dot != std::string::npos) {
+                        stage = name.substr(0, dot);
+                        suffix = name.substr(dot);
+                    }
+                    w.p50Key = "lsaa_" + stage + "_p50_us" + suffix;
+                    w.p99Key = "lsaa_" + stage + "_p99_us" + suffix;
+                }
+                auto current = histogram.snapshot();
+                if (++w.age >= kWindowTicks) {
+                    w.base = w.next;
+                    w.next = current;
+                    w.age = 0;
+                }
+                auto window = current.since(w.base);
+                w.p50us = window.percentile(0.50) / 1000.0;
+                w.p99us = window.percentile(0.99) / 1000.0;
+            });
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            std::vector<MetricDescriptor> out = {
+                {"lsaa_cpu_percent", MetricType::REAL, "percent"},
+                {"lsaa_rss_bytes", MetricType::INTEGER, "bytes"},
+                {"lsaa_allocations_per_tick", MetricType::INTEGER, "count"},
+                {"lsaa_tick_arena_bytes", MetricType::INTEGER, "bytes"},
+                {"lsaa_actions_executed_total", MetricType::INTEGER, "count", false, {}, true},
+                {"lsaa_actions_deduplicated_total", MetricType::INTEGER, "count", false, {}, true},
+                {"lsaa_actions_rate_limited_total", MetricType::INTEGER, "count", false, {}, true},
+                {"lsaa_notifications_merged_total", MetricType::INTEGER, "count", false, {}, true},
+                {"lsaa_collect_p50_us.", MetricType::REAL, "microseconds", true, "monitor"},
+                {"lsaa_collect_p99_us.", MetricType::REAL, "microseconds", true, "monitor"}
+            };
+            for (const char* stage : {"tick", "evaluate", "action"}) {
+                out.push_back({std::string("lsaa_") + stage + "_p50_us", MetricType::REAL, "microseconds"});
+                out.push_back({std::string("lsaa_") + stage + "_p99_us", MetricType::REAL, "microseconds"});
+            }
+            return out;
+        }
+
+        // lsaa_collect_pXX_us.<Moniteur> : le moniteur doit avoir été ajouté au moteur
+        bool subscribe(const std::string& metric) override {
+            auto dot = metric.find('.');
+            return dot != std::string::npos && Profiler::instance().has("collect" + metric.substr(dot));
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            setMetric(store, "lsaa_cpu_percent", cpuPercent_);
+            setMetric(store, "lsaa_rss_bytes", rssBytes_);
+            if (allocationCountingEnabled()) setMetric(store, "lsaa_allocations_per_tick", allocationsPerTick_);
+            setMetric(store, "lsaa_tick_arena_bytes", tickArenaBytes_); // Relevé du dernier collect() dans un tick
+            const auto& limiter = ActionLimiter::instance();
+            setMetric(store, "lsaa_actions_executed_total", (long long)limiter.executed());
+            setMetric(store, "lsaa_actions_deduplicated_total", (long long)limiter.deduplicated());
+            setMetric(store, "lsaa_actions_rate_limited_total", (long long)limiter.suppressed());
+            setMetric(store, "lsaa_notifications_merged_total", (long long)limiter.merged());
+            for (const auto& [name, w] : windows_) {
+                setMetric(store, w.p50Key, w.p50us);
+                setMetric(store, w.p99Key, w.p99us);
+            }
+        }
+
+    private:
+        struct Window {
+            LatencyHistogram::Snapshot base;
+            LatencyHistogram::Snapshot next;
+            int age = 0;
+            double p50us = 0.0;
+            double p99us = 0.0;
+            std::string p50Key;
+            std::string p99Key;
+        };
+
+        mutable std::mutex mutex_;
+        Clock::time_point lastWall_;
+        double lastCpuSeconds_ = 0.0;
+        uint64_t lastAllocations_ = 0;
+        bool allocationBaseline_ = false;
+
+        double cpuPercent_ = 0.0;
+        long long rssBytes_ = 0;
+        long long allocationsPerTick_ = 0;
+        long long tickArenaBytes_ = 0;
+        std::map<std::string, Window> windows_;
+
+#ifdef _WIN32
+        static double processCpuSeconds() {
+            FILETIME creation, exit, kernel, user;
+            if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) return 0.0;
+            auto toUll = [](const FILETIME& ft) { return ((unsigned long long)ft.dwHighDateTime << 32) | ft.dwLowDateTime; };
+            return (double)(toUll(kernel) + toUll(user)) / 1e7; // Unités de 100 ns
+        }
+
+        static long long residentBytes() {
+            PROCESS_MEMORY_COUNTERS pmc;
+            if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) return 0;
+            return (long long)pmc.WorkingSetSize;
+        }
+#else
+        static double processCpuSeconds() {
+            timespec ts;
+            if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) return 0.0;
+            return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+        }
+
+        static long long residentBytes() {
+            int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return 0;
+            char buf[128];
+            ssize_t n = read(fd, buf, sizeof(buf) - 1);
+            close(fd);
+            if (n <= 0) return 0;
+            buf[n] = '\0';
+            unsigned long long size = 0, resident = 0;
+            if (sscanf(buf, "%llu %llu", &size, &resident) != 2) return 0;
+            return (long long)(resident * (unsigned long long)sysconf(_SC_PAGESIZE));
+        }
+#endif
+    };
+}
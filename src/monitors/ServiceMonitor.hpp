@@ -0,0 +1,111 @@
+#pragma once
+#include "../core/IMonitor.hpp"
+#include "../modules/ServiceRefresher.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace lsaa {
+
+    // Etat des services pour les règles, alimenté par le ServiceRefresher (aucune énumération
+    // sur le thread moteur). Familles suffixées par le nom du service, publiées à la demande :
+    //   service_running.<nom>        1 si le service tourne, 0 sinon (absent compris)
+    //   service_state_changes.<nom>  changements d'état pendant le tick
+    // Le nom ne tient pas compte de la casse. Sans valeur tant que la première liste n'est pas
+    // arrivée (un service n'est pas « arrêté » parce que l'énumération n'a pas encore eu lieu).
+    // _Exemple_ : "metric": "service_running.Spooler", "oper": "<", "threshold": 1
+    class ServiceMonitor : public IMonitor {
+    public:
+        explicit ServiceMonitor(std::shared_ptr<ServiceRefresher> refresher) : refresher_(std::move(refresher)) {}
+
+        std::string getName() const override { return "ServiceMonitor"; }
+
+        bool initialize() override { return refresher_ != nullptr; }
+
+        bool collect() override {
+            refresher_->drainChanges(changes_);
+            auto list = refresher_->snapshot();
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            changesThisTick_ = (long long)changes_.size();
+            for (auto& [name, w] : watched_) w.changes = 0;
+            for (const auto& c : changes_) {
+                for (auto& [name, w] : watched_) {
+                    if (ServiceList::equalsIgnoreCase(c.name, name)) w.changes++;
+                }
+            }
+            if (list->version != listVersion_) {
+                listVersion_ = list->version;
+                serviceCount_ = (long long)list->services.size();
+                runningCount_ = 0;
+                for (const auto& s : list->services) runningCount_ += (s.stateCode == SERVICE_RUNNING);
+                for (auto& [name, w] : watched_) {
+                    const ServiceInfo* s = list->findIgnoreCase(name);
+                    w.running = s && s->stateCode == SERVICE_RUNNING;
+                }
+            }
+            return true;
+        }
+
+        std::vector<MetricDescriptor> describeMetrics() const override {
+            return {
+                {"service_count", MetricType::INTEGER, "count"},
+                {"service_running_count", MetricType::INTEGER, "count"},
+                {"service_state_changes", MetricType::INTEGER, "count"},
+                {"service_running.", MetricType::INTEGER, "bool", true, "service"},
+                {"service_state_changes.", MetricType::INTEGER, "count", true, "service"}
+            };
+        }
+
+        bool subscribe(const std::string& metric) override {
+            auto dot = metric.find('.');
+            if (dot == std::string::npos || dot + 1 == metric.size()) return false;
+            std::string prefix = metric.substr(0, dot);
+            if (prefix != "service_running" && prefix != "service_state_changes") return false;
+
+            std::string name = metric.substr(dot + 1);
+            auto list = refresher_->snapshot();
+            const ServiceInfo* s = list->findIgnoreCase(name);
+            std::lock_guard<std::mutex> lock(mutex_);
+            watched_.try_emplace(name, Watched{s && s->stateCode == SERVICE_RUNNING, 0});
+            return true;
+        }
+
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            std::lock_guard<std::mutex> lock(mutex_);
+            bool listed = listVersion_ > 0;
+            setMetric(store, "service_count", listed ? MetricValue(serviceCount_) : MetricValue());
+            setMetric(store, "service_running_count", listed ? MetricValue(runningCount_) : MetricValue());
+            setMetric(store, "service_state_changes", changesThisTick_);
+            for (const auto& [name, w] : watched_) {
+                setMetric(store, "service_running.", name, listed ? MetricValue((long long)(w.running ? 1 : 0)) : MetricValue());
+                setMetric(store, "service_state_changes.", name, w.changes);
+            }
+        }
+
+    private:
+        struct Watched {
+            bool running;
+            long long changes;
+        };
+
+        std::shared_ptr<ServiceRefresher> refresher_;
+        std::vector<ServiceChange> changes_;
+
+        mutable std::mutex mutex_;
+        std::map<std::string, Watched, std::less<>> watched_;
+        uint64_t listVersion_ = 0;
+        long long serviceCount_ = 0;
+        long long runningCount_ = 0;
+        long long changesThisTick_ = 0;
+    };
+
+}
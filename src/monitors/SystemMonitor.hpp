@@ -2,7 +2,9 @@
 #include <windows.h>
 #include <vector>
 #include <string>
+#include <chrono>
 #include "../core/IMonitor.hpp"
+#include "../core/LinearTrend.hpp"
 
 namespace lsaa {
 
@@ -25,6 +27,10 @@ namespace lsaa {
             ramUsed_ = memInfo.ullTotalPhys - memInfo.ullAvailPhys;
             ramLoad_ = memInfo.dwMemoryLoad;
 
+            // Tendance de la RAM utilisée sur les 5 dernières minutes -> temps avant saturation
+            double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+            ramTrend_.add(now, (double)ramUsed_);
+
             // 2. CPU
             FILETIME idle, kernel, user;
             if (GetSystemTimes(&idle, &kernel, &user)) {
@@ -56,15 +62,31 @@ namespace lsaa {
             return true;
         }
 
-        MetricsMap getMetrics() const override {
+        std::vector<MetricDescriptor> describeMetrics() const override {
             return {
-                {"cpu_usage_percent", cpuLoad_},
-                {"ram_total_bytes", (long long)ramTotal_},
-                {"ram_used_bytes", (long long)ramUsed_},
-                {"ram_load_percent", (double)ramLoad_}
+                {"cpu_usage_percent", MetricType::REAL, "percent"},
+                {"ram_total_bytes", MetricType::INTEGER, "bytes"},
+                {"ram_used_bytes", MetricType::INTEGER, "bytes"},
+                {"ram_load_percent", MetricType::REAL, "percent"},
+                {"ram_seconds_to_full", MetricType::REAL, "seconds"}
             };
         }
 
+        MetricsMap getMetrics() const override {
+            MetricsMap m;
+            publishMetrics(m);
+            return m;
+        }
+
+        void publishMetrics(MetricsMap& store) const override {
+            setMetric(store, "cpu_usage_percent", cpuLoad_);
+            setMetric(store, "ram_total_bytes", (long long)ramTotal_);
+            setMetric(store, "ram_used_bytes", (long long)ramUsed_);
+            setMetric(store, "ram_load_percent", (double)ramLoad_);
+            setMetric(store, "ram_seconds_to_full", ramTrend_.size() >= kMinTrendSamples
+                ? MetricValue(ramTrend_.secondsUntil((double)ramTotal_)) : MetricValue());
+        }
+
     private:
         unsigned long long prevIdle_ = 0;
         unsigned long long prevKernel_ = 0;
@@ -75,6 +97,10 @@ namespace lsaa {
         unsigned long long ramUsed_ = 0;
         DWORD ramLoad_ = 0;
 
+        // +inf tant que la RAM ne croît pas ; sans valeur avant kMinTrendSamples ticks
+        static constexpr size_t kMinTrendSamples = 30;
+        LinearTrend ramTrend_{300};
+
         unsigned long long ftToUll(const FILETIME& ft) {
             ULARGE_INTEGER uli;
             uli.LowPart = ft.dwLowDateTime;
@@ -0,0 +1,242 @@
+// lsaa-replay : rejoue une trace de métriques (lsaa-core --record) à travers le moteur de règles,
+// ou (--backtest) évalue en masse des règles candidates sur l'historique de la trace.
+// Usage : lsaa-replay <trace> [--rules rules.json] [--realtime] [--loops N]
+//         lsaa-replay --backtest <trace> [--rules rules.json] [--from s] [--to s] [--flap-window s] [--threads N] [--verify]
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <limits>
+#include "core/Engine.hpp"
+#include "core/Logger.hpp"
+#include "core/ConfigManager.hpp"
+#include "engine/RuleFactory.hpp"
+#include "engine/Backtester.hpp"
+#include "monitors/ReplayMonitor.hpp"
+
+namespace {
+
+    struct Firing {
+        double traceTime;
+        std::string rule;
+        std::string action;
+    };
+
+    // Remplace toutes les actions : on note le déclenchement au lieu d'agir sur le système
+    class ActionRecordFiring : public lsaa::IAction {
+    public:
+        ActionRecordFiring(std::string rule, std::string action, const lsaa::ReplayMonitor& clock, std::vector<Firing>& out)
+            : rule_(std::move(rule)), action_(std::move(action)), clock_(clock), out_(out) {}
+        void execute() override { out_.push_back({clock_.traceTimeSeconds(), rule_, action_}); }
+        std::string getName() const override { return "RecordFiring"; }
+    private:
+        std::string rule_;
+        std::string action_;
+        const lsaa::ReplayMonitor& clock_;
+        std::vector<Firing>& out_;
+    };
+
+    int usage() {
+        std::cerr << "Usage: lsaa-replay <trace> [--rules rules.json] [--realtime] [--loops N]" << std::endl
+                  << "       lsaa-replay --backtest <trace> [--rules rules.json] [--from s] [--to s]"
+                  << " [--flap-window s] [--threads N] [--verify]" << std::endl;
+        return 2;
+    }
+
+    struct BacktestOptions {
+        double from = 0.0;
+        double to = std::numeric_limits<double>::infinity();
+        double flapWindow = 60.0;
+        unsigned threads = 0;
+        bool verify = false;
+    };
+
+    // Combien de fois ces règles se seraient-elles déclenchées sur cet historique ?
+    int runBacktest(const std::string& tracePath, const BacktestOptions& opt) {
+        lsaa::MetricTraceReader reader;
+        if (!reader.open(tracePath) || reader.tickCount() == 0) {
+            std::cerr << "Empty or unreadable trace: " << tracePath << std::endl;
+            return 1;
+        }
+
+        std::vector<lsaa::Backtester::Candidate> candidates;
+        std::vector<std::string> metrics;
+        lsaa::ConfigManager::instance().forEachRule([&](const lsaa::RuleView& cfg) {
+            if (!cfg.enabled) return;
+            lsaa::Backtester::Candidate c;
+            std::string error;
+            if (!lsaa::Backtester::candidateOf(cfg, c, error)) {
+                std::cout << "  skipped " << cfg.name << ": " << error << std::endl;
+                return;
+            }
+            metrics.push_back(c.metric);
+            candidates.push_back(std::move(c));
+        });
+
+        auto loadStart = std::chrono::steady_clock::now();
+        lsaa::MetricHistory history;
+        history.load(reader, metrics, opt.from, opt.to);
+        auto evalStart = std::chrono::steady_clock::now();
+
+        lsaa::Backtester backtester(history);
+        backtester.setFlapWindow(opt.flapWindow);
+        if (opt.threads) backtester.setThreads(opt.threads);
+        auto results = backtester.run(candidates);
+        auto evalEnd = std::chrono::steady_clock::now();
+
+        double span = history.size() > 1 ? (double)(history.times().back() - history.times().front()) / 1e9 : 0.0;
+        std::cout << "Backtest: " << tracePath << " (" << history.size() << " ticks, " << std::fixed
+                  << std::setprecision(1) << span << "s of history), " << candidates.size() << " rules" << std::endl << std::endl;
+
+        std::vector<size_t> order(results.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return results[a].firings > results[b].firings; });
+
+        std::cout << std::left << std::setw(28) << "Rule" << std::right << std::setw(10) << "Firings"
+                  << std::setw(12) << "Active(s)" << std::setw(9) << "Active%" << std::setw(13) << "Longest(s)"
+                  << std::setw(8) << "Flaps" << std::endl;
+        size_t mismatches = 0;
+        for (size_t i : order) {
+            const auto& r = results[i];
+            std::cout << std::left << std::setw(28) << r.rule << std::right;
+            if (!r.error.empty()) {
+                std::cout << "  " << r.error << std::endl;
+                continue;
+            }
+            std::cout << std::setw(10) << r.firings << std::setw(12) << std::setprecision(1) << r.activeSeconds
+                      << std::setw(9) << (span > 0.0 ? r.activeSeconds * 100.0 / span : 0.0)
+                      << std::setw(13) << r.longestSeconds << std::setw(8) << r.flaps;
+            if (opt.verify) {
+                size_t expected = backtester.oracleFirings(candidates[i]);
+                if (expected != r.firings) {
+                    std::cout << "  MISMATCH (oracle " << expected << ")";
+                    mismatches++;
+                }
+            }
+            std::cout << std::endl;
+        }
+
+        double loadMs = std::chrono::duration<double, std::milli>(evalStart - loadStart).count();
+        double evalMs = std::chrono::duration<double, std::milli>(evalEnd - evalStart).count();
+        double evals = (double)history.size() * (double)candidates.size();
+        std::cout << std::endl << "History loaded in " << std::setprecision(1) << loadMs << " ms, rules evaluated in "
+                  << evalMs << " ms (" << std::setprecision(0) << (evalMs > 0.0 ? evals / evalMs * 1000.0 : 0.0)
+                  << " tick-rule evaluations/s)" << std::endl;
+        if (opt.verify) std::cout << (mismatches ? "Oracle check FAILED" : "Oracle check passed") << std::endl;
+        return mismatches ? 1 : 0;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    std::string tracePath;
+    std::string rulesPath = "rules.json";
+    auto speed = lsaa::ReplayMonitor::Speed::MAX;
+    int loops = 1;
+    bool backtest = false;
+    BacktestOptions bt;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--rules" && i + 1 < argc) rulesPath = argv[++i];
+        else if (arg == "--realtime") speed = lsaa::ReplayMonitor::Speed::REALTIME;
+        else if (arg == "--loops" && i + 1 < argc) loops = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--backtest") backtest = true;
+        else if (arg == "--from" && i + 1 < argc) bt.from = std::atof(argv[++i]);
+        else if (arg == "--to" && i + 1 < argc) bt.to = std::atof(argv[++i]);
+        else if (arg == "--flap-window" && i + 1 < argc) bt.flapWindow = std::atof(argv[++i]);
+        else if (arg == "--threads" && i + 1 < argc) bt.threads = (unsigned)std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--verify") bt.verify = true;
+        else if (tracePath.empty() && arg[0] != '-') tracePath = arg;
+        else return usage();
+    }
+    if (tracePath.empty()) return usage();
+    if (!std::filesystem::exists(rulesPath)) {
+        std::cerr << "Rules file not found: " << rulesPath << std::endl;
+        return 1;
+    }
+
+    lsaa::Logger::instance().setConsoleOutput(false);
+
+    if (backtest) {
+        lsaa::ConfigManager::instance().load(rulesPath);
+        return runBacktest(tracePath, bt);
+    }
+
+    lsaa::Engine engine;
+    auto replay = std::make_unique<lsaa::ReplayMonitor>(tracePath, speed);
+    auto* replayPtr = replay.get();
+    engine.addMonitor(std::move(replay));
+    if (replayPtr->tickCount() == 0) {
+        std::cerr << "Empty or unreadable trace: " << tracePath << std::endl;
+        return 1;
+    }
+    // Prévisions (ttf<) et créneaux saisonniers suivent le temps de la trace, pas l'horloge murale
+    engine.setTickClock([replayPtr]() { return replayPtr->elapsedTraceSeconds(); },
+                        [replayPtr]() { return replayPtr->traceWallTime(); });
+
+    std::vector<Firing> firings;
+    lsaa::RuleFactory factory(engine.getMetricRegistry());
+    for (const char* type : {"LOG", "NOTIFY", "KILL", "SCRIPT"}) {
+        factory.registerAction(type, [&, type](const lsaa::RuleView& cfg) {
+            return std::make_unique<ActionRecordFiring>(std::string(cfg.name), type, *replayPtr, firings);
+        });
+    }
+
+    lsaa::ConfigManager::instance().load(rulesPath);
+    auto ruleSet = std::make_shared<lsaa::RuleSet>();
+    std::vector<lsaa::RuleIssue> issues;
+    size_t defined = 0;
+    lsaa::ConfigManager::instance().forEachRule([&](const lsaa::RuleView& cfg) {
+        defined++;
+        if (auto rule = factory.build(cfg, issues)) ruleSet->push_back(std::move(rule));
+    });
+    size_t active = ruleSet->size();
+    engine.publishRules(std::move(ruleSet));
+
+    std::cout << "Trace: " << tracePath << " (" << replayPtr->tickCount() << " ticks, "
+              << engine.getMetricRegistry().describe().size() << " metrics)" << std::endl;
+    std::cout << "Rules: " << active << " active / " << defined << " defined" << std::endl;
+    for (const auto& issue : issues) std::cout << "  skipped " << issue.rule << ": " << issue.message << std::endl;
+
+    // --- Rejeu ---
+    auto start = std::chrono::steady_clock::now();
+    size_t ticks = 0;
+    for (int loop = 0; loop < loops; ++loop) {
+        if (loop > 0) replayPtr->rewind();
+        while (true) {
+            engine.step();
+            if (replayPtr->finished()) break;
+            ticks++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // --- Rapport ---
+    std::cout << std::endl << "Firings:" << std::endl;
+    for (const auto& f : firings) {
+        std::cout << "  [" << std::fixed << std::setprecision(3) << std::setw(10) << f.traceTime << "s] "
+                  << f.rule << " (" << f.action << ")" << std::endl;
+    }
+
+    struct Summary { size_t count = 0; double first = 0.0; double last = 0.0; };
+    std::map<std::string, Summary> perRule;
+    for (const auto& f : firings) {
+        auto& s = perRule[f.rule];
+        if (s.count++ == 0) s.first = f.traceTime;
+        s.last = f.traceTime;
+    }
+    std::cout << std::endl << "Summary:" << std::endl;
+    for (const auto& [rule, s] : perRule) {
+        std::cout << "  " << rule << ": fired " << s.count << "x (first " << std::setprecision(1) << s.first
+                  << "s, last " << s.last << "s)" << std::endl;
+    }
+
+    double tickRate = seconds > 0.0 ? ticks / seconds : 0.0;
+    std::cout << std::endl << "Replayed " << ticks << " ticks in " << std::setprecision(3) << seconds * 1000.0 << " ms: "
+              << std::setprecision(0) << tickRate << " ticks/s, " << tickRate * active << " rule evaluations/s" << std::endl;
+    return 0;
+}